@@ -19,8 +19,156 @@
 // ============================================================================
 // Controls how the proxy switches between listening to MeshCore and Meshtastic
 
-#define PROTOCOL_SWITCH_INTERVAL_MS_DEFAULT 100  // Default: Switch between protocols every 100ms
+// Legacy fixed switch interval (CMD_SET_SWITCH_INTERVAL) - maps to min = max dwell
 #define PROTOCOL_SWITCH_INTERVAL_MS_MIN 50       // Minimum: 50ms
 #define PROTOCOL_SWITCH_INTERVAL_MS_MAX 1000     // Maximum: 1000ms (1 second)
 
+// Adaptive dwell (auto mode): each protocol's listen time is scaled between
+// these bounds by its recently observed traffic
+#define RX_DWELL_MIN_MS_DEFAULT 250   // Default shortest dwell
+#define RX_DWELL_MAX_MS_DEFAULT 3000  // Default longest dwell
+#define RX_DWELL_MS_LIMIT_MIN 50      // Bounds accepted over USB
+#define RX_DWELL_MS_LIMIT_MAX 10000
+
+// ============================================================================
+// Radio Configuration
+// ============================================================================
+// With a radio per protocol each protocol keeps its own radio listening and
+// nothing is time-sliced; with fewer radios fitted (platform_getRadioCount())
+// radio 0 switches between protocols as above
+
+#ifdef RAK4631_BOARD
+#define RADIO_MAX_COUNT 2         // Radio instances the firmware can drive
+#else
+#define RADIO_MAX_COUNT 1
+#endif
+
+// ============================================================================
+// Relay Buffering Configuration
+// ============================================================================
+// Sized per platform: every slot holds a full 255-byte frame, and the
+// ATmega32u4 only has 2.5 KB of RAM, so it queues one frame each way
+
+#define RELAY_FRAME_MAX 255       // Largest frame a queue slot holds
+
+#ifdef RAK4631_BOARD
+#define RX_QUEUE_DEPTH 8          // Received frames waiting for relay processing
+#define TX_QUEUE_DEPTH 32         // Converted frames waiting for (re)transmission
+#else
+#define RX_QUEUE_DEPTH 1          // 1 x ~270 bytes
+#define TX_QUEUE_DEPTH 1          // 2 x ~280 bytes (one spare slot)
+#endif
+
+// ============================================================================
+// TX Scheduling Configuration
+// ============================================================================
+// Outbound frames are held per target protocol and sent in groups so a burst
+// costs one radio reconfiguration out and one back. The hold time bounds the
+// latency added while waiting for a group to form.
+
+#define TX_HOLD_MS_DEFAULT 50     // Default: hold frames up to 50ms to batch them
+#define TX_HOLD_MS_MAX 2000       // Maximum: 2 seconds (0 = send immediately)
+#define TX_BATCH_AIRTIME_MAX_MS 1500 // Cap on one group's airtime so RX is never deaf for long
+
+// Store-and-forward: a frame that could not go out (channel busy after LBT)
+// stays queued and is retried later; frames older than their class TTL are
+// purged instead of spending airtime on stale traffic
+#define TX_RETRY_MAX 3                // Retries before a frame is dropped
+#define TX_RETRY_DELAY_MS 1000        // Wait before the first retry (doubles each time)
+#define TX_TTL_TEXT_MS 60000          // Text and ACKs
+#define TX_TTL_CONTROL_MS 30000       // Routing and control
+#define TX_TTL_TELEMETRY_MS 15000     // Adverts, position, telemetry
+#define TX_TTL_BULK_MS 10000          // Unknown/raw
+
+// ============================================================================
+// Airtime Budget Configuration
+// ============================================================================
+// Token bucket per target protocol: relayed airtime is limited to a
+// percentage of a rolling window so a flood on one mesh cannot saturate the other
+
+#define AIRTIME_BUDGET_PERCENT_DEFAULT 25   // Default: 25% of the window (100 = unlimited)
+#define AIRTIME_BUDGET_WINDOW_S_DEFAULT 60  // Default: 60 second window
+#define AIRTIME_BUDGET_WINDOW_S_MAX 3600    // Maximum: 1 hour
+
+// ============================================================================
+// Duplicate Cache Configuration
+// ============================================================================
+// 8 bytes per entry (key + timestamp)
+
+#ifdef RAK4631_BOARD
+#define DUP_CACHE_SIZE 48         // 384 bytes
+#else
+#define DUP_CACHE_SIZE 24         // 192 bytes
+#endif
+
+#define DUP_CACHE_TTL_S_DEFAULT 120   // Default: copies heard within 2 minutes are duplicates
+#define DUP_CACHE_TTL_S_MAX 3600      // Maximum: 1 hour
+
+// ============================================================================
+// Per-Source Rate Limit Configuration
+// ============================================================================
+// One token bucket per originating node, up to 24 bytes per tracked source
+
+#ifdef RAK4631_BOARD
+#define RATE_LIMIT_SOURCES 32     // 768 bytes
+#else
+#define RATE_LIMIT_SOURCES 4      // ~80 bytes
+#endif
+
+#define RATE_LIMIT_PER_MIN_DEFAULT 12 // Default: 12 frames per minute sustained per source
+#define RATE_LIMIT_BURST_DEFAULT 6    // Default: bursts of up to 6 frames pass at once
+#define RATE_LIMIT_PER_MIN_MAX 600    // Maximum: 10 frames per second
+
+// ============================================================================
+// Latency Tracing Configuration
+// ============================================================================
+// Log2 microsecond buckets per stage and direction (2 bytes each):
+// 24 buckets reach ~16.7 s. Compiled out on the ATmega32u4 to save RAM.
+
+#ifdef RAK4631_BOARD
+#define LATENCY_BUCKETS 24        // 2 x 5 x 24 x 2 = 480 bytes
+#else
+#define LATENCY_BUCKETS 0
+#endif
+
+// ============================================================================
+// Noise Floor Monitor Configuration
+// ============================================================================
+// Instantaneous RSSI sampled while listening between frames: EWMA noise floor
+// and channel-busy share per protocol channel, and the RSSI below which a
+// "received" frame cannot be real (floor minus the SF's demodulation limit)
+
+#define NOISE_SAMPLE_INTERVAL_MS 20   // One RSSI read per protocol channel every 20 ms
+#define NOISE_BUSY_MARGIN_DB 6        // A sample this far above the floor counts as busy
+#define NOISE_REJECT_MARGIN_DB 3      // Slack below the demodulation limit before rejecting
+#define NOISE_MIN_SAMPLES 32          // Samples before the threshold adapts (fixed -127 until then)
+
+// ============================================================================
+// Listen-Before-Talk Configuration
+// ============================================================================
+// CAD before each relay TX; on activity back off a random number of slots
+// from a contention window that doubles after every busy CAD
+
+#define LBT_ENABLED_DEFAULT true
+#define LBT_SLOT_SYMBOLS 3            // Slot time: CAD (~2 symbols) + processing...
+#define LBT_SLOT_OVERHEAD_US 1000     // ...plus RX/TX turnaround
+#define LBT_CW_MIN_DEFAULT 4          // Initial contention window (slots)
+#define LBT_CW_MAX_DEFAULT 64         // Contention window ceiling (slots)
+#define LBT_MAX_ATTEMPTS_DEFAULT 6    // Busy CADs before the TX is aborted
+
+// ============================================================================
+// USB Link Configuration
+// ============================================================================
+// Responses that don't fit the serial TX buffer are parked here and written
+// out from the main loop instead of waiting for the host to drain
+
+#ifdef RAK4631_BOARD
+#define USB_TX_BUFFER_SIZE 512
+#else
+#define USB_TX_BUFFER_SIZE 80     // One full response frame plus slack
+#endif
+
+#define USB_RESPONSE_MAX_SIZE 66      // [resp][len] + 64 byte payload
+#define USB_CMD_TIMEOUT_MS 100        // Partial command discarded after this
+
 #endif // CONFIG_H
@@ -1,12 +1,24 @@
 #include <Arduino.h>
 #include <string.h>
-#include "config.h"  // Generic config (PROTOCOL_SWITCH_INTERVAL_MS_DEFAULT)
+#include "config.h"  // Generic config (queue sizing, dwell, relay limits)
+#include "timing_stats.h"
 #include "protocols/protocol_state.h"
 #include "radio/radio_interface.h"
+#include "radio/radio_shadow.h"
 #include "protocols/protocol_interface.h"
 #include "protocols/protocol_manager.h"
 #include "protocols/canonical_packet.h"
 #include "platforms/platform_interface.h"
+#include "relay/airtime.h"
+#include "relay/airtime_budget.h"
+#include "relay/dup_cache.h"
+#include "relay/lbt.h"
+#include "relay/noise_floor.h"
+#include "relay/rx_dwell.h"
+#include "relay/rx_queue.h"
+#include "relay/latency.h"
+#include "relay/rate_limit.h"
+#include "relay/tx_scheduler.h"
 #include "usb_comm.h"
 
 // ============================================================================
@@ -26,10 +38,14 @@
 ProtocolId rx_protocol = (ProtocolId)0;      // Currently listening protocol (ONE protocol)
 ProtocolId tx_protocols[PROTOCOL_COUNT];      // Protocols to transmit to (relay targets - MULTIPLE protocols)
 uint8_t tx_protocol_count = 0;                // Number of active transmit protocols
-unsigned long lastProtocolSwitch = 0;
-uint16_t protocolSwitchIntervalMs = PROTOCOL_SWITCH_INTERVAL_MS_DEFAULT;
-bool autoSwitchEnabled = false; // Auto-switch disabled - use manual RX protocol selection
-static ProtocolId lastConfiguredProtocol = PROTOCOL_COUNT; // Track last configured protocol to avoid spam
+bool autoSwitchEnabled = false; // Auto mode: rotate rx_protocol with adaptive dwell (relay/rx_dwell)
+// Protocol each radio is configured for (PROTOCOL_COUNT = unknown, set in setup())
+static ProtocolId configuredProtocol[RADIO_MAX_COUNT];
+// Protocol each radio was last configured for - the "from" of reconfigTiming
+static ProtocolId appliedProtocol[RADIO_MAX_COUNT];
+// Every protocol has a radio of its own (radio index = protocol id) and keeps
+// listening; otherwise radio 0 time-slices between protocols
+static bool dedicatedRadios = false;
 // desiredProtocolMode is kept in sync with rx_protocol for web interface compatibility
 // Since auto-switch is disabled, it always equals rx_protocol (0=MeshCore, 1=Meshtastic)
 uint8_t desiredProtocolMode = 0; // Will be set to match rx_protocol in setup()
@@ -41,10 +57,37 @@ ProtocolRuntimeState protocolStates[PROTOCOL_COUNT];
 // Protocol configurations are now stored in protocolStates[].config
 // Legacy variables removed - access via protocolStates[id].config.frequencyHz/bandwidth
 
-// Packet buffers - use single shared buffer to save RAM
-uint8_t rxBuffer[255];
-uint8_t txBuffer[255];
-uint8_t convertedBuffer[255];
+// Packet buffers - received frames live in the RX queue (relay/rx_queue.h),
+// converted outbound frames in the TX scheduler (relay/tx_scheduler.h)
+
+// Number of times the radio was reconfigured for a protocol (accessible from usb_comm.cpp)
+uint32_t radioReconfigurations = 0;
+
+// Reconfiguration time per protocol transition, indexed [from][to]
+// (accessible from usb_comm.cpp). Only the setters whose value differs reach
+// the radio (radio/radio_shadow.h), so this is the real switching overhead.
+TimingStats reconfigTiming[PROTOCOL_COUNT][PROTOCOL_COUNT];
+
+// Leaving RX while a frame is arriving (accessible from usb_comm.cpp)
+uint32_t receptionsSaved = 0;   // Switch/TX held off and the frame completed
+uint32_t receptionsAborted = 0; // Held off until the timeout and left anyway
+
+// Main loop timing (accessible from usb_comm.cpp)
+#define LOOP_AVG_SHIFT 4        // Moving average (1/16) of one iteration
+TimingStats loopTiming;
+
+// Relay TX start: channel clear to SetTx, [0] payload uploaded at that point,
+// [1] payload preloaded while listening (accessible from usb_comm.cpp)
+TimingStats txStartTiming[2];
+uint32_t txPreloads = 0;        // Frames uploaded to the radio while listening
+uint32_t txPreloadsUnused = 0;  // Preloads that could not be armed - uploaded again
+
+// Frame readout: time spent fetching a frame from the radio, and RX_DONE
+// interrupt to frame in the RX queue slot (accessible from usb_comm.cpp)
+TimingStats rxReadoutTiming;
+TimingStats rxReadyTiming;
+uint32_t rxCrcErrors = 0;       // Frames dropped for the CRC (or SX126x header) error flag
+uint32_t rxOversize = 0;        // Frames dropped for being longer than maxLen below
 
 // Helper to safely increment counters with overflow protection
 #define SAFE_INCREMENT(counter) do { \
@@ -60,16 +103,71 @@ uint8_t convertedBuffer[255];
     } \
 } while(0)
 
-// Interrupt flag
-volatile bool packetReceived = false;
+// Radio that carries `protocol` (index for radio_get())
+static uint8_t radioFor(ProtocolId protocol) {
+    return dedicatedRadios ? (uint8_t)protocol : 0;
+}
+
+// Protocol the radio carrying `protocol` listens on between transmissions
+static ProtocolId listenProtocolFor(ProtocolId protocol) {
+    return dedicatedRadios ? protocol : rx_protocol;
+}
+
+// True if the radio carrying `protocol` is currently configured for it
+static bool radioOnProtocol(ProtocolId protocol) {
+    return configuredProtocol[radioFor(protocol)] == protocol;
+}
+
+// Interrupt flags
+// A radio raises the same DIO line for RX_DONE, TX_DONE and CAD_DONE, so the
+// ISR routes the event by whether that radio has a transmission (including
+// its LBT CADs) in flight.
+// RX events are counted (not just flagged) so back-to-back frames are not merged.
+// The RX_DONE time is taken here rather than when loop() drains the frame; the
+// radio keeps the latest frame, so the latest stamp is the one it goes with.
+#define NO_RADIO 0xFF
+volatile uint8_t rxIrqPending[RADIO_MAX_COUNT];
+volatile uint32_t rxIrqUs[RADIO_MAX_COUNT];
+volatile uint8_t txRadio = NO_RADIO;    // Radio the TX engine is using
+volatile bool txDone = false;
+
+static void onRadioEvent(uint8_t radio) {
+    if (radio == txRadio) {
+        txDone = true;
+    } else {
+        rxIrqUs[radio] = micros();
+        if (rxIrqPending[radio] < 255) {
+            rxIrqPending[radio]++;
+        }
+    }
+}
 
-void onPacketReceived() {
-    packetReceived = true;
+static void onRadio0Interrupt() { onRadioEvent(0); }
+#if RADIO_MAX_COUNT > 1
+static void onRadio1Interrupt() { onRadioEvent(1); }
+#endif
+
+static void (*const radioInterrupts[RADIO_MAX_COUNT])() = {
+    onRadio0Interrupt,
+#if RADIO_MAX_COUNT > 1
+    onRadio1Interrupt,
+#endif
+};
+
+// Upper bound for how long a TX of `len` bytes may take with `config`:
+// time-on-air plus margin for PA ramp and IRQ latency
+static uint32_t txTimeoutMs(const ProtocolConfig* config, uint8_t len) {
+    uint32_t airtimeMs = airtime_packetMs(config, len);
+    if (airtimeMs == 0) {
+        return 2000; // Unknown modulation - fall back to a generous bound
+    }
+    return airtimeMs + airtimeMs / 4 + 20; // +25% +20ms
 }
 
+// Configure the radio carrying `protocol` for it
 void configureProtocol(ProtocolId protocol) {
     // Skip if already configured for this protocol (prevents spam)
-    if (protocol == lastConfiguredProtocol) {
+    if (radioOnProtocol(protocol)) {
         return;
     }
     
@@ -94,13 +192,21 @@ void configureProtocol(ProtocolId protocol) {
     
     ProtocolInterfaceImpl* iface = protocol_interface_get(protocol);
     ProtocolConfig* config = protocol_manager_getConfig(protocol);
+    uint8_t radio = radioFor(protocol);
     
     if (iface && config && iface->configure != nullptr) {
         // Configure radio - this is called from USB command handler or setup
         // The protocol's configure() function should set radio to RX mode
-        iface->configure(config);
+        unsigned long startUs = micros();
+        iface->configure(radio_get(radio), config);
+        uint32_t elapsedUs = micros() - startUs;
+        if (appliedProtocol[radio] < PROTOCOL_COUNT) {
+            timing_stats_record(&reconfigTiming[appliedProtocol[radio]][protocol], elapsedUs);
+        }
+        appliedProtocol[radio] = protocol;
+        radioReconfigurations++;
         protocolStates[protocol].isActive = true;
-        lastConfiguredProtocol = protocol; // Remember what we configured
+        configuredProtocol[radio] = protocol; // Remember what we configured
         
         // Debug: Log when Meshtastic is configured (to help diagnose reception issues)
         // Only send debug log if USB is ready (not during early setup)
@@ -117,11 +223,11 @@ void configureProtocol(ProtocolId protocol) {
         // Double-check: Ensure radio is in RX mode after configuration
         // Some radio implementations might not set this automatically
         // This is a safety measure - the protocol's configure() should already do this
-        radio_setMode(MODE_RX_CONTINUOUS);
+        radio_setMode(radio_get(radio), MODE_RX_CONTINUOUS);
     } else {
         // Invalid config - try to put radio in a safe state
         if (radioInitialized) {
-            radio_setMode(MODE_STDBY);
+            radio_setMode(radio_get(radio), MODE_STDBY);
         }
         // Don't send error during setup - might block USB
         // Error will be handled elsewhere if needed
@@ -166,6 +272,27 @@ void set_tx_protocols(uint8_t bitmask) {
     }
 }
 
+// USB/control paths: re-apply the listen protocol's settings now, or leave it
+// to the TX engine's restoreRx() if a transmission currently owns the radio
+// (txRadio covers both its LBT and on-air phases). With dedicated radios
+// every radio re-applies its own protocol.
+void reconfigureRx() {
+    for (uint8_t radio = 0; radio < RADIO_MAX_COUNT; radio++) {
+        configuredProtocol[radio] = PROTOCOL_COUNT;
+    }
+    if (!dedicatedRadios) {
+        if (txRadio == NO_RADIO) {
+            configureProtocol(rx_protocol);
+        }
+        return;
+    }
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        if (radioFor((ProtocolId)i) != txRadio) {
+            configureProtocol((ProtocolId)i);
+        }
+    }
+}
+
 void set_rx_protocol(ProtocolId protocol) {
     // Validate protocol ID
     if (protocol >= PROTOCOL_COUNT) {
@@ -176,7 +303,7 @@ void set_rx_protocol(ProtocolId protocol) {
     }
     
     // Don't change if already set to this protocol
-    if (rx_protocol == protocol && lastConfiguredProtocol == protocol) {
+    if (rx_protocol == protocol && configuredProtocol[radioFor(protocol)] == protocol) {
         return; // Already configured for this protocol
     }
     
@@ -198,126 +325,162 @@ void set_rx_protocol(ProtocolId protocol) {
     // This ensures packets are relayed to the other protocol when RX protocol changes
     update_tx_protocols(rx_protocol);
     
-    // Configure radio for new listen protocol
-    // Force reconfiguration by resetting lastConfiguredProtocol
-    lastConfiguredProtocol = PROTOCOL_COUNT;
-    configureProtocol(protocol);
-    lastProtocolSwitch = millis();
+    // Configure radio for new listen protocol (forced, deferred while a TX owns the radio)
+    reconfigureRx();
+    rx_dwell_start(protocol, millis());
     
     // Note: configureProtocol() already sets radio to RX mode via protocol's configure() function
     // No need to set it again here
 }
 
-bool receivePacket(uint8_t* buffer, uint8_t* len) {
-    if (!radio_isPacketReceived()) {
-        return false;
+// Read the frame `radio` received on `protocol` - length, payload and packet
+// status in one readout, IRQs cleared. The caller re-arms RX either way.
+bool receivePacket(Radio* radio, ProtocolId protocol, uint8_t* buffer, RadioFrame* frame) {
+    ProtocolInterfaceImpl* currentIface = protocol_interface_get(protocol);
+    uint8_t maxLen = currentIface ? currentIface->getMaxPacketSize() : 255;
+    if (maxLen > RELAY_FRAME_MAX) {
+        maxLen = RELAY_FRAME_MAX;   // Longer frames do not fit a queue slot
     }
-    
-    // Check for packet errors (CRC, header) BEFORE reading packet (like Meshtastic does)
-    // This filters out noise packets that fail CRC or have header errors
-    // TEMPORARILY DISABLED: May be too aggressive if transmitting devices don't use CRC
-    // TODO: Make CRC checking configurable or check CRC status after reading packet
-    /*
-    if (radio_hasPacketErrors()) {
-        // Packet has CRC or header errors - reject this corrupted/noise packet
-        // Debug: Log the rejection
-        ProtocolInterfaceImpl* rxIface = protocol_interface_get(rx_protocol);
-        const char* rxName = rxIface && rxIface->name ? rxIface->name : "Unknown";
-        char errorMsg[50];
-        snprintf(errorMsg, sizeof(errorMsg), "RX %s: CRC/header error - rejected", rxName);
-        usbComm.sendDebugLog(errorMsg);
-        radio_clearIrqFlags();
-        radio_setMode(MODE_RX_CONTINUOUS);
+    if (!radio_fetchFrame(radio, buffer, maxLen, frame)) {
         return false;
     }
-    */
-    
-    // Follow RadioLib pattern: get packet length FIRST (reads RX buffer status)
-    // This gives us both the length and ensures we have valid packet data
-    *len = radio_getPacketLength();
     
-    // Validate length BEFORE reading - reject 255 as it usually indicates buffer corruption
-    if (*len == 0 || *len == 255 || *len > 255) {
-        // Invalid length - clear and return
-        radio_clearIrqFlags();
-        radio_setMode(MODE_RX_CONTINUOUS);
+    // A frame the radio flagged with a CRC or header error is corrupt -
+    // count it and don't spend relay airtime on it
+    if (frame->crcError) {
+        SAFE_INCREMENT(rxCrcErrors);
         return false;
     }
     
-    // Check against protocol max packet size
-    ProtocolInterfaceImpl* currentIface = protocol_interface_get(rx_protocol);
-    if (currentIface && *len > currentIface->getMaxPacketSize()) {
-        radio_clearIrqFlags();
-        radio_setMode(MODE_RX_CONTINUOUS);
-        return false;
+    // Reject 255 as it usually indicates buffer corruption; 0 is also what
+    // the readout reports for a frame longer than the protocol allows
+    if (frame->length == 0 && frame->rxLength > maxLen) {
+        SAFE_INCREMENT(rxOversize);
     }
-    
-    // Read FIFO with the correct length
-    // Note: readFifo reads RX buffer status again internally, but we trust our length
-    // and readFifo will clamp to our length if RX buffer status is corrupted
-    radio_readFifo(buffer, *len);
-    
-    // Verify the length wasn't corrupted during read
-    // readFifo sets last_packet_length, so check it matches
-    uint8_t verifyLen = radio_getPacketLength();
-    if (verifyLen != *len && (verifyLen == 255 || verifyLen == 0)) {
-        // Length was corrupted during read - reject this packet
-        radio_clearIrqFlags();
-        radio_setMode(MODE_RX_CONTINUOUS);
+    if (frame->length == 0 || frame->length == 255) {
         return false;
     }
     
-    // Clear IRQ flags after reading
-    radio_clearIrqFlags();
-    
     return true;
 }
 
-bool transmitPacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
-    if (len == 0 || len > 255) {
-        return false;
+// Move a completed frame from the radio listening on `protocol` into the RX
+// queue and re-arm RX right away - relay processing happens later from the queue
+void drainRadio(ProtocolId protocol) {
+    uint8_t index = radioFor(protocol);
+    Radio* radio = radio_get(index);
+    noInterrupts();
+    uint8_t pending = rxIrqPending[index];
+    uint32_t irqUs = rxIrqUs[index];
+    rxIrqPending[index] = 0;
+    interrupts();
+    
+    if (pending == 0) {
+        if (!radio_isPacketReceived(radio)) {
+            return;
+        }
+        // Edge missed - only the polling time is known
+        irqUs = micros();
     }
     
-    // Save current listening protocol to restore after TX
-    ProtocolId savedRxProtocol = rx_protocol;
-    
-    // Configure radio for target protocol
-    configureProtocol(protocol);
-    delay(20);
-    
-    radio_setPower(platform_getMaxTxPower());
-    radio_setCrc(true);
-    
-    radio_writeFifo((uint8_t*)data, len);
-    radio_clearIrqFlags();
-    radio_setMode(MODE_TX);
-    
-    // Wait for transmission to complete (use timeout - IRQ flags are platform-specific)
-    // LoRa packets take: (preamble + payload) * symbol_time
-    // For SF7: symbol_time ~= 1ms, so even long packets complete in <100ms
-    // Use 500ms timeout to be safe
-    unsigned long startTime = millis();
-    while (millis() - startTime < 500) {
-        delay(1);
+    RxFrame* slot = rx_queue_reserve();
+    if (slot == nullptr) {
+        // Queue full - discard the frame so the radio can keep receiving
+        radio_clearIrqFlags(radio);
+        radio_setMode(radio, MODE_RX_CONTINUOUS);
+        return;
     }
     
-    radio_clearIrqFlags();
-    radio_setMode(MODE_STDBY);
-    delay(10);
+    RadioFrame frame;
+    uint32_t fetchUs = micros();
+    if (!receivePacket(radio, protocol, slot->data, &frame)) {
+        // Nothing usable read out - clear the IRQs and re-arm RX now (the
+        // radio is still configured for `protocol`)
+        radio_clearIrqFlags(radio);
+        radio_setMode(radio, MODE_RX_CONTINUOUS);
+        return;
+    }
+    uint32_t readyUs = micros();
+    timing_stats_record(&rxReadoutTiming, readyUs - fetchUs);
+    timing_stats_record(&rxReadyTiming, readyUs - irqUs);
+    
+    uint8_t packetLen = frame.length;
+    slot->length = packetLen;
+    slot->rssi = frame.rssi;
+    slot->snr = frame.snr;
+    slot->protocol = protocol;
+    slot->rxUs = irqUs;
+    slot->timestampMs = millis() - (micros() - irqUs) / 1000;
+    
+    // Re-arm RX as soon as the FIFO is drained
+    radio_setMode(radio, MODE_RX_CONTINUOUS);
+    
+    // Filter out noise packets (RSSI too far below the channel's noise floor to
+    // have been demodulated, -127 dBm until the floor is known); the length
+    // was already checked by receivePacket()
+    if (noise_floor_isNoise(protocol, slot->rssi)) {
+        return; // Slot not committed - reused by the next frame
+    }
     
-    // CRITICAL: Switch back to listening protocol and RX mode
-    // Reset lastConfiguredProtocol so we reconfigure even if it's the same protocol
-    // This ensures we always return to RX mode after TX
-    lastConfiguredProtocol = PROTOCOL_COUNT; // Force reconfiguration
-    configureProtocol(savedRxProtocol);
+    rx_dwell_recordFrame(protocol, airtime_packetMs(protocol_manager_getConfig(protocol), packetLen));
+    rx_queue_commit();
+}
+
+// Return the radio carrying `protocol` to RX on its listening protocol: if it
+// is still configured for it the modulation is already correct, otherwise
+// reconfigure for it
+void restoreRx(ProtocolId protocol) {
+    ProtocolId listen = listenProtocolFor(protocol);
+    if (radioOnProtocol(listen)) {
+        radio_setMode(radio_get(radioFor(listen)), MODE_RX_CONTINUOUS);
+    } else {
+        configureProtocol(listen);
+    }
+}
+
+// Reception guard for the protocol switch and relay TX paths: while a frame is
+// arriving on `listen`, report it so the caller keeps that radio in RX and
+// retries on the next loop. Bounded by the listen protocol's longest frame.
+// Each radio has its own guard - a frame arriving on one does not hold up
+// (or time out) a wait on the other.
+static bool rxGuardActive[RADIO_MAX_COUNT];
+static uint32_t rxGuardStartMs[RADIO_MAX_COUNT];
+static uint32_t rxGuardTimeoutMs[RADIO_MAX_COUNT];
+
+static bool receptionInProgress(ProtocolId listen) {
+    uint8_t index = radioFor(listen);
+    Radio* radio = radio_get(index);
+    if (!radioOnProtocol(listen) || !radio_isReceiving(radio)) {
+        if (rxGuardActive[index]) {
+            // Frame finished while we waited - drainRadio() picks it up
+            rxGuardActive[index] = false;
+            receptionsSaved++;
+        }
+        return false;
+    }
     
-    // Ensure we're in RX mode (configureProtocol should do this, but be explicit)
-    radio_setMode(MODE_RX_CONTINUOUS);
+    uint32_t nowMs = millis();
+    if (!rxGuardActive[index]) {
+        ProtocolInterfaceImpl* iface = protocol_interface_get(listen);
+        uint8_t maxLen = (iface != nullptr && iface->getMaxPacketSize != nullptr) ? iface->getMaxPacketSize() : 255;
+        rxGuardActive[index] = true;
+        rxGuardStartMs[index] = nowMs;
+        rxGuardTimeoutMs[index] = txTimeoutMs(protocol_manager_getConfig(listen), maxLen);
+        return true;
+    }
+    if (nowMs - rxGuardStartMs[index] < rxGuardTimeoutMs[index]) {
+        return true;
+    }
     
-    return true; // TX completed (timeout-based, no IRQ check needed)
+    // Longer than any valid frame - a stuck flag or interference, stop waiting
+    rxGuardActive[index] = false;
+    receptionsAborted++;
+    radio_clearIrqFlags(radio);
+    usbComm.sendDebugLog("ERR: RX busy timeout - leaving RX");
+    return false;
 }
 
-void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
+void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len, uint32_t rxUs) {
     ProtocolInterfaceImpl* iface = protocol_interface_get(protocol);
     ProtocolRuntimeState* state = &protocolStates[protocol];
     
@@ -325,6 +488,25 @@ void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
         return;
     }
     
+    // Drop copies of packets already relayed (or echoed back after our own relay)
+    uint32_t dedupKey;
+    if (iface->getDedupKey != nullptr && iface->getDedupKey(data, len, &dedupKey) &&
+        dup_cache_checkAndInsert(dedupKey, millis())) {
+        usbComm.sendDebugLog("Duplicate - dropped");
+        return;
+    }
+    
+    // Keep one chatty node from taking the relay airtime
+    uint32_t sourceKey;
+    if (iface->getSourceKey != nullptr && iface->getSourceKey(data, len, &sourceKey) &&
+        !rate_limit_allow(protocol, sourceKey, millis())) {
+        char limitMsg[50];
+        snprintf(limitMsg, sizeof(limitMsg), "%s source %08lX rate limited - dropped",
+                 iface->name, (unsigned long)sourceKey);
+        usbComm.sendDebugLog(limitMsg);
+        return;
+    }
+    
     // Convert received packet to canonical format
     CanonicalPacket canonical;
     if (!iface->convertToCanonical(data, len, &canonical)) {
@@ -347,6 +529,7 @@ void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
             return;
         }
     }
+    uint32_t parsedUs = micros();
     
     // Debug: Log successful parse (or relay for Meshtastic)
     char successMsg[50];
@@ -362,14 +545,36 @@ void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
     
     state->stats.rxCount++;
     
+    // Frames that have used up their hop budget go no further; our relay
+    // takes one hop off what is left
+    if (!canonical_packet_canRelay(&canonical)) {
+        state->stats.hopLimitDrops++;
+        usbComm.sendDebugLog("Hop limit reached - dropped");
+        return;
+    }
+    canonical_packet_consumeHop(&canonical);
+    
+    // In auto mode rx_protocol rotates and the frame may predate the last
+    // switch, and with dedicated radios every protocol is heard at once, so
+    // relay to every protocol other than the one it arrived on
+    bool relayToAll = autoSwitchEnabled || dedicatedRadios;
+    ProtocolId targets[PROTOCOL_COUNT];
+    uint8_t targetCount = 0;
+    for (uint8_t i = 0; i < (relayToAll ? PROTOCOL_COUNT : tx_protocol_count); i++) {
+        ProtocolId id = relayToAll ? (ProtocolId)i : tx_protocols[i];
+        if (!relayToAll || id != protocol) {
+            targets[targetCount++] = id;
+        }
+    }
+    
     // Debug: Log retransmission attempt
     char relayMsg[60];
-    snprintf(relayMsg, sizeof(relayMsg), "Relaying to %d TX protocol(s)", tx_protocol_count);
+    snprintf(relayMsg, sizeof(relayMsg), "Relaying to %d TX protocol(s)", targetCount);
     usbComm.sendDebugLog(relayMsg);
     
     // Relay to all other protocols using canonical format
-    for (uint8_t i = 0; i < tx_protocol_count; i++) {
-        ProtocolId targetProtocol = tx_protocols[i];
+    for (uint8_t i = 0; i < targetCount; i++) {
+        ProtocolId targetProtocol = targets[i];
         
         // Safety check: Don't retransmit to the same protocol we received from
         if (targetProtocol == protocol) {
@@ -395,9 +600,14 @@ void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
             continue;
         }
         
-        // Convert from canonical format to target protocol
+        // Convert from canonical format straight into a TX scheduler slot
+        TxFrame* txFrame = tx_scheduler_reserve(canonical.priority);
+        if (txFrame == nullptr) {
+            usbComm.sendDebugLog("ERR: TX queue full - dropped");
+            continue;
+        }
         uint8_t convertedLen = 0;
-        if (!targetIface->convertFromCanonical(&canonical, txBuffer, &convertedLen)) {
+        if (!targetIface->convertFromCanonical(&canonical, txFrame->data, sizeof(txFrame->data), &convertedLen)) {
             state->stats.conversionErrors++;
             char convErrMsg[60];
             snprintf(convErrMsg, sizeof(convErrMsg), "ERR: Convert fail %s (canon len=%d)", 
@@ -405,52 +615,312 @@ void handlePacket(ProtocolId protocol, const uint8_t* data, uint8_t len) {
             usbComm.sendDebugLog(convErrMsg);
             continue;
         }
+        uint32_t convertedUs = micros();
+        
+        // Remember the relayed frame as the target mesh will key it, so its
+        // rebroadcasts are not relayed straight back
+        if (targetIface->getDedupKey != nullptr &&
+            targetIface->getDedupKey(txFrame->data, convertedLen, &dedupKey)) {
+            dup_cache_insert(dedupKey, millis());
+        }
+        
+        // Queue for transmission - serviceTxScheduler() sends it with its group
+        latency_traceStart(&txFrame->trace, protocol, rxUs, parsedUs, convertedUs);
+        tx_scheduler_commit(txFrame, targetProtocol, canonical.priority, convertedLen, millis());
+    }
+}
+
+// Count a frame held back by the airtime budget (once per frame)
+static void deferForBudget(ProtocolId protocol, TxFrame* frame) {
+    if (!frame->deferred) {
+        frame->deferred = true;
+        protocolStates[protocol].stats.txDeferred++;
+    }
+}
+
+// Protocols whose next frame must wait for airtime budget (defer policy)
+static uint8_t budgetBlockedProtocols(uint32_t nowMs) {
+    uint8_t blockedMask = 0;
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        ProtocolId protocol = (ProtocolId)i;
+        TxFrame* head = tx_scheduler_peek(protocol, nowMs);
+        if (head != nullptr && airtime_budget_get(protocol)->policy == BUDGET_POLICY_DEFER &&
+            !airtime_budget_canSend(protocol, head->airtimeMs, nowMs)) {
+            deferForBudget(protocol, head);
+            blockedMask |= (1 << protocol);
+        }
+    }
+    return blockedMask;
+}
+
+typedef enum {
+    TX_RESULT_SENT,         // TX_DONE received
+    TX_RESULT_TIMEOUT,      // No TX_DONE within the airtime bound
+    TX_RESULT_CHANNEL_BUSY  // Listen-before-talk gave up - nothing was sent
+} TxResult;
+
+// Relay TX engine: drains the group of pending frames for whichever protocol
+// is due, with one switch out to that protocol and one switch back for the
+// whole group. Nothing here waits - listen-before-talk and TX_DONE are polled
+// from loop() so USB and the LED keep being serviced while a frame is on air.
+typedef enum {
+    TX_ENGINE_IDLE,     // Listening on rx_protocol, no group in progress
+    TX_ENGINE_LBT,      // On the target protocol, waiting for a clear channel
+    TX_ENGINE_SENDING   // Frame on air, waiting for TX_DONE
+} TxEngineState;
+
+static TxEngineState txState = TX_ENGINE_IDLE;
+static ProtocolId txTarget = PROTOCOL_COUNT;
+static TxFrame* txCurrent = nullptr;
+static unsigned long txStartMs = 0;
+static unsigned long txLastPollMs = 0;
+static uint32_t txWaitMs = 0;
+static uint8_t batchSize = 0;
+static uint32_t batchAirtimeMs = 0;
+static bool radioUsed = false;
+static unsigned long awayStartMs = 0;
+
+static void finishGroup() {
+    if (batchSize > 0) {
+        tx_scheduler_recordBatch(batchSize, batchAirtimeMs);
+    }
+    // Budget drops/deferrals alone never take the radio out of RX
+    if (radioUsed) {
+        restoreRx(txTarget);
+        if (!dedicatedRadios) {
+            rx_dwell_recordAway(millis() - awayStartMs);
+        }
+    }
+    txState = TX_ENGINE_IDLE;
+    txCurrent = nullptr;
+}
+
+// Take the next frame of the group and start listen-before-talk for it.
+// Ends the group once the airtime cap is reached - the rest go on the next visit.
+static void startNextFrame() {
+    TxFrame* frame;
+    while ((frame = tx_scheduler_peek(txTarget, millis())) != nullptr &&
+           (batchSize == 0 || batchAirtimeMs + frame->airtimeMs <= TX_BATCH_AIRTIME_MAX_MS)) {
+        // Duty-cycle limit: drop or leave the rest of the group for later
+        if (!airtime_budget_canSend(txTarget, frame->airtimeMs, millis())) {
+            if (airtime_budget_get(txTarget)->policy == BUDGET_POLICY_DROP) {
+                protocolStates[txTarget].stats.txBudgetDrops++;
+                usbComm.sendDebugLog("ERR: Airtime budget - dropped");
+                tx_scheduler_drop(frame);
+                continue;
+            }
+            deferForBudget(txTarget, frame);
+            break;
+        }
         
         // Debug: Log transmission attempt
-        ProtocolConfig* targetConfig = protocol_manager_getConfig(targetProtocol);
+        ProtocolInterfaceImpl* targetIface = protocol_interface_get(txTarget);
+        ProtocolConfig* targetConfig = protocol_manager_getConfig(txTarget);
         char txMsg[70];
         snprintf(txMsg, sizeof(txMsg), "TX %s: %d bytes @ %.3f MHz", 
-                 targetIface->name ? targetIface->name : "Unknown", convertedLen,
+                 targetIface && targetIface->name ? targetIface->name : "Unknown", frame->length,
                  targetConfig ? targetConfig->frequencyHz / 1000000.0 : 0.0);
         usbComm.sendDebugLog(txMsg);
         
-        // Transmit to target protocol
-        if (transmitPacket(targetProtocol, txBuffer, convertedLen)) {
-            ProtocolRuntimeState* targetState = &protocolStates[targetProtocol];
-            if (targetState != nullptr && targetIface->updateStats != nullptr) {
-                targetIface->updateStats(targetState, false, true, false, false);
-            }
-            platform_blinkLed(10);
-            usbComm.sendDebugLog("TX success");
-        } else {
-            usbComm.sendDebugLog("ERR: TX fail");
+        // Pick up anything that finished arriving before the radio leaves RX
+        ProtocolId listen = listenProtocolFor(txTarget);
+        if (radioOnProtocol(listen)) {
+            drainRadio(listen);
         }
+        
+        // Configure the target's radio (no-op if already there)
+        configureProtocol(txTarget);
+        
+        // configure() leaves the radio in RX - stop it before CAD and loading the FIFO
+        Radio* radio = radio_get(radioFor(txTarget));
+        radio_setMode(radio, MODE_STDBY);
+        txRadio = radioFor(txTarget);
+        radioUsed = true;
+        txCurrent = frame;
+        txCurrent->inFlight = true;
+        lbt_begin(radio, targetConfig);
+        txState = TX_ENGINE_LBT;
+        return;
     }
     
-    // Switch back to listening protocol
-    configureProtocol(protocol);
+    finishGroup();
 }
 
-void switchProtocol() {
-    if (!autoSwitchEnabled || protocolSwitchIntervalMs == 0) {
+// Frame uploaded by radio_preloadTx() - the seq tells a reused slot apart
+static TxFrame* preloadedFrame = nullptr;
+static uint16_t preloadedSeq = 0;
+
+// While the queue waits for its group to become due, upload the frame that
+// goes first into the radio's TX region so startTransmit() only has to arm
+// it. Never while a frame is arriving or still waiting to be drained.
+static void preloadNextFrame(uint32_t nowMs) {
+    TxFrame* next = tx_scheduler_peekNext(nowMs);
+    if (next == nullptr || (next == preloadedFrame && next->seq == preloadedSeq)) {
+        return;
+    }
+    ProtocolId listen = listenProtocolFor(next->protocol);
+    Radio* radio = radio_get(radioFor(listen));
+    if (!radioOnProtocol(listen) || rxIrqPending[radioFor(listen)] != 0 || radio_isReceiving(radio)) {
         return;
     }
     
-    unsigned long currentTime = millis();
-    if (currentTime - lastProtocolSwitch >= protocolSwitchIntervalMs) {
-        // Rotate through all available protocols
-        ProtocolId nextProtocol = (ProtocolId)((rx_protocol + 1) % PROTOCOL_COUNT);
-        rx_protocol = nextProtocol;
-        
-        
-        // Update transmit protocol list
-        update_tx_protocols(rx_protocol);
+    preloadedFrame = nullptr;
+    if (radio_preloadTx(radio, next->data, next->length)) {
+        preloadedFrame = next;
+        preloadedSeq = next->seq;
+        txPreloads++;
+    }
+}
+
+// Channel is clear: load the FIFO (or arm the preload) and key up
+static void startTransmit() {
+    unsigned long startUs = micros();
+    Radio* radio = radio_get(txRadio);
+    radio_setPower(radio, platform_getMaxTxPower());
+    radio_setCrc(radio, true);
+    
+    bool preloaded = false;
+    if (txCurrent == preloadedFrame && txCurrent->seq == preloadedSeq) {
+        preloaded = radio_armTxPreload(radio);
+        if (!preloaded) {
+            txPreloadsUnused++;
+        }
+    }
+    preloadedFrame = nullptr;
+    if (!preloaded) {
+        radio_writeFifo(radio, txCurrent->data, txCurrent->length);
+    }
+    radio_clearIrqFlags(radio);
+    txDone = false;
+    radio_setMode(radio, MODE_TX);
+    unsigned long keyedUs = micros();
+    latency_traceTxStart(&txCurrent->trace, keyedUs);
+    timing_stats_record(&txStartTiming[preloaded ? 1 : 0], keyedUs - startUs);
+    
+    // TX_DONE is bounded by the frame's time-on-air
+    txStartMs = millis();
+    txLastPollMs = txStartMs;
+    txWaitMs = txTimeoutMs(protocol_manager_getConfig(txTarget), txCurrent->length);
+    txState = TX_ENGINE_SENDING;
+}
+
+static void completeFrame(TxResult result) {
+    Radio* radio = radio_get(txRadio);
+    txRadio = NO_RADIO;
+    radio_clearIrqFlags(radio);
+    
+    // Channel still busy after backing off - later frames would meet the same
+    // traffic, so leave them for the next visit. Nothing went out, so the
+    // frame stays queued for a retry (until its retries run out).
+    if (result == TX_RESULT_CHANNEL_BUSY) {
+        if (tx_scheduler_retry(txCurrent, millis())) {
+            usbComm.sendDebugLog("Channel busy - TX retry later");
+        } else {
+            usbComm.sendDebugLog("ERR: Channel busy - TX aborted");
+        }
+        finishGroup();
+        return;
+    }
+    
+    // Charge the budget whether or not TX_DONE arrived - the air was used either way
+    airtime_budget_consume(txTarget, txCurrent->airtimeMs);
+    protocolStates[txTarget].stats.txAirtimeMs += txCurrent->airtimeMs;
+    
+    if (result == TX_RESULT_SENT) {
+        latency_traceTxDone(&txCurrent->trace, micros());
+        ProtocolInterfaceImpl* targetIface = protocol_interface_get(txTarget);
+        if (targetIface != nullptr && targetIface->updateStats != nullptr) {
+            targetIface->updateStats(&protocolStates[txTarget], false, true, false, false);
+        }
+        platform_blinkLed(10);
+        usbComm.sendDebugLog("TX success");
+    } else {
+        usbComm.sendDebugLog("ERR: TX fail");
+    }
+    
+    batchAirtimeMs += txCurrent->airtimeMs;
+    tx_scheduler_release(txCurrent, millis());
+    batchSize++;
+    
+    startNextFrame();
+}
+
+// Advance the TX engine by one step
+void serviceTxScheduler() {
+    switch (txState) {
+        case TX_ENGINE_IDLE: {
+            uint32_t nowMs = millis();
+            if (tx_scheduler_expire(nowMs) > 0) {
+                usbComm.sendDebugLog("TX frame(s) expired - dropped");
+            }
+            ProtocolId due = tx_scheduler_dueProtocol(nowMs, budgetBlockedProtocols(nowMs));
+            if (due >= PROTOCOL_COUNT) {
+                preloadNextFrame(nowMs);
+                return;
+            }
+            
+            // Don't cut off a frame that is arriving - the queue waits a loop or two
+            if (receptionInProgress(listenProtocolFor(due))) {
+                return;
+            }
+            
+            txTarget = due;
+            batchSize = 0;
+            batchAirtimeMs = 0;
+            radioUsed = false;
+            awayStartMs = millis();
+            startNextFrame();
+            break;
+        }
         
-        // Configure radio for new listening protocol
-        configureProtocol(rx_protocol);
+        case TX_ENGINE_LBT: {
+            LbtStatus status = lbt_poll();
+            if (status == LBT_CLEAR) {
+                startTransmit();
+            } else if (status == LBT_GAVE_UP) {
+                completeFrame(TX_RESULT_CHANNEL_BUSY);
+            }
+            break;
+        }
         
-        lastProtocolSwitch = currentTime;
+        case TX_ENGINE_SENDING: {
+            // The ISR sets txDone; the IRQ register is polled once per ms as a
+            // fallback in case the DIO edge was missed
+            unsigned long nowMs = millis();
+            bool done = txDone;
+            if (!done && nowMs != txLastPollMs) {
+                txLastPollMs = nowMs;
+                done = radio_isTransmitDone(radio_get(txRadio));
+            }
+            if (done) {
+                completeFrame(TX_RESULT_SENT);
+            } else if (nowMs - txStartMs >= txWaitMs) {
+                completeFrame(TX_RESULT_TIMEOUT);
+            }
+            break;
+        }
+    }
+}
+
+// Auto mode: move to the next listen protocol once the current dwell is over
+void switchProtocol() {
+    // Dedicated radios each keep their protocol - there is nothing to rotate
+    if (!autoSwitchEnabled || dedicatedRadios || txRadio != NO_RADIO || !rx_dwell_isDue(millis())) {
+        return;
+    }
+    
+    // Overrun the dwell rather than drop a frame mid-reception
+    if (receptionInProgress(rx_protocol)) {
+        return;
     }
+    
+    // Pick up anything that finished arriving before we leave this protocol
+    drainRadio(rx_protocol);
+    
+    // Rotate through all available protocols
+    rx_protocol = (ProtocolId)((rx_protocol + 1) % PROTOCOL_COUNT);
+    configureProtocol(rx_protocol);
+    rx_dwell_start(rx_protocol, millis());
 }
 
 void setProtocol(ProtocolState protocol) {
@@ -494,36 +964,56 @@ void printStatistics() {
     usbComm.sendDebugLog(statsBuffer);
 }
 
+// Queue a protocol's test packet - it goes out through the TX engine like a relay
 void sendTestMessage(ProtocolId protocol) {
     ProtocolInterfaceImpl* iface = protocol_interface_get(protocol);
     if (iface == nullptr || iface->generateTestPacket == nullptr) {
         return;
     }
     
-    uint8_t testBuffer[64];
-    uint8_t testLen = 0;
-    char debugMsg[64];
+    TxFrame* txFrame = tx_scheduler_reserve(CANONICAL_PRIORITY_TEXT);
+    if (txFrame == nullptr) {
+        usbComm.sendDebugLog("ERR: TX queue full - test dropped");
+        return;
+    }
     
-    iface->generateTestPacket(testBuffer, &testLen);
+    uint8_t testLen = 0;
+    iface->generateTestPacket(txFrame->data, &testLen);
+    latency_traceClear(&txFrame->trace);
     
-    ProtocolConfig* config = protocol_manager_getConfig(protocol);
-    snprintf(debugMsg, sizeof(debugMsg), "TX %s: %d bytes @ %.3f MHz", 
-             iface->name, testLen, config->frequencyHz / 1000000.0);
+    char debugMsg[64];
+    snprintf(debugMsg, sizeof(debugMsg), "Test %s: %d bytes queued", iface->name, testLen);
     usbComm.sendDebugLog(debugMsg);
     
-    if (transmitPacket(protocol, testBuffer, testLen)) {
-        ProtocolRuntimeState* state = &protocolStates[protocol];
-        if (state != nullptr && iface->updateStats != nullptr) {
-            iface->updateStats(state, false, true, false, false);
+    tx_scheduler_commit(txFrame, protocol, CANONICAL_PRIORITY_TEXT, testLen, millis());
+}
+
+// A radio command kept BUSY high past its timeout: reset and reinitialize
+// the radios and put the listen protocols back. The fault is not tied to one
+// radio, so all of them start over. A TX in flight ends through its own timeout.
+static void recoverRadio() {
+    usbComm.sendDebugLog("ERR: Radio command timed out - reinitializing");
+    uint8_t radioCount = dedicatedRadios ? PROTOCOL_COUNT : 1;
+    for (uint8_t radio = 0; radio < radioCount; radio++) {
+        if (!radio_init(radio_get(radio))) {
+            radioInitialized = false;
+            usbComm.sendError("Radio recovery failed - check SPI connections");
+            return;
         }
-        platform_blinkLed(50);
-        usbComm.sendDebugLog("Test TX success");
-    } else {
-        usbComm.sendDebugLog("Test TX failed");
+        radio_attachInterrupt(radio_get(radio), radioInterrupts[radio]);
+        configuredProtocol[radio] = PROTOCOL_COUNT;
     }
+    radio_busy_clearFault();
     
-    // Switch back to listening protocol
-    configureProtocol(rx_protocol);
+    // init() forgot every setting (and any preload) - apply the listen protocols from scratch
+    preloadedFrame = nullptr;
+    if (dedicatedRadios) {
+        for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+            configureProtocol((ProtocolId)i);
+        }
+    } else {
+        configureProtocol(rx_protocol);
+    }
 }
 
 void setup() {
@@ -553,6 +1043,14 @@ void setup() {
     
     // Initialize protocol manager first (sets up default configs)
     protocol_manager_init();
+    rx_queue_init();
+    tx_scheduler_init();
+    airtime_budget_init();
+    dup_cache_init();
+    lbt_init();
+    latency_init();
+    rate_limit_init();
+    noise_floor_init();
     
     // Initialize protocol states dynamically
     for (ProtocolId id = (ProtocolId)0; id < PROTOCOL_COUNT; id = (ProtocolId)(id + 1)) {
@@ -562,9 +1060,32 @@ void setup() {
     // Process USB commands before radio init (in case user wants to query device state)
     usbComm.process();
     
-    // Try to initialize radio - but don't block forever if it fails
+    // Try to initialize the radios - but don't block forever if one fails
     // Radio init might take time, so process USB commands periodically
-    radioInitialized = radio_init();
+    for (uint8_t radio = 0; radio < RADIO_MAX_COUNT; radio++) {
+        configuredProtocol[radio] = PROTOCOL_COUNT;
+        appliedProtocol[radio] = PROTOCOL_COUNT;
+    }
+    uint8_t radioCount = radio_count();
+    uint8_t radiosReady = 0;
+    for (uint8_t radio = 0; radio < radioCount; radio++) {
+        if (!radio_init(radio_get(radio))) {
+            break;
+        }
+        radio_attachInterrupt(radio_get(radio), radioInterrupts[radio]);
+        radiosReady++;
+    }
+    radioInitialized = radiosReady > 0;
+    
+    // One radio per protocol: each listens on its own protocol full time.
+    // Otherwise radio 0 time-slices between them as before.
+    dedicatedRadios = radiosReady >= PROTOCOL_COUNT;
+    if (radioCount > 1) {
+        char debugMsg[50];
+        snprintf(debugMsg, sizeof(debugMsg), "Radios: %d of %d ready - %s", radiosReady, radioCount,
+                 dedicatedRadios ? "dedicated" : "shared");
+        usbComm.sendDebugLog(debugMsg);
+    }
     
     // Process USB commands after radio init attempt
     usbComm.process();
@@ -577,10 +1098,7 @@ void setup() {
         }
         // Don't block - allow USB commands to be processed for diagnostics
     } else {
-        radio_attachInterrupt(onPacketReceived);
-        
         // Disable auto-switch - always listen to MeshCore (protocol 0)
-        protocolSwitchIntervalMs = 0;
         autoSwitchEnabled = false;
         
         // Set RX protocol to MeshCore (protocol 0)
@@ -590,9 +1108,16 @@ void setup() {
         // Set TX protocols to all protocols EXCEPT the RX protocol
         update_tx_protocols(rx_protocol);
         
-        // Configure radio for listen protocol (MeshCore)
-        configureProtocol(rx_protocol);
-        lastProtocolSwitch = millis();
+        // Configure radio for listen protocol (MeshCore) - every protocol
+        // on its own radio when they are dedicated
+        if (dedicatedRadios) {
+            for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+                configureProtocol((ProtocolId)i);
+            }
+        } else {
+            configureProtocol(rx_protocol);
+        }
+        rx_dwell_init(rx_protocol, millis());
         
         // Process USB commands after configuration
         usbComm.process();
@@ -623,11 +1148,22 @@ void loop() {
             usbComm.sendError("Radio not initialized - check SPI connections");
         }
         
+        platform_updateLed();
         delay(10);
         return;
     }
     
     // Normal operation - radio is working
+    unsigned long loopStartUs = micros();
+    
+    // Finish queued radio commands; one that timed out means the radio needs a reset
+    radio_poll();
+    if (radio_busy_hasFault()) {
+        recoverRadio();
+        if (!radioInitialized) {
+            return;
+        }
+    }
     static unsigned long lastDebugLog = 0;
     unsigned long now = millis();
     
@@ -645,55 +1181,52 @@ void loop() {
         }
     }
     
-    // Check for packets
-    if (radio_isPacketReceived()) {
-        packetReceived = true;
+    // Drain completed frames from the radios into the RX queue, then sample
+    // the channel's noise floor (not on a radio a TX group has taken off its
+    // listen protocol)
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        ProtocolId listen = (ProtocolId)i;
+        if (radioFor(listen) == txRadio || (!dedicatedRadios && listen != rx_protocol)) {
+            continue;
+        }
+        drainRadio(listen);
+        if (radioOnProtocol(listen)) {
+            noise_floor_poll(radio_get(radioFor(listen)), listen, now);
+        }
     }
     
-    if (packetReceived) {
-        packetReceived = false;
+    // Relay one queued frame per iteration so USB and the radio stay serviced
+    RxFrame* frame = rx_queue_peek();
+    if (frame != nullptr) {
+        // Debug: Log packet reception
+        ProtocolInterfaceImpl* rxIface = protocol_interface_get(frame->protocol);
+        const char* rxName = rxIface && rxIface->name ? rxIface->name : "Unknown";
+        char debugMsg[60];
+        snprintf(debugMsg, sizeof(debugMsg), "RX %s: RSSI=%d SNR=%d Len=%d", rxName, frame->rssi, frame->snr, frame->length);
+        usbComm.sendDebugLog(debugMsg);
         
-        uint8_t packetLen = 0;
-        if (receivePacket(rxBuffer, &packetLen)) {
-            // Verify packetLen was actually set (should be > 0 and <= 255)
-            if (packetLen > 0 && packetLen <= 255) {
-                int16_t rssi = radio_getRssi();
-                int8_t snr = radio_getSnr();
-                
-                // Filter out noise packets (RSSI -127 dBm means no signal, just noise)
-                // Also filter packets with invalid length (255 usually means buffer corruption)
-                if (rssi <= -127 || packetLen == 255) {
-                    // Noise or corrupted packet - ignore it
-                    radio_clearIrqFlags();
-                    radio_setMode(MODE_RX_CONTINUOUS);
-                    return; // Skip processing this packet
-                }
-                
-                // Debug: Log packet reception
-                ProtocolInterfaceImpl* rxIface = protocol_interface_get(rx_protocol);
-                const char* rxName = rxIface && rxIface->name ? rxIface->name : "Unknown";
-                char debugMsg[60];
-                snprintf(debugMsg, sizeof(debugMsg), "RX %s: RSSI=%d SNR=%d Len=%d", rxName, rssi, snr, packetLen);
-                usbComm.sendDebugLog(debugMsg);
-                
-                // Send packet to web interface
-                usbComm.sendRxPacket(rx_protocol, rssi, snr, rxBuffer, packetLen);
-                
-                // Handle packet (relay to other protocols)
-                handlePacket(rx_protocol, rxBuffer, packetLen);
-                
-                radio_setMode(MODE_RX_CONTINUOUS);
-            } else {
-                // Invalid packet length - clear and reconfigure
-                radio_clearIrqFlags();
-                configureProtocol(rx_protocol);
-            }
-        } else {
-            // Packet reception failed - reconfigure radio
-            radio_clearIrqFlags();
-            configureProtocol(rx_protocol);
-        }
+        // Send packet to web interface
+        usbComm.sendRxPacket(frame->protocol, frame->rssi, frame->snr, frame->data, frame->length, frame->rxUs);
+        
+        // Handle packet (relay to other protocols)
+        handlePacket(frame->protocol, frame->data, frame->length, frame->rxUs);
+        
+        rx_queue_pop();
     }
     
-    delay(1);
-}
+    // Send whichever TX group is due
+    serviceTxScheduler();
+    
+    // Auto mode: rotate the listen protocol when its dwell is over
+    switchProtocol();
+    
+    // End a pending LED blink
+    platform_updateLed();
+    
+    // Every step above returns without waiting - publish how long the pass took
+    uint32_t elapsedUs = micros() - loopStartUs;
+    timing_stats_record(&loopTiming, elapsedUs, LOOP_AVG_SHIFT);
+    
+    // Cooperative yield (lets the nRF52 USB task run) instead of sleeping
+    yield();
+}
\ No newline at end of file
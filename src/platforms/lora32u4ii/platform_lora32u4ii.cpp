@@ -9,6 +9,7 @@
 #include "../platform_interface.h"
 #include "config.h"
 #include <Arduino.h>
+#include <SPI.h>
 
 void platform_init() {
     // Initialize LED
@@ -23,10 +24,23 @@ void platform_setLed(bool on) {
     digitalWrite(LED_PIN, on ? HIGH : LOW);
 }
 
+// Pending blink: LED is switched off by platform_updateLed() once it expires
+static bool ledBlinking = false;
+static unsigned long ledOnMs = 0;
+static uint16_t ledDurationMs = 0;
+
 void platform_blinkLed(uint16_t durationMs) {
     platform_setLed(true);
-    delay(durationMs);
-    platform_setLed(false);
+    ledBlinking = true;
+    ledOnMs = millis();
+    ledDurationMs = durationMs;
+}
+
+void platform_updateLed() {
+    if (ledBlinking && millis() - ledOnMs >= ledDurationMs) {
+        ledBlinking = false;
+        platform_setLed(false);
+    }
 }
 
 uint8_t platform_getMaxTxPower() {
@@ -66,10 +80,50 @@ int8_t platform_getRadioPowerEnablePin() {
     return -1;  // SX1276 doesn't have a power enable pin
 }
 
+uint8_t platform_getRadioCount() {
+    return 1;  // On-board SX1276 only
+}
+
+bool platform_getRadioPins(uint8_t index, RadioPins* pins) {
+    if (index != 0) {
+        return false;
+    }
+    pins->nss = RADIO_NSS_PIN;
+    pins->reset = RADIO_RESET_PIN;
+    pins->dio0 = RADIO_DIO0_PIN;
+    pins->dio1 = RADIO_DIO1_PIN;
+    pins->busy = -1;
+    pins->powerEnable = -1;
+    return true;
+}
+
 uint32_t platform_getSpiFrequency() {
     return SPI_FREQ;  // 1 MHz for LoRa32u4II
 }
 
+// No DMA on the ATmega32u4: bulk transfers are byte loops, and a background
+// transfer is done by the time platform_spiStart() returns
+void platform_spiTransfer(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t in = SPI.transfer(tx != nullptr ? tx[i] : 0x00);
+        if (rx != nullptr) {
+            rx[i] = in;
+        }
+    }
+}
+
+bool platform_spiStart(const uint8_t* tx, uint8_t* rx, uint16_t len, void (*done)(void* context), void* context) {
+    platform_spiTransfer(tx, rx, len);
+    if (done != nullptr) {
+        done(context);
+    }
+    return true;
+}
+
+bool platform_spiPoll() {
+    return false;
+}
+
 // SX126x-specific configuration - not used by SX1276
 float platform_getTcxoVoltage() {
     return 0.0f;  // SX1276 doesn't use TCXO voltage setting
@@ -82,3 +136,7 @@ bool platform_useDio2AsRfSwitch() {
 bool platform_useRegulatorLDO() {
     return false;  // Not applicable for SX1276
 }
+
+bool platform_useFastTurnaround() {
+    return false;  // Not applicable for SX1276
+}
@@ -8,110 +8,184 @@
  * via platformio.ini src_filter).
  */
 
+#include "../../config.h"
 #include "../../radio/radio_interface.h"
 #include "../../radio/sx1276_direct/sx1276_direct.h"
+#include "../platform_interface.h"
+
+// The on-board radio's driver instance - radio_get() hands out its address
+struct Radio {
+    Sx1276Direct dev;
+};
+
+static Radio radios[RADIO_MAX_COUNT];
+
+uint8_t radio_count() {
+    return 1;
+}
+
+Radio* radio_get(uint8_t index) {
+    return index < radio_count() ? &radios[index] : nullptr;
+}
 
 // Implement radio interface by delegating to SX1276 direct SPI implementation
-bool radio_init() { 
-    return sx1276_direct_init(); 
+bool radio_init(Radio* radio) { 
+    RadioPins pins;
+    if (!platform_getRadioPins((uint8_t)(radio - radios), &pins)) {
+        return false;
+    }
+    return sx1276_direct_init(&radio->dev, &pins); 
 }
 
-uint32_t radio_getMinFrequency() {
+uint32_t radio_getMinFrequency(Radio* radio) {
+    (void)radio;
     return sx1276_direct_getMinFrequency();
 }
 
-uint32_t radio_getMaxFrequency() {
+uint32_t radio_getMaxFrequency(Radio* radio) {
+    (void)radio;
     return sx1276_direct_getMaxFrequency();
 }
 
-void radio_setFrequency(uint32_t freq_hz) { 
-    sx1276_direct_setFrequency(freq_hz); 
+void radio_setFrequency(Radio* radio, uint32_t freq_hz) { 
+    sx1276_direct_setFrequency(&radio->dev, freq_hz); 
+}
+
+void radio_setPower(Radio* radio, uint8_t power) { 
+    sx1276_direct_setPower(&radio->dev, power); 
+}
+
+void radio_setPreambleLength(Radio* radio, uint16_t length) { 
+    sx1276_direct_setPreambleLength(&radio->dev, length); 
+}
+
+void radio_setCrc(Radio* radio, bool enable) { 
+    sx1276_direct_setCrc(&radio->dev, enable); 
+}
+
+void radio_setSyncWord(Radio* radio, uint8_t syncWord) { 
+    sx1276_direct_setSyncWord(&radio->dev, syncWord); 
+}
+
+void radio_setHeaderMode(Radio* radio, bool implicit) { 
+    sx1276_direct_setHeaderMode(&radio->dev, implicit); 
+}
+
+void radio_setBandwidth(Radio* radio, uint8_t bw) { 
+    sx1276_direct_setBandwidth(&radio->dev, bw); 
+}
+
+void radio_setSpreadingFactor(Radio* radio, uint8_t sf) { 
+    sx1276_direct_setSpreadingFactor(&radio->dev, sf); 
+}
+
+void radio_setCodingRate(Radio* radio, uint8_t cr) { 
+    sx1276_direct_setCodingRate(&radio->dev, cr); 
+}
+
+void radio_setInvertIQ(Radio* radio, bool invert) { 
+    sx1276_direct_setInvertIQ(&radio->dev, invert); 
+}
+
+void radio_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    sx1276_direct_compileProfile(settings, profile);
+}
+
+void radio_applyProfile(Radio* radio, const RadioProfile* profile) {
+    sx1276_direct_applyProfile(&radio->dev, profile);
+}
+
+bool radio_benchmarkFifoRead(Radio* radio, SpiBenchmark* result) {
+    // No DMA on the ATmega32u4 - bulk transfers are the same byte loop
+    (void)radio;
+    (void)result;
+    return false;
 }
 
-void radio_setPower(uint8_t power) { 
-    sx1276_direct_setPower(power); 
+void radio_poll() {
+    // SX1276 commands are plain register writes - nothing runs in the background
 }
 
-void radio_setPreambleLength(uint16_t length) { 
-    sx1276_direct_setPreambleLength(length); 
+void radio_setMode(Radio* radio, uint8_t mode) { 
+    sx1276_direct_setMode(&radio->dev, mode); 
 }
 
-void radio_setCrc(bool enable) { 
-    sx1276_direct_setCrc(enable); 
+void radio_writeFifo(Radio* radio, uint8_t* data, uint8_t len) { 
+    sx1276_direct_writeFifo(&radio->dev, data, len); 
 }
 
-void radio_setSyncWord(uint8_t syncWord) { 
-    sx1276_direct_setSyncWord(syncWord); 
+bool radio_preloadTx(Radio* radio, const uint8_t* data, uint8_t len) {
+    return sx1276_direct_preloadTx(&radio->dev, data, len);
 }
 
-void radio_setHeaderMode(bool implicit) { 
-    sx1276_direct_setHeaderMode(implicit); 
+bool radio_armTxPreload(Radio* radio) {
+    return sx1276_direct_armTxPreload(&radio->dev);
 }
 
-void radio_setBandwidth(uint8_t bw) { 
-    sx1276_direct_setBandwidth(bw); 
+void radio_readFifo(Radio* radio, uint8_t* data, uint8_t len) { 
+    sx1276_direct_readFifo(&radio->dev, data, len); 
 }
 
-void radio_setSpreadingFactor(uint8_t sf) { 
-    sx1276_direct_setSpreadingFactor(sf); 
+bool radio_fetchFrame(Radio* radio, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    return sx1276_direct_fetchFrame(&radio->dev, data, maxLen, frame);
 }
 
-void radio_setCodingRate(uint8_t cr) { 
-    sx1276_direct_setCodingRate(cr); 
+int16_t radio_getRssi(Radio* radio) { 
+    return sx1276_direct_getRssi(&radio->dev); 
 }
 
-void radio_setInvertIQ(bool invert) { 
-    sx1276_direct_setInvertIQ(invert); 
+int8_t radio_getSnr(Radio* radio) { 
+    return sx1276_direct_getSnr(&radio->dev); 
 }
 
-void radio_setMode(uint8_t mode) { 
-    sx1276_direct_setMode(mode); 
+int16_t radio_getRssiInst(Radio* radio) { 
+    return sx1276_direct_getRssiInst(&radio->dev); 
 }
 
-void radio_writeFifo(uint8_t* data, uint8_t len) { 
-    sx1276_direct_writeFifo(data, len); 
+uint8_t radio_readRegister(Radio* radio, uint8_t reg) { 
+    return sx1276_direct_readRegister(&radio->dev, reg); 
 }
 
-void radio_readFifo(uint8_t* data, uint8_t len) { 
-    sx1276_direct_readFifo(data, len); 
+void radio_writeRegister(Radio* radio, uint8_t reg, uint8_t value) { 
+    sx1276_direct_writeRegister(&radio->dev, reg, value); 
 }
 
-int16_t radio_getRssi() { 
-    return sx1276_direct_getRssi(); 
+void radio_attachInterrupt(Radio* radio, void (*handler)()) { 
+    sx1276_direct_attachInterrupt(&radio->dev, handler); 
 }
 
-int8_t radio_getSnr() { 
-    return sx1276_direct_getSnr(); 
+bool radio_isPacketReceived(Radio* radio) { 
+    return sx1276_direct_isPacketReceived(&radio->dev); 
 }
 
-uint8_t radio_readRegister(uint8_t reg) { 
-    return sx1276_direct_readRegister(reg); 
+bool radio_isTransmitDone(Radio* radio) { 
+    return sx1276_direct_isTransmitDone(&radio->dev); 
 }
 
-void radio_writeRegister(uint8_t reg, uint8_t value) { 
-    sx1276_direct_writeRegister(reg, value); 
+bool radio_isCadDone(Radio* radio) { 
+    return sx1276_direct_isCadDone(&radio->dev); 
 }
 
-void radio_attachInterrupt(void (*handler)()) { 
-    sx1276_direct_attachInterrupt(handler); 
+bool radio_isChannelActive(Radio* radio) { 
+    return sx1276_direct_isChannelActive(&radio->dev); 
 }
 
-bool radio_isPacketReceived() { 
-    return sx1276_direct_isPacketReceived(); 
+bool radio_isReceiving(Radio* radio) { 
+    return sx1276_direct_isReceiving(&radio->dev); 
 }
 
-uint8_t radio_getPacketLength() { 
-    return sx1276_direct_getPacketLength(); 
+uint8_t radio_getPacketLength(Radio* radio) { 
+    return sx1276_direct_getPacketLength(&radio->dev); 
 }
 
-void radio_clearIrqFlags() { 
-    sx1276_direct_clearIrqFlags(); 
+void radio_clearIrqFlags(Radio* radio) { 
+    sx1276_direct_clearIrqFlags(&radio->dev); 
 }
 
-uint16_t radio_getIrqFlags() { 
-    return sx1276_direct_getIrqFlags(); 
+uint16_t radio_getIrqFlags(Radio* radio) { 
+    return sx1276_direct_getIrqFlags(&radio->dev); 
 }
 
-bool radio_hasPacketErrors() { 
-    return sx1276_direct_hasPacketErrors(); 
+bool radio_hasPacketErrors(Radio* radio) { 
+    return sx1276_direct_hasPacketErrors(&radio->dev); 
 }
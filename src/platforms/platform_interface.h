@@ -16,7 +16,8 @@ void platform_init();
 
 // LED control
 void platform_setLed(bool on);
-void platform_blinkLed(uint16_t durationMs);
+void platform_blinkLed(uint16_t durationMs);  // Non-blocking: LED on now, off after durationMs
+void platform_updateLed();                    // Call every loop to end a pending blink
 
 // Platform-specific power management
 uint8_t platform_getMaxTxPower();  // Returns max TX power in dBm for this platform
@@ -36,12 +37,40 @@ int8_t platform_getRadioDio1Pin();         // DIO1 interrupt pin (-1 if not used
 int8_t platform_getRadioBusyPin();         // Busy pin for SX1262 (-1 if not used)
 int8_t platform_getRadioPowerEnablePin();  // Power enable pin (-1 if not used)
 
+// Radios fitted to the board. Radio 0 is the one described by the getters
+// above; further radios share the SPI bus and radio settings below but have
+// their own pins (-1 where not used)
+typedef struct {
+    int8_t nss;
+    int8_t reset;
+    int8_t dio0;
+    int8_t dio1;
+    int8_t busy;
+    int8_t powerEnable;
+} RadioPins;
+
+uint8_t platform_getRadioCount();                           // Radios fitted (at least 1)
+bool platform_getRadioPins(uint8_t index, RadioPins* pins); // False past the last radio
+
 // SPI configuration
 uint32_t platform_getSpiFrequency();  // Returns SPI frequency in Hz for this platform
 
+// Bulk SPI on the radio bus, inside the caller's SPI transaction (NSS is left
+// to the caller): `len` bytes out of `tx` (0x00 if null) and into `rx` (may be
+// null). RAK4631 runs each transfer as one SPIM EasyDMA job; other platforms
+// loop over SPI.transfer().
+void platform_spiTransfer(const uint8_t* tx, uint8_t* rx, uint16_t len);
+
+// Same transfer in the background: returns once it is running and calls
+// done(context) from platform_spiPoll() when it has finished (immediately on
+// platforms without DMA). False if a background transfer is already running.
+bool platform_spiStart(const uint8_t* tx, uint8_t* rx, uint16_t len, void (*done)(void* context), void* context);
+bool platform_spiPoll();  // Completes a finished background transfer; true while one is still running
+
 // SX126x-specific configuration (return 0.0/false if not applicable)
 float platform_getTcxoVoltage();      // TCXO voltage (e.g., 1.8 for RAK4631, 0.0 if no TCXO)
 bool platform_useDio2AsRfSwitch();    // True if DIO2 controls RF switch (SX126x only)
 bool platform_useRegulatorLDO();      // True if LDO regulator should be used (false = DC-DC)
+bool platform_useFastTurnaround();    // True to keep the oscillator running between RX and TX (STDBY_XOSC)
 
 #endif // PLATFORM_INTERFACE_H
@@ -7,7 +7,8 @@
 #include "variant.h"  // Pin definitions
 
 // SPI Settings - RAK4631 can handle higher SPI speeds
-#define SPI_FREQ 8000000   // 8 MHz SPI clock (SX1262 supports up to 8 MHz)
+#define SPI_FREQ 8000000   // 8 MHz SPI clock (SX1262 supports up to 16 MHz)
+#define RADIO_SPIM NRF_SPIM3  // SPIM instance behind the radio SPI object (bulk transfers use its EasyDMA; no TWI shares SPIM3)
 
 // Serial Configuration
 #define SERIAL_BAUD 115200
@@ -15,4 +16,16 @@
 // LED pin (from variant.h)
 #define LED_PIN PIN_LED1
 
+// Fast RX/TX turnaround: the SX1262 falls back to STDBY_XOSC after RX/TX and
+// stands by on XOSC, so the TCXO keeps running instead of restarting (RadioLib
+// allows it 5 ms) on every TX and protocol switch; image calibration runs once
+// per band. 0 restores STDBY_RC throughout (lower idle current).
+#define RADIO_FAST_TURNAROUND 1
+
+// Second SX1262 (optional): defining RADIO2_NSS_PIN together with
+// RADIO2_RESET_PIN, RADIO2_DIO1_PIN, RADIO2_BUSY_PIN and RADIO2_POWER_EN_PIN
+// (-1 if it shares the on-board radio's supply) gives each protocol its own
+// radio. The module must match the on-board one (TCXO, DIO2 RF switch).
+// Without it the on-board radio time-slices between protocols.
+
 #endif // RAK4631_CONFIG_H
@@ -10,6 +10,7 @@
 #include <Arduino.h>
 #include <SPI.h>
 #include "variant.h"
+#include "config.h"
 
 // Pin mapping array: maps Arduino pin number to nRF52840 GPIO pin
 // nRF52840 has 48 GPIO pins total
@@ -25,7 +26,7 @@ const uint32_t g_ADigitalPinMap[] = {
 // SPI object definition for nRF52 - using LoRa SPI pins!
 // SPIClass constructor: SPIClass(NRF_SPIM_Type *p_spi, uint8_t uc_pinMISO, uint8_t uc_pinSCK, uint8_t uc_pinMOSI)
 // RAK4631 LoRa SPI pins: MISO=45, SCK=43, MOSI=44 (from Meshtastic variant.h)
-// Using NRF_SPIM0 as the SPI peripheral
-SPIClass SPI(NRF_SPIM0, PIN_LORA_MISO, PIN_LORA_SCK, PIN_LORA_MOSI);
+// Using NRF_SPIM3 as the SPI peripheral (RADIO_SPIM - spi_dma.cpp drives its EasyDMA directly)
+SPIClass SPI(RADIO_SPIM, PIN_LORA_MISO, PIN_LORA_SCK, PIN_LORA_MOSI);
 
 #endif // RAK4631_BOARD
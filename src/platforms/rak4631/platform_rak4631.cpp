@@ -24,10 +24,23 @@ void platform_setLed(bool on) {
     digitalWrite(LED_PIN, on ? HIGH : LOW);
 }
 
+// Pending blink: LED is switched off by platform_updateLed() once it expires
+static bool ledBlinking = false;
+static unsigned long ledOnMs = 0;
+static uint16_t ledDurationMs = 0;
+
 void platform_blinkLed(uint16_t durationMs) {
     platform_setLed(true);
-    delay(durationMs);
-    platform_setLed(false);
+    ledBlinking = true;
+    ledOnMs = millis();
+    ledDurationMs = durationMs;
+}
+
+void platform_updateLed() {
+    if (ledBlinking && millis() - ledOnMs >= ledDurationMs) {
+        ledBlinking = false;
+        platform_setLed(false);
+    }
 }
 
 uint8_t platform_getMaxTxPower() {
@@ -67,6 +80,38 @@ int8_t platform_getRadioPowerEnablePin() {
     return SX126X_POWER_EN;  // Pin 37
 }
 
+uint8_t platform_getRadioCount() {
+#ifdef RADIO2_NSS_PIN
+    return 2;
+#else
+    return 1;
+#endif
+}
+
+bool platform_getRadioPins(uint8_t index, RadioPins* pins) {
+    if (index == 0) {
+        pins->nss = platform_getRadioNssPin();
+        pins->reset = platform_getRadioResetPin();
+        pins->dio0 = platform_getRadioDio0Pin();
+        pins->dio1 = platform_getRadioDio1Pin();
+        pins->busy = platform_getRadioBusyPin();
+        pins->powerEnable = platform_getRadioPowerEnablePin();
+        return true;
+    }
+#ifdef RADIO2_NSS_PIN
+    if (index == 1) {
+        pins->nss = RADIO2_NSS_PIN;
+        pins->reset = RADIO2_RESET_PIN;
+        pins->dio0 = -1;
+        pins->dio1 = RADIO2_DIO1_PIN;
+        pins->busy = RADIO2_BUSY_PIN;
+        pins->powerEnable = RADIO2_POWER_EN_PIN;
+        return true;
+    }
+#endif
+    return false;
+}
+
 uint32_t platform_getSpiFrequency() {
     return SPI_FREQ;  // 8 MHz for RAK4631
 }
@@ -83,3 +128,7 @@ bool platform_useDio2AsRfSwitch() {
 bool platform_useRegulatorLDO() {
     return false;  // RAK4631 uses DC-DC regulator (more efficient)
 }
+
+bool platform_useFastTurnaround() {
+    return RADIO_FAST_TURNAROUND != 0;
+}
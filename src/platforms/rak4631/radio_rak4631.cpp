@@ -2,116 +2,192 @@
  * Radio Implementation for RAK4631 Platform
  * 
  * This file implements the radio interface for RAK4631 by delegating to
- * the SX1262 RadioLib implementation.
+ * the SX1262 RadioLib implementation - one driver instance per fitted radio
+ * (platform_getRadioCount()), each call acts on the radio it is given.
  * 
  * This file is only compiled for RAK4631 builds (excluded for other platforms
  * via platformio.ini src_filter).
  */
 
+#include "../../config.h"
 #include "../../radio/radio_interface.h"
 #include "../../radio/sx1262_radiolib/sx1262_radiolib.h"
+#include "../platform_interface.h"
+
+static_assert(RADIO_MAX_COUNT <= SX1262_RADIOLIB_MAX_INSTANCES, "More radios than driver instances");
+
+// A radio is its driver instance - radio_get() hands out the address
+struct Radio {
+    Sx1262RadioLib dev;
+};
+
+static Radio radios[RADIO_MAX_COUNT];
+
+uint8_t radio_count() {
+    uint8_t fitted = platform_getRadioCount();
+    return fitted < RADIO_MAX_COUNT ? fitted : RADIO_MAX_COUNT;
+}
+
+Radio* radio_get(uint8_t index) {
+    return index < radio_count() ? &radios[index] : nullptr;
+}
 
 // Implement radio interface by delegating to SX1262 RadioLib implementation
-bool radio_init() { 
-    return sx1262_radiolib_init(); 
+bool radio_init(Radio* radio) { 
+    uint8_t index = (uint8_t)(radio - radios);
+    RadioPins pins;
+    if (!platform_getRadioPins(index, &pins)) {
+        return false;
+    }
+    return sx1262_radiolib_init(&radio->dev, index, &pins); 
 }
 
-uint32_t radio_getMinFrequency() {
+uint32_t radio_getMinFrequency(Radio* radio) {
+    (void)radio;
     return sx1262_radiolib_getMinFrequency();
 }
 
-uint32_t radio_getMaxFrequency() {
+uint32_t radio_getMaxFrequency(Radio* radio) {
+    (void)radio;
     return sx1262_radiolib_getMaxFrequency();
 }
 
-void radio_setFrequency(uint32_t freq_hz) { 
-    sx1262_radiolib_setFrequency(freq_hz); 
+void radio_setFrequency(Radio* radio, uint32_t freq_hz) { 
+    sx1262_radiolib_setFrequency(&radio->dev, freq_hz); 
+}
+
+void radio_setPower(Radio* radio, uint8_t power) { 
+    sx1262_radiolib_setPower(&radio->dev, power); 
+}
+
+void radio_setPreambleLength(Radio* radio, uint16_t length) { 
+    sx1262_radiolib_setPreambleLength(&radio->dev, length); 
+}
+
+void radio_setCrc(Radio* radio, bool enable) { 
+    sx1262_radiolib_setCrc(&radio->dev, enable); 
+}
+
+void radio_setSyncWord(Radio* radio, uint8_t syncWord) { 
+    sx1262_radiolib_setSyncWord(&radio->dev, syncWord); 
+}
+
+void radio_setHeaderMode(Radio* radio, bool implicit) { 
+    sx1262_radiolib_setHeaderMode(&radio->dev, implicit); 
+}
+
+void radio_setBandwidth(Radio* radio, uint8_t bw) { 
+    sx1262_radiolib_setBandwidth(&radio->dev, bw); 
+}
+
+void radio_setSpreadingFactor(Radio* radio, uint8_t sf) { 
+    sx1262_radiolib_setSpreadingFactor(&radio->dev, sf); 
+}
+
+void radio_setCodingRate(Radio* radio, uint8_t cr) { 
+    sx1262_radiolib_setCodingRate(&radio->dev, cr); 
+}
+
+void radio_setInvertIQ(Radio* radio, bool invert) { 
+    sx1262_radiolib_setInvertIQ(&radio->dev, invert); 
+}
+
+void radio_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    sx1262_radiolib_compileProfile(settings, profile);
+}
+
+void radio_applyProfile(Radio* radio, const RadioProfile* profile) {
+    sx1262_radiolib_applyProfile(&radio->dev, profile);
+}
+
+bool radio_benchmarkFifoRead(Radio* radio, SpiBenchmark* result) {
+    return sx1262_radiolib_benchmarkFifoRead(&radio->dev, result);
 }
 
-void radio_setPower(uint8_t power) { 
-    sx1262_radiolib_setPower(power); 
+void radio_poll() {
+    // RadioLib runs every command to completion - nothing runs in the background
 }
 
-void radio_setPreambleLength(uint16_t length) { 
-    sx1262_radiolib_setPreambleLength(length); 
+void radio_setMode(Radio* radio, uint8_t mode) { 
+    sx1262_radiolib_setMode(&radio->dev, mode); 
 }
 
-void radio_setCrc(bool enable) { 
-    sx1262_radiolib_setCrc(enable); 
+void radio_writeFifo(Radio* radio, uint8_t* data, uint8_t len) { 
+    sx1262_radiolib_writeFifo(&radio->dev, data, len); 
 }
 
-void radio_setSyncWord(uint8_t syncWord) { 
-    sx1262_radiolib_setSyncWord(syncWord); 
+bool radio_preloadTx(Radio* radio, const uint8_t* data, uint8_t len) {
+    return sx1262_radiolib_preloadTx(&radio->dev, data, len);
 }
 
-void radio_setHeaderMode(bool implicit) { 
-    sx1262_radiolib_setHeaderMode(implicit); 
+bool radio_armTxPreload(Radio* radio) {
+    return sx1262_radiolib_armTxPreload(&radio->dev);
 }
 
-void radio_setBandwidth(uint8_t bw) { 
-    sx1262_radiolib_setBandwidth(bw); 
+void radio_readFifo(Radio* radio, uint8_t* data, uint8_t len) { 
+    sx1262_radiolib_readFifo(&radio->dev, data, len); 
 }
 
-void radio_setSpreadingFactor(uint8_t sf) { 
-    sx1262_radiolib_setSpreadingFactor(sf); 
+bool radio_fetchFrame(Radio* radio, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    return sx1262_radiolib_fetchFrame(&radio->dev, data, maxLen, frame);
 }
 
-void radio_setCodingRate(uint8_t cr) { 
-    sx1262_radiolib_setCodingRate(cr); 
+int16_t radio_getRssi(Radio* radio) { 
+    return sx1262_radiolib_getRssi(&radio->dev); 
 }
 
-void radio_setInvertIQ(bool invert) { 
-    sx1262_radiolib_setInvertIQ(invert); 
+int8_t radio_getSnr(Radio* radio) { 
+    return sx1262_radiolib_getSnr(&radio->dev); 
 }
 
-void radio_setMode(uint8_t mode) { 
-    sx1262_radiolib_setMode(mode); 
+int16_t radio_getRssiInst(Radio* radio) { 
+    return sx1262_radiolib_getRssiInst(&radio->dev); 
 }
 
-void radio_writeFifo(uint8_t* data, uint8_t len) { 
-    sx1262_radiolib_writeFifo(data, len); 
+uint8_t radio_readRegister(Radio* radio, uint8_t reg) { 
+    return sx1262_radiolib_readRegister(&radio->dev, reg); 
 }
 
-void radio_readFifo(uint8_t* data, uint8_t len) { 
-    sx1262_radiolib_readFifo(data, len); 
+void radio_writeRegister(Radio* radio, uint8_t reg, uint8_t value) { 
+    sx1262_radiolib_writeRegister(&radio->dev, reg, value); 
 }
 
-int16_t radio_getRssi() { 
-    return sx1262_radiolib_getRssi(); 
+void radio_attachInterrupt(Radio* radio, void (*handler)()) { 
+    sx1262_radiolib_attachInterrupt(&radio->dev, handler); 
 }
 
-int8_t radio_getSnr() { 
-    return sx1262_radiolib_getSnr(); 
+bool radio_isPacketReceived(Radio* radio) { 
+    return sx1262_radiolib_isPacketReceived(&radio->dev); 
 }
 
-uint8_t radio_readRegister(uint8_t reg) { 
-    return sx1262_radiolib_readRegister(reg); 
+bool radio_isTransmitDone(Radio* radio) { 
+    return sx1262_radiolib_isTransmitDone(&radio->dev); 
 }
 
-void radio_writeRegister(uint8_t reg, uint8_t value) { 
-    sx1262_radiolib_writeRegister(reg, value); 
+bool radio_isCadDone(Radio* radio) { 
+    return sx1262_radiolib_isCadDone(&radio->dev); 
 }
 
-void radio_attachInterrupt(void (*handler)()) { 
-    sx1262_radiolib_attachInterrupt(handler); 
+bool radio_isChannelActive(Radio* radio) { 
+    return sx1262_radiolib_isChannelActive(&radio->dev); 
 }
 
-bool radio_isPacketReceived() { 
-    return sx1262_radiolib_isPacketReceived(); 
+bool radio_isReceiving(Radio* radio) { 
+    return sx1262_radiolib_isReceiving(&radio->dev); 
 }
 
-uint8_t radio_getPacketLength() { 
-    return sx1262_radiolib_getPacketLength(); 
+uint8_t radio_getPacketLength(Radio* radio) { 
+    return sx1262_radiolib_getPacketLength(&radio->dev); 
 }
 
-void radio_clearIrqFlags() { 
-    sx1262_radiolib_clearIrqFlags(); 
+void radio_clearIrqFlags(Radio* radio) { 
+    sx1262_radiolib_clearIrqFlags(&radio->dev); 
 }
 
-uint16_t radio_getIrqFlags() { 
-    return sx1262_radiolib_getIrqFlags(); 
+uint16_t radio_getIrqFlags(Radio* radio) { 
+    return sx1262_radiolib_getIrqFlags(&radio->dev); 
 }
 
-bool radio_hasPacketErrors() { 
-    return sx1262_radiolib_hasPacketErrors(); 
+bool radio_hasPacketErrors(Radio* radio) { 
+    return sx1262_radiolib_hasPacketErrors(&radio->dev); 
 }
@@ -0,0 +1,160 @@
+/**
+ * EasyDMA SPI Transfers for RAK4631 (nRF52840)
+ * 
+ * Bulk radio SPI transfers run as a single SPIM EasyDMA job instead of one
+ * SPI.transfer() call per byte, so a 255-byte FIFO read costs one job setup
+ * plus bus time. Jobs run on RADIO_SPIM (SPIM3, which no TWI instance
+ * shares - Wire stays usable), the peripheral behind the SPI object, between
+ * the caller's SPI.beginTransaction()/endTransaction() - the core's SPI
+ * driver is idle then and has left the peripheral enabled with our clock
+ * and mode.
+ * 
+ * Each job takes the peripheral from the core's driver (its interrupts
+ * masked, the SPIM3 TX workaround applied) and hands it back when it ends.
+ * Completion is polled on EVENTS_END; the interrupt belongs to the core.
+ * 
+ * This file is only compiled for RAK4631 builds.
+ */
+
+#ifdef RAK4631_BOARD
+
+#include "../platform_interface.h"
+#include "config.h"
+#include <Arduino.h>
+#include <SPI.h>
+
+static NRF_SPIM_Type* const spim = RADIO_SPIM;
+
+// Background transfer in flight (platform_spiStart)
+static bool running = false;
+static uint32_t savedInten = 0;     // Core driver's SPIM interrupts, restored on release
+static void (*doneCallback)(void* context) = nullptr;
+static void* doneContext = nullptr;
+
+// EasyDMA can only read from RAM; anything else (e.g. const tables in flash)
+// goes through the byte loop
+static bool inDataRam(const void* p) {
+    return ((uintptr_t)p & 0xE0000000UL) == 0x20000000UL;
+}
+
+static void byteLoop(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t in = SPI.transfer(tx != nullptr ? tx[i] : 0x00);
+        if (rx != nullptr) {
+            rx[i] = in;
+        }
+    }
+}
+
+// nRF52840 anomaly 198: SPIM3 can corrupt TX data while the CPU accesses the
+// RAM block the buffer is in. For the job, the buffer's blocks are reserved
+// for EasyDMA (same block mapping as the nrfx SPIM driver).
+#define ANOMALY_198_RAM_BLOCKS (*(volatile uint32_t*)0x40000E00UL)
+static uint32_t anomaly198Saved = 0;
+static bool anomaly198Active = false;
+
+static void anomaly198Enable(const uint8_t* tx, uint16_t len) {
+    uint32_t blockAddr = (uint32_t)(uintptr_t)tx & ~0x1FFFUL;
+    uint32_t endAddr = (uint32_t)(uintptr_t)tx + len;
+    uint32_t blocks = 0;
+    if (blockAddr >= 0x20010000UL) {
+        blocks = 1UL << 8;
+    } else {
+        uint32_t flag = 1UL << ((blockAddr >> 13) & 0xFF);
+        do {
+            blocks |= flag;
+            flag <<= 1;
+            blockAddr += 0x2000;
+        } while (blockAddr < endAddr && blockAddr < 0x20012000UL);
+    }
+    anomaly198Saved = ANOMALY_198_RAM_BLOCKS;
+    ANOMALY_198_RAM_BLOCKS = blocks;
+    anomaly198Active = true;
+}
+
+// Take the SPIM from the core's driver for one job
+static void takeSpim(const uint8_t* tx, uint16_t len) {
+    savedInten = spim->INTENSET;
+    spim->INTENCLR = savedInten;
+    if (spim == NRF_SPIM3 && tx != nullptr) {
+        anomaly198Enable(tx, len);
+    }
+}
+
+// Hand it back once the job has ended
+static void releaseSpim() {
+    spim->EVENTS_END = 0;
+    if (anomaly198Active) {
+        ANOMALY_198_RAM_BLOCKS = anomaly198Saved;
+        anomaly198Active = false;
+    }
+    spim->INTENSET = savedInten;
+}
+
+// A null buffer gets MAXCNT 0: the SPIM clocks out ORC / discards what it reads
+static void startJob(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    takeSpim(tx, len);
+    spim->ORC = 0x00;
+    spim->TXD.PTR = (uint32_t)(uintptr_t)tx;
+    spim->TXD.MAXCNT = (tx != nullptr) ? len : 0;
+    spim->RXD.PTR = (uint32_t)(uintptr_t)rx;
+    spim->RXD.MAXCNT = (rx != nullptr) ? len : 0;
+    spim->EVENTS_END = 0;
+    spim->TASKS_START = 1;
+}
+
+void platform_spiTransfer(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    if (len == 0) {
+        return;
+    }
+    if (tx != nullptr && !inDataRam(tx)) {
+        byteLoop(tx, rx, len);
+        return;
+    }
+    
+    // One job at a time on the peripheral
+    while (platform_spiPoll()) {
+    }
+    
+    startJob(tx, rx, len);
+    while (spim->EVENTS_END == 0) {
+    }
+    releaseSpim();
+}
+
+bool platform_spiStart(const uint8_t* tx, uint8_t* rx, uint16_t len, void (*done)(void* context), void* context) {
+    if (platform_spiPoll()) {
+        return false;
+    }
+    if (len == 0 || (tx != nullptr && !inDataRam(tx))) {
+        platform_spiTransfer(tx, rx, len);
+        if (done != nullptr) {
+            done(context);
+        }
+        return true;
+    }
+    
+    doneCallback = done;
+    doneContext = context;
+    running = true;
+    startJob(tx, rx, len);
+    return true;
+}
+
+bool platform_spiPoll() {
+    if (!running) {
+        return false;
+    }
+    if (spim->EVENTS_END == 0) {
+        return true;
+    }
+    
+    releaseSpim();
+    running = false;
+    if (doneCallback != nullptr) {
+        doneCallback(doneContext);
+    }
+    return false;
+}
+
+#endif // RAK4631_BOARD
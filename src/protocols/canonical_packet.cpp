@@ -9,7 +9,9 @@ void canonical_packet_init(CanonicalPacket* packet) {
     memset(packet, 0, sizeof(CanonicalPacket));
     packet->destinationAddress = 0xFFFFFFFF;  // Default to broadcast
     packet->messageType = CANONICAL_MSG_UNKNOWN;
+    packet->priority = CANONICAL_PRIORITY_BULK;
     packet->routeType = CANONICAL_ROUTE_BROADCAST;
+    packet->hopLimit = CANONICAL_HOP_LIMIT_UNKNOWN;
 }
 
 bool canonical_packet_isBroadcast(const CanonicalPacket* packet) {
@@ -42,3 +44,22 @@ bool canonical_packet_isValid(const CanonicalPacket* packet) {
     
     return true;
 }
+
+bool canonical_packet_canRelay(const CanonicalPacket* packet) {
+    if (packet == nullptr) {
+        return false;
+    }
+    return packet->hopLimit > 0;
+}
+
+void canonical_packet_consumeHop(CanonicalPacket* packet) {
+    if (packet == nullptr) {
+        return;
+    }
+    if (packet->hopLimit != CANONICAL_HOP_LIMIT_UNKNOWN && packet->hopLimit > 0) {
+        packet->hopLimit--;
+    }
+    if (packet->hopCount < 0xFF) {
+        packet->hopCount++;
+    }
+}
@@ -27,6 +27,22 @@ typedef enum {
     CANONICAL_MSG_UNKNOWN = 0xFF
 } CanonicalMessageType;
 
+// Relay priority classes, highest first. Set by each protocol's
+// convertToCanonical() from what it can tell about the frame; the TX side
+// sends higher classes first and sheds lower classes first when full.
+typedef enum {
+    CANONICAL_PRIORITY_TEXT = 0,       // Text messages and their ACKs
+    CANONICAL_PRIORITY_CONTROL = 1,    // Routing and control (requests, paths, traces)
+    CANONICAL_PRIORITY_TELEMETRY = 2,  // Adverts, position and telemetry broadcasts
+    CANONICAL_PRIORITY_BULK = 3,       // Unknown or raw
+    CANONICAL_PRIORITY_COUNT
+} CanonicalPriority;
+
+// Hop accounting, the same for every protocol: hopLimit is how many more
+// hops the frame may take as received, hopCount how many it has taken.
+// Relaying across the bridge is one hop (canonical_packet_consumeHop).
+#define CANONICAL_HOP_LIMIT_UNKNOWN 0xFF  // Protocol can't tell - always relayed
+
 // Routing types
 typedef enum {
     CANONICAL_ROUTE_BROADCAST = 0x00,
@@ -39,7 +55,8 @@ typedef enum {
 typedef struct {
     // Routing information
     CanonicalRouteType routeType;
-    uint8_t hopLimit;
+    uint8_t hopLimit;            // Hops left (CANONICAL_HOP_LIMIT_UNKNOWN if unknown)
+    uint8_t hopCount;            // Hops already taken
     bool wantAck;
     bool viaMqtt;  // Filter flag - packets with this set should be dropped
     
@@ -54,6 +71,7 @@ typedef struct {
     
     // Message content
     CanonicalMessageType messageType;
+    CanonicalPriority priority;
     uint16_t payloadLength;
     uint8_t payload[CANONICAL_MAX_PAYLOAD];
     
@@ -66,5 +84,9 @@ typedef struct {
 void canonical_packet_init(CanonicalPacket* packet);
 bool canonical_packet_isBroadcast(const CanonicalPacket* packet);
 bool canonical_packet_isValid(const CanonicalPacket* packet);
+// False once the frame has used up its hop budget
+bool canonical_packet_canRelay(const CanonicalPacket* packet);
+// Account for our own relay hop
+void canonical_packet_consumeHop(CanonicalPacket* packet);
 
 #endif // CANONICAL_PACKET_H
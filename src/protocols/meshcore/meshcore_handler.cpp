@@ -16,6 +16,22 @@ uint8_t meshcore_getPayloadType(uint8_t header) {
     return (header >> PH_TYPE_SHIFT) & PH_TYPE_MASK;
 }
 
+static bool meshcore_isDirect(uint8_t header) {
+    uint8_t routeType = meshcore_getRouteType(header);
+    return routeType == ROUTE_TYPE_DIRECT || routeType == ROUTE_TYPE_TRANSPORT_DIRECT;
+}
+
+uint8_t meshcore_getHopsTaken(const MeshCorePacket* packet) {
+    return meshcore_isDirect(packet->header) ? 0 : packet->path_len;
+}
+
+uint8_t meshcore_getHopsRemaining(const MeshCorePacket* packet) {
+    if (meshcore_isDirect(packet->header)) {
+        return packet->path_len;
+    }
+    return packet->path_len < MAX_MESHCORE_PATH_SIZE ? MAX_MESHCORE_PATH_SIZE - packet->path_len : 0;
+}
+
 bool meshcore_parsePacket(const uint8_t* data, uint8_t len, MeshCorePacket* packet) {
     if (data == NULL || packet == NULL || len == 0) {
         return false;
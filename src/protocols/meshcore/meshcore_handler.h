@@ -16,6 +16,20 @@
 #define ROUTE_TYPE_DIRECT            0x02
 #define ROUTE_TYPE_TRANSPORT_DIRECT  0x03
 
+// MeshCore payload types (header PH_TYPE bits)
+#define PAYLOAD_TYPE_REQ        0x00
+#define PAYLOAD_TYPE_RESPONSE   0x01
+#define PAYLOAD_TYPE_TXT_MSG    0x02
+#define PAYLOAD_TYPE_ACK        0x03
+#define PAYLOAD_TYPE_ADVERT     0x04
+#define PAYLOAD_TYPE_GRP_TXT    0x05
+#define PAYLOAD_TYPE_GRP_DATA   0x06
+#define PAYLOAD_TYPE_ANON_REQ   0x07
+#define PAYLOAD_TYPE_PATH       0x08
+#define PAYLOAD_TYPE_TRACE      0x09
+#define PAYLOAD_TYPE_MULTIPART  0x0A
+#define PAYLOAD_TYPE_RAW_CUSTOM 0x0F
+
 #define MAX_MESHCORE_PATH_SIZE 64
 #define MAX_MESHCORE_PAYLOAD_SIZE 184
 
@@ -46,5 +60,9 @@ bool meshcore_convertToMeshtastic(const MeshCorePacket* meshcore, uint8_t* outpu
 uint8_t meshcore_getRouteType(uint8_t header);
 uint8_t meshcore_getPayloadType(uint8_t header);
 bool meshcore_hasTransportCodes(uint8_t header);
+// Hop accounting: a flood path records the hops taken (up to
+// MAX_MESHCORE_PATH_SIZE), a direct path is the route still ahead
+uint8_t meshcore_getHopsTaken(const MeshCorePacket* packet);
+uint8_t meshcore_getHopsRemaining(const MeshCorePacket* packet);
 
 #endif // MESHCORE_HANDLER_H
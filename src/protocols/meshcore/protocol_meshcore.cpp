@@ -3,6 +3,7 @@
 #include "../canonical_packet.h"
 #include "../../radio/radio_interface.h"
 #include "../../usb_comm.h"
+#include "../../relay/dup_cache.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -40,21 +41,20 @@ static bool meshcore_handlePacket(const uint8_t* data, uint8_t len, ProtocolRunt
     return true;
 }
 
+// Radio profile compiled from the last configuration applied - rebuilt
+// only when that configuration changes
+static RadioProfile radioProfile;
+
 // MeshCore configuration
-static void meshcore_configure(const ProtocolConfig* config) {
-    radio_setMode(MODE_STDBY);
-    delay(10);
-    radio_setFrequency(config->frequencyHz);
-    radio_setBandwidth(config->bandwidth);
-    radio_setSpreadingFactor(config->spreadingFactor);
-    radio_setCodingRate(config->codingRate);
-    radio_setSyncWord(config->syncWord);
-    radio_setPreambleLength(config->preambleLength);
-    radio_setHeaderMode(config->implicitHeader);
-    radio_setInvertIQ(config->invertIQ);
-    radio_setCrc(config->crcEnabled);
-    delay(10);
-    radio_setMode(MODE_RX_CONTINUOUS);
+static void meshcore_configure(Radio* radio, const ProtocolConfig* config) {
+    if (!radio_profile_isCurrent(&radioProfile, config)) {
+        radio_compileProfile(config, &radioProfile);
+    }
+    
+    // Register writes take effect immediately in standby - no settling delays
+    radio_setMode(radio, MODE_STDBY);
+    radio_applyProfile(radio, &radioProfile);
+    radio_setMode(radio, MODE_RX_CONTINUOUS);
 }
 
 // Get max packet size
@@ -70,7 +70,100 @@ static bool meshcore_parsePacketWrapper(const uint8_t* data, uint8_t len, void*
     return meshcore_parsePacket(data, len, (MeshCorePacket*)packet);
 }
 
+// Offset of the payload in a raw frame (after transport codes and path)
+static bool meshcore_getPayloadOffset(const uint8_t* data, uint8_t len, uint8_t* offset) {
+    uint8_t i = 1;
+    if (meshcore_hasTransportCodes(data[0])) {
+        i += 4;
+    }
+    if (i >= len) {
+        return false;
+    }
+    uint8_t pathLen = data[i++];
+    // Same rule as meshcore_parsePacket: an oversized path length means no path
+    if (pathLen <= MAX_MESHCORE_PATH_SIZE) {
+        i += pathLen;
+    }
+    if (i >= len) {
+        return false;
+    }
+    *offset = i;
+    return true;
+}
+
+// Duplicate key: payload type + payload. Flood repeats append to the path,
+// so the path (and transport codes) are skipped, as MeshCore itself does.
+static bool meshcore_getDedupKey(const uint8_t* data, uint8_t len, uint32_t* key) {
+    if (data == nullptr || key == nullptr || len == 0) {
+        return false;
+    }
+    uint8_t i;
+    if (!meshcore_getPayloadOffset(data, len, &i)) {
+        return false;
+    }
+    
+    uint8_t payloadType = meshcore_getPayloadType(data[0]);
+    uint32_t hash = dup_cache_hash(DUP_CACHE_HASH_SEED, (const uint8_t*)"MC", 2);
+    hash = dup_cache_hash(hash, &payloadType, 1);
+    *key = dup_cache_hash(hash, &data[i], len - i);
+    return true;
+}
+
+// Source key: the sender's node hash (first byte of its public key).
+// Peer-to-peer payloads carry it after the destination hash; adverts and
+// anonymous requests carry the full public key. Group and ACK payloads do
+// not name their sender.
+static bool meshcore_getSourceKey(const uint8_t* data, uint8_t len, uint32_t* key) {
+    if (data == nullptr || key == nullptr || len == 0) {
+        return false;
+    }
+    uint8_t i;
+    if (!meshcore_getPayloadOffset(data, len, &i)) {
+        return false;
+    }
+    
+    switch (meshcore_getPayloadType(data[0])) {
+        case PAYLOAD_TYPE_REQ:
+        case PAYLOAD_TYPE_RESPONSE:
+        case PAYLOAD_TYPE_TXT_MSG:
+        case PAYLOAD_TYPE_PATH:
+        case PAYLOAD_TYPE_ANON_REQ:
+            i += 1;     // dest hash, then src hash / public key
+            break;
+        case PAYLOAD_TYPE_ADVERT:
+            break;      // public key first
+        default:
+            return false;
+    }
+    if (i >= len) {
+        return false;
+    }
+    *key = data[i];
+    return true;
+}
+
 // Convert MeshCore packet to canonical format
+// Relay priority class for a MeshCore payload type
+static CanonicalPriority meshcore_getPriority(uint8_t payloadType) {
+    switch (payloadType) {
+        case PAYLOAD_TYPE_TXT_MSG:
+        case PAYLOAD_TYPE_GRP_TXT:
+        case PAYLOAD_TYPE_ACK:
+            return CANONICAL_PRIORITY_TEXT;
+        case PAYLOAD_TYPE_REQ:
+        case PAYLOAD_TYPE_RESPONSE:
+        case PAYLOAD_TYPE_ANON_REQ:
+        case PAYLOAD_TYPE_PATH:
+        case PAYLOAD_TYPE_TRACE:
+            return CANONICAL_PRIORITY_CONTROL;
+        case PAYLOAD_TYPE_ADVERT:
+        case PAYLOAD_TYPE_GRP_DATA:
+            return CANONICAL_PRIORITY_TELEMETRY;
+        default:
+            return CANONICAL_PRIORITY_BULK;
+    }
+}
+
 static bool meshcore_convertToCanonical(const uint8_t* data, uint8_t len, CanonicalPacket* canonical) {
     if (data == nullptr || canonical == nullptr) {
         return false;
@@ -104,22 +197,23 @@ static bool meshcore_convertToCanonical(const uint8_t* data, uint8_t len, Canoni
     // Extract payload type
     uint8_t payloadType = meshcore_getPayloadType(meshcorePacket.header);
     switch (payloadType) {
-        case 0x02:
+        case PAYLOAD_TYPE_TXT_MSG:
             canonical->messageType = CANONICAL_MSG_TEXT;
             break;
-        case 0x05:
+        case PAYLOAD_TYPE_GRP_TXT:
             canonical->messageType = CANONICAL_MSG_GROUP_TEXT;
             break;
-        case 0x06:
+        case PAYLOAD_TYPE_GRP_DATA:
             canonical->messageType = CANONICAL_MSG_GROUP_DATA;
             break;
-        case 0x0F:
+        case PAYLOAD_TYPE_RAW_CUSTOM:
             canonical->messageType = CANONICAL_MSG_RAW;
             break;
         default:
             canonical->messageType = CANONICAL_MSG_DATA;
             break;
     }
+    canonical->priority = meshcore_getPriority(payloadType);
     
     // Extract version
     canonical->version = (meshcorePacket.header >> PH_VER_SHIFT) & PH_VER_MASK;
@@ -140,13 +234,14 @@ static bool meshcore_convertToCanonical(const uint8_t* data, uint8_t len, Canoni
     canonical->sourceAddress = 0;
     canonical->destinationAddress = 0xFFFFFFFF;  // Broadcast
     canonical->packetId = 0;
-    canonical->hopLimit = 3;  // Default
+    canonical->hopLimit = meshcore_getHopsRemaining(&meshcorePacket);
+    canonical->hopCount = meshcore_getHopsTaken(&meshcorePacket);
     
     return true;
 }
 
 // Convert canonical format to MeshCore packet
-static bool meshcore_convertFromCanonical(const CanonicalPacket* canonical, uint8_t* output, uint8_t* outputLen) {
+static bool meshcore_convertFromCanonical(const CanonicalPacket* canonical, uint8_t* output, uint8_t outputMax, uint8_t* outputLen) {
     if (canonical == nullptr || output == nullptr || outputLen == nullptr) {
         return false;
     }
@@ -155,6 +250,12 @@ static bool meshcore_convertFromCanonical(const CanonicalPacket* canonical, uint
         return false;
     }
     
+    // Header, path length, path, payload
+    uint16_t packetLen = 2 + canonical->pathLength + canonical->payloadLength;
+    if (packetLen > outputMax || packetLen > MAX_MESHCORE_PACKET_SIZE) {
+        return false;
+    }
+    
     // Build MeshCore packet
     uint8_t i = 0;
     
@@ -197,7 +298,9 @@ static bool meshcore_convertFromCanonical(const CanonicalPacket* canonical, uint
     uint8_t version = canonical->version & 0x03;
     output[i++] = routeType | (payloadType << PH_TYPE_SHIFT) | (version << PH_VER_SHIFT);
     
-    // Path length
+    // Path length. MeshCore has no hop budget field - a flood frame's hops
+    // are its path entries, and the bridge adds none (it has no MeshCore
+    // identity), so the hop limit was only enforced before relaying
     output[i++] = canonical->pathLength;
     
     // Path (if present)
@@ -226,6 +329,10 @@ static void meshcore_initState(ProtocolRuntimeState* state) {
     state->stats.txCount = 0;
     state->stats.parseErrors = 0;
     state->stats.conversionErrors = 0;
+    state->stats.txDeferred = 0;
+    state->stats.txBudgetDrops = 0;
+    state->stats.txAirtimeMs = 0;
+    state->stats.hopLimitDrops = 0;
     state->isActive = false;
     
     // Initialize config from protocol manager defaults
@@ -275,6 +382,8 @@ static ProtocolInterfaceImpl meshcoreInterface = {
     .getMaxPacketSize = meshcore_getMaxPacketSize,
     .parsePacket = meshcore_parsePacketWrapper,
     .handlePacket = meshcore_handlePacket,
+    .getDedupKey = meshcore_getDedupKey,
+    .getSourceKey = meshcore_getSourceKey,
     .convertToCanonical = meshcore_convertToCanonical,
     .convertFromCanonical = meshcore_convertFromCanonical,
     .initState = meshcore_initState,
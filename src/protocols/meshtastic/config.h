@@ -30,4 +30,7 @@
 #define MESHTASTIC_HEADER_SIZE 16
 #define MAX_MESHTASTIC_PAYLOAD_SIZE 237
 
+// Hop limit (3-bit hop_limit / hop_start header fields)
+#define MESHTASTIC_HOP_LIMIT_MAX 7
+
 #endif // MESHTASTIC_CONFIG_H
@@ -13,11 +13,7 @@
 #define PACKET_FLAGS_HOP_START_MASK 0xE0
 #define PACKET_FLAGS_HOP_START_SHIFT 5
 
-// MeshCore payload types
-#define PAYLOAD_TYPE_TXT_MSG 0x02
-#define PAYLOAD_TYPE_GRP_TXT 0x05
-#define PAYLOAD_TYPE_GRP_DATA 0x06
-#define PAYLOAD_TYPE_RAW_CUSTOM 0x0F
+// MeshCore payload types: see meshcore_handler.h
 
 // Function prototypes
 bool meshtastic_parsePacket(const uint8_t* data, uint8_t len, MeshtasticHeader* header, uint8_t* payload, uint8_t* payloadLen);
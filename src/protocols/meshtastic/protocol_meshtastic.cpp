@@ -3,6 +3,7 @@
 #include "../canonical_packet.h"
 #include "../../radio/radio_interface.h"
 #include "../../usb_comm.h"
+#include "../../relay/dup_cache.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -35,21 +36,20 @@ static bool meshtastic_handlePacket(const uint8_t* data, uint8_t len, ProtocolRu
     return true;
 }
 
+// Radio profile compiled from the last configuration applied - rebuilt
+// only when that configuration changes
+static RadioProfile radioProfile;
+
 // Meshtastic configuration
-static void meshtastic_configure(const ProtocolConfig* config) {
-    radio_setMode(MODE_STDBY);
-    delay(10);
-    radio_setFrequency(config->frequencyHz);
-    radio_setBandwidth(config->bandwidth);
-    radio_setSpreadingFactor(config->spreadingFactor);
-    radio_setCodingRate(config->codingRate);
-    radio_setSyncWord(config->syncWord);
-    radio_setPreambleLength(config->preambleLength);
-    radio_setHeaderMode(config->implicitHeader);
-    radio_setInvertIQ(config->invertIQ);
-    radio_setCrc(config->crcEnabled);
-    delay(10);
-    radio_setMode(MODE_RX_CONTINUOUS);
+static void meshtastic_configure(Radio* radio, const ProtocolConfig* config) {
+    if (!radio_profile_isCurrent(&radioProfile, config)) {
+        radio_compileProfile(config, &radioProfile);
+    }
+    
+    // Register writes take effect immediately in standby - no settling delays
+    radio_setMode(radio, MODE_STDBY);
+    radio_applyProfile(radio, &radioProfile);
+    radio_setMode(radio, MODE_RX_CONTINUOUS);
 }
 
 // Get max packet size
@@ -72,6 +72,32 @@ static bool meshtastic_parsePacketWrapper(const uint8_t* data, uint8_t len, void
     return true;
 }
 
+// Duplicate key: (from, id) from the header - rebroadcasts only change
+// flags/next_hop/relay_node. Frames too short for a header hash all bytes.
+static bool meshtastic_getDedupKey(const uint8_t* data, uint8_t len, uint32_t* key) {
+    if (data == nullptr || key == nullptr || len == 0) {
+        return false;
+    }
+    uint32_t hash = dup_cache_hash(DUP_CACHE_HASH_SEED, (const uint8_t*)"MT", 2);
+    if (len >= MESHTASTIC_HEADER_SIZE) {
+        hash = dup_cache_hash(hash, &data[4], 8);   // from (4 bytes) + id (4 bytes)
+    } else {
+        hash = dup_cache_hash(hash, data, len);
+    }
+    *key = hash;
+    return true;
+}
+
+// Source key: the `from` NodeNum from the header
+static bool meshtastic_getSourceKey(const uint8_t* data, uint8_t len, uint32_t* key) {
+    if (data == nullptr || key == nullptr || len < MESHTASTIC_HEADER_SIZE) {
+        return false;
+    }
+    *key = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+           ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+    return true;
+}
+
 // Convert Meshtastic packet to canonical format
 // ULTRA-LENIENT: Forward ANY packet bytes without ANY validation
 // This allows the proxy to relay ALL Meshtastic packets regardless of:
@@ -107,7 +133,19 @@ static bool meshtastic_convertToCanonical(const uint8_t* data, uint8_t len, Cano
     canonical->sourceAddress = 0;
     canonical->destinationAddress = 0xFFFFFFFF; // Assume broadcast
     canonical->packetId = 0;
-    canonical->hopLimit = 0;
+    if (len >= MESHTASTIC_HEADER_SIZE) {
+        // Addressing is at fixed offsets, little-endian: to, from, id
+        memcpy(&canonical->destinationAddress, &data[0], 4);
+        memcpy(&canonical->sourceAddress, &data[4], 4);
+        memcpy(&canonical->packetId, &data[8], 4);
+    }
+    if (len >= MESHTASTIC_HEADER_SIZE) {
+        // hop_limit counts down from hop_start at every rebroadcast
+        uint8_t hopLimit = data[12] & PACKET_FLAGS_HOP_LIMIT_MASK;
+        uint8_t hopStart = (data[12] & PACKET_FLAGS_HOP_START_MASK) >> PACKET_FLAGS_HOP_START_SHIFT;
+        canonical->hopLimit = hopLimit;
+        canonical->hopCount = hopStart > hopLimit ? hopStart - hopLimit : 0;
+    }
     canonical->wantAck = false;
     canonical->viaMqtt = false;
     canonical->channel = 0;
@@ -115,13 +153,25 @@ static bool meshtastic_convertToCanonical(const uint8_t* data, uint8_t len, Cano
     canonical->messageType = CANONICAL_MSG_DATA;
     canonical->version = 1;
     
+    // The payload is encrypted, so classify from the header: want_ack marks
+    // text (channel messages ask for implicit ACKs), unicast frames are DMs or
+    // the ACKs they trigger, plain broadcasts are position/telemetry/nodeinfo
+    if (len >= MESHTASTIC_HEADER_SIZE) {
+        bool wantAck = (data[12] & PACKET_FLAGS_WANT_ACK_MASK) != 0;
+        if (wantAck || canonical->destinationAddress != 0xFFFFFFFF) {
+            canonical->priority = CANONICAL_PRIORITY_TEXT;
+        } else {
+            canonical->priority = CANONICAL_PRIORITY_TELEMETRY;
+        }
+    }
+    
     return true;
 }
 
 // Convert canonical format to Meshtastic packet
 // SIMPLIFIED: Just copy raw packet bytes back (reverse of convertToCanonical)
 // This preserves the original Meshtastic packet structure
-static bool meshtastic_convertFromCanonical(const CanonicalPacket* canonical, uint8_t* output, uint8_t* outputLen) {
+static bool meshtastic_convertFromCanonical(const CanonicalPacket* canonical, uint8_t* output, uint8_t outputMax, uint8_t* outputLen) {
     if (canonical == nullptr || output == nullptr || outputLen == nullptr) {
         return false;
     }
@@ -132,13 +182,21 @@ static bool meshtastic_convertFromCanonical(const CanonicalPacket* canonical, ui
     
     // For Meshtastic relay: just copy the raw packet bytes back
     // The payload contains the original Meshtastic packet
-    if (canonical->payloadLength == 0 || canonical->payloadLength > MAX_MESHTASTIC_PACKET_SIZE) {
+    if (canonical->payloadLength == 0 || canonical->payloadLength > MAX_MESHTASTIC_PACKET_SIZE ||
+        canonical->payloadLength > outputMax) {
         return false;
     }
     
     memcpy(output, canonical->payload, canonical->payloadLength);
     *outputLen = canonical->payloadLength;
     
+    // Our relay is a rebroadcast: the frame goes out with the hop limit left
+    // after canonical_packet_consumeHop(), hop_start as heard
+    if (canonical->payloadLength >= MESHTASTIC_HEADER_SIZE && canonical->hopLimit != CANONICAL_HOP_LIMIT_UNKNOWN) {
+        uint8_t hopLimit = canonical->hopLimit > MESHTASTIC_HOP_LIMIT_MAX ? MESHTASTIC_HOP_LIMIT_MAX : canonical->hopLimit;
+        output[12] = (uint8_t)((output[12] & ~PACKET_FLAGS_HOP_LIMIT_MASK) | hopLimit);
+    }
+    
     return true;
 }
 
@@ -152,6 +210,10 @@ static void meshtastic_initState(ProtocolRuntimeState* state) {
     state->stats.txCount = 0;
     state->stats.parseErrors = 0;
     state->stats.conversionErrors = 0;
+    state->stats.txDeferred = 0;
+    state->stats.txBudgetDrops = 0;
+    state->stats.txAirtimeMs = 0;
+    state->stats.hopLimitDrops = 0;
     state->isActive = false;
     
     // Initialize config from protocol manager defaults
@@ -205,6 +267,8 @@ static ProtocolInterfaceImpl meshtasticInterface = {
     .getMaxPacketSize = meshtastic_getMaxPacketSize,
     .parsePacket = meshtastic_parsePacketWrapper,
     .handlePacket = meshtastic_handlePacket,
+    .getDedupKey = meshtastic_getDedupKey,
+    .getSourceKey = meshtastic_getSourceKey,
     .convertToCanonical = meshtastic_convertToCanonical,
     .convertFromCanonical = meshtastic_convertFromCanonical,
     .initState = meshtastic_initState,
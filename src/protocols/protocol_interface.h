@@ -19,6 +19,10 @@ typedef struct {
     uint32_t txCount;
     uint32_t parseErrors;
     uint32_t conversionErrors;
+    uint32_t txDeferred;        // Relays held back by the airtime budget
+    uint32_t txBudgetDrops;     // Relays dropped by the airtime budget
+    uint32_t txAirtimeMs;       // Time-on-air spent relaying onto this protocol
+    uint32_t hopLimitDrops;     // Received frames not relayed: hop budget used up
 } ProtocolStats;
 
 // Protocol runtime state (runtime state for a protocol instance)
@@ -37,20 +41,29 @@ typedef struct ProtocolInterfaceImpl {
     ProtocolId id;
     const char* name;
     
-    // Configuration
-    void (*configure)(const ProtocolConfig* config);
+    // Configuration (puts `radio` on the protocol's channel, listening)
+    void (*configure)(Radio* radio, const ProtocolConfig* config);
     uint8_t (*getMaxPacketSize)();
     
     // Packet handling
     bool (*parsePacket)(const uint8_t* data, uint8_t len, void* packet);
     bool (*handlePacket)(const uint8_t* data, uint8_t len, ProtocolRuntimeState* state, uint8_t* output, uint8_t* outputLen);
     
+    // Duplicate suppression key, read straight from the raw frame.
+    // Copies of the same logical packet must map to the same key.
+    bool (*getDedupKey)(const uint8_t* data, uint8_t len, uint32_t* key);
+    
+    // Originating node, read straight from the raw frame (per-source rate
+    // limiting). Returns false if the frame does not name its sender.
+    bool (*getSourceKey)(const uint8_t* data, uint8_t len, uint32_t* key);
+    
     // Conversion to/from canonical format
     // Convert FROM this protocol TO canonical format (when receiving)
     bool (*convertToCanonical)(const uint8_t* data, uint8_t len, CanonicalPacket* canonical);
     
-    // Convert FROM canonical format TO this protocol (when transmitting)
-    bool (*convertFromCanonical)(const CanonicalPacket* canonical, uint8_t* output, uint8_t* outputLen);
+    // Convert FROM canonical format TO this protocol (when transmitting);
+    // fails if the frame would not fit in outputMax bytes
+    bool (*convertFromCanonical)(const CanonicalPacket* canonical, uint8_t* output, uint8_t outputMax, uint8_t* outputLen);
     
     // State management
     void (*initState)(ProtocolRuntimeState* state);
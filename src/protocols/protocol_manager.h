@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../radio/radio_profile.h"
+#include "../radio/radio_interface.h"
 
 /**
  * Protocol Manager Interface
@@ -18,24 +20,14 @@ typedef enum {
     PROTOCOL_COUNT = 2
 } ProtocolId;
 
-// Protocol configuration structure
-typedef struct {
-    uint32_t frequencyHz;
-    uint8_t bandwidth;
-    uint8_t spreadingFactor;
-    uint8_t codingRate;
-    uint8_t syncWord;
-    uint16_t preambleLength;
-    bool implicitHeader;
-    bool invertIQ;
-    bool crcEnabled;
-} ProtocolConfig;
+// Protocol configuration structure: the radio settings the protocol runs with
+typedef RadioSettings ProtocolConfig;
 
 // Protocol interface - each protocol implements these functions
 typedef struct {
     ProtocolId id;
     const char* name;
-    void (*configure)(const ProtocolConfig* config);
+    void (*configure)(Radio* radio, const ProtocolConfig* config);
     uint8_t (*getMaxPacketSize)();
     bool (*parsePacket)(const uint8_t* data, uint8_t len, void* packet);
     bool (*convertToOther)(const void* packet, uint8_t* output, uint8_t* outputLen);
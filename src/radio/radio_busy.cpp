@@ -0,0 +1,40 @@
+#include "radio_busy.h"
+
+static RadioBusyStats stats;
+static volatile bool faulted = false;
+
+void radio_busy_recordWait(uint32_t elapsedUs) {
+    stats.waits++;
+    stats.waitUs += elapsedUs;
+    if (elapsedUs > stats.maxWaitUs) {
+        stats.maxWaitUs = elapsedUs;
+    }
+}
+
+void radio_busy_raiseFault() {
+    stats.timeouts++;
+    faulted = true;
+}
+
+bool radio_busy_hasFault() {
+    return faulted;
+}
+
+void radio_busy_clearFault() {
+    if (faulted) {
+        stats.recoveries++;
+        faulted = false;
+    }
+}
+
+const RadioBusyStats* radio_busy_getStats() {
+    return &stats;
+}
+
+void radio_busy_resetStats() {
+    stats.waits = 0;
+    stats.waitUs = 0;
+    stats.maxWaitUs = 0;
+    stats.timeouts = 0;
+    stats.recoveries = 0;
+}
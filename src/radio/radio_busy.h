@@ -0,0 +1,38 @@
+#ifndef RADIO_BUSY_H
+#define RADIO_BUSY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Radio BUSY Line Accounting and Faults
+ * 
+ * The SX126x holds BUSY high while it processes a command; the host must not
+ * start the next one until it drops. Drivers report every wait here, and a
+ * wait that outlasts its timeout raises a radio fault instead of hanging the
+ * firmware. The main loop clears the fault by reinitializing the radio.
+ */
+
+// Longest a command may keep BUSY high (calibration takes ~3.5 ms)
+#define RADIO_BUSY_TIMEOUT_US 20000UL
+
+typedef struct {
+    uint32_t waits;         // BUSY waits (one per command)
+    uint32_t waitUs;        // Total time BUSY was high
+    uint32_t maxWaitUs;
+    uint32_t timeouts;      // Waits that hit their timeout (each raised a fault)
+    uint32_t recoveries;    // Faults cleared by reinitializing the radio
+} RadioBusyStats;
+
+// Drivers report how long BUSY stayed high
+void radio_busy_recordWait(uint32_t elapsedUs);
+
+// A command timed out - counted and latched until radio_busy_clearFault()
+void radio_busy_raiseFault();
+bool radio_busy_hasFault();
+void radio_busy_clearFault();
+
+const RadioBusyStats* radio_busy_getStats();
+void radio_busy_resetStats();
+
+#endif // RADIO_BUSY_H
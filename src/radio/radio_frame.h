@@ -0,0 +1,26 @@
+#ifndef RADIO_FRAME_H
+#define RADIO_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Completed Frame Readout
+ * 
+ * After RX_DONE the RX path needs the IRQ status, the payload length and
+ * position, the packet RSSI/SNR, the payload itself and an IRQ clear. Asked
+ * for one getter at a time that is a separate SPI transaction (and on the
+ * SX126x a separate BUSY wait) each, several of them repeated. Each driver's
+ * fetchFrame() collects it all once, in as few transactions as the chip
+ * allows, and returns it in one descriptor.
+ */
+
+typedef struct {
+    uint8_t length;         // Payload bytes copied (0: reported length invalid or too long)
+    uint8_t rxLength;       // Payload length the radio reported
+    int16_t rssi;           // Packet RSSI, dBm
+    int8_t snr;             // Packet SNR, dB
+    bool crcError;          // CRC (or SX126x header) error flagged with RX_DONE
+} RadioFrame;
+
+#endif // RADIO_FRAME_H
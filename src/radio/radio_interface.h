@@ -3,6 +3,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "radio_profile.h"
+#include "radio_busy.h"
+#include "radio_turnaround.h"
+#include "spi_bench.h"
+#include "radio_frame.h"
 
 /**
  * Radio Interface
@@ -13,6 +18,11 @@
  * 
  * Each platform (SX1276, SX1262, etc.) implements these functions
  * according to their hardware capabilities.
+ * 
+ * A platform may fit more than one radio. Every call that touches a radio
+ * takes it as the first argument (a handle from radio_get()), so code working
+ * one radio never redirects another caller's. Each platform defines what a
+ * Radio holds - the driver instance of its chip.
  */
 
 // ============================================================================
@@ -24,6 +34,7 @@
 #define MODE_STDBY               0x01
 #define MODE_TX                  0x03
 #define MODE_RX_CONTINUOUS       0x05
+#define MODE_CAD                 0x07    // Single channel activity detection, then standby
 
 // Note: Platform-specific mode constants (like MODE_LONG_RANGE_MODE for SX1276)
 // are defined in their respective radio implementation headers
@@ -34,165 +45,274 @@
 // All platforms must implement these functions. The interface layer routes
 // calls to the appropriate platform-specific implementation.
 
+// One radio driven by the platform (layout private to the platform)
+typedef struct Radio Radio;
+
+/**
+ * Number of radios this build drives (at least 1, at most RADIO_MAX_COUNT)
+ */
+uint8_t radio_count();
+
 /**
- * Initialize the radio hardware
+ * Radio `index` (0 .. radio_count() - 1)
+ * @return nullptr if there is no such radio
+ */
+Radio* radio_get(uint8_t index);
+
+/**
+ * Initialize a radio's hardware (pins from platform_getRadioPins())
+ * @param radio Radio from radio_get()
  * @return true if initialization successful, false otherwise
  */
-bool radio_init();
+bool radio_init(Radio* radio);
 
 /**
  * Get minimum supported frequency
  * @return Minimum frequency in Hz
  */
-uint32_t radio_getMinFrequency();
+uint32_t radio_getMinFrequency(Radio* radio);
 
 /**
  * Get maximum supported frequency
  * @return Maximum frequency in Hz
  */
-uint32_t radio_getMaxFrequency();
+uint32_t radio_getMaxFrequency(Radio* radio);
 
 /**
  * Configure radio frequency
  * @param freq_hz Frequency in Hz
  */
-void radio_setFrequency(uint32_t freq_hz);
+void radio_setFrequency(Radio* radio, uint32_t freq_hz);
 
 /**
  * Set transmit power
  * @param power Power level (platform-specific range, typically 0-22 dBm)
  */
-void radio_setPower(uint8_t power);
+void radio_setPower(Radio* radio, uint8_t power);
 
 /**
  * Set preamble length
  * @param length Preamble length in symbols
  */
-void radio_setPreambleLength(uint16_t length);
+void radio_setPreambleLength(Radio* radio, uint16_t length);
 
 /**
  * Enable or disable CRC
  * @param enable true to enable CRC, false to disable
  */
-void radio_setCrc(bool enable);
+void radio_setCrc(Radio* radio, bool enable);
 
 /**
  * Set sync word
  * @param syncWord Sync word value (8-bit)
  */
-void radio_setSyncWord(uint8_t syncWord);
+void radio_setSyncWord(Radio* radio, uint8_t syncWord);
 
 /**
  * Set header mode
  * @param implicit true for implicit header mode, false for explicit
  */
-void radio_setHeaderMode(bool implicit);
+void radio_setHeaderMode(Radio* radio, bool implicit);
 
 /**
  * Set bandwidth
  * @param bw Bandwidth code (platform-specific encoding)
  */
-void radio_setBandwidth(uint8_t bw);
+void radio_setBandwidth(Radio* radio, uint8_t bw);
 
 /**
  * Set spreading factor
  * @param sf Spreading factor (typically 6-12)
  */
-void radio_setSpreadingFactor(uint8_t sf);
+void radio_setSpreadingFactor(Radio* radio, uint8_t sf);
 
 /**
  * Set coding rate
  * @param cr Coding rate (typically 5-8)
  */
-void radio_setCodingRate(uint8_t cr);
+void radio_setCodingRate(Radio* radio, uint8_t cr);
 
 /**
  * Set IQ inversion
  * @param invert true to invert IQ, false for normal
  */
-void radio_setInvertIQ(bool invert);
+void radio_setInvertIQ(Radio* radio, bool invert);
+
+/**
+ * Precompute everything needed to apply a set of modem settings
+ * (no SPI traffic - may be called before radio_init(); the profile can be
+ * applied to any of the platform's radios)
+ * @param settings Modem settings (frequency, bandwidth, SF, CR, sync word, preamble, header, IQ, CRC)
+ * @param profile Profile to fill in
+ */
+void radio_compileProfile(const RadioSettings* settings, RadioProfile* profile);
+
+/**
+ * Apply a compiled profile - same result as calling every setter with its settings.
+ * Call in standby; parameters that already match the radio are not re-sent.
+ * @param profile Profile filled in by radio_compileProfile()
+ */
+void radio_applyProfile(Radio* radio, const RadioProfile* profile);
 
 /**
  * Set operating mode
- * @param mode One of MODE_SLEEP, MODE_STDBY, MODE_TX, MODE_RX_CONTINUOUS
+ * @param mode One of MODE_SLEEP, MODE_STDBY, MODE_TX, MODE_RX_CONTINUOUS, MODE_CAD
  */
-void radio_setMode(uint8_t mode);
+void radio_setMode(Radio* radio, uint8_t mode);
 
 /**
  * Write data to FIFO for transmission
  * @param data Pointer to data buffer
  * @param len Number of bytes to write
  */
-void radio_writeFifo(uint8_t* data, uint8_t len);
+void radio_writeFifo(Radio* radio, uint8_t* data, uint8_t len);
+
+/**
+ * Upload the next frame to transmit into the TX region at the top of the
+ * radio buffer without leaving RX - the receiver writes from the bottom.
+ * Don't call while a frame is arriving. A reception that reaches into the
+ * region invalidates the preload.
+ * @param data Frame to send (copied to the radio)
+ * @param len Frame length
+ * @return false if the preload could not be written
+ */
+bool radio_preloadTx(Radio* radio, const uint8_t* data, uint8_t len);
+
+/**
+ * Arm the preloaded frame for the next radio_setMode(MODE_TX), in place of
+ * radio_writeFifo(). Call in standby, configured for the target protocol.
+ * A preload is armed at most once.
+ * @return false if there is no intact preload - upload with radio_writeFifo()
+ */
+bool radio_armTxPreload(Radio* radio);
 
 /**
  * Read data from FIFO after reception
  * @param data Pointer to buffer to store received data
  * @param len Maximum number of bytes to read
  */
-void radio_readFifo(uint8_t* data, uint8_t len);
+void radio_readFifo(Radio* radio, uint8_t* data, uint8_t len);
+
+/**
+ * Read out a completed frame in one call: IRQ status, length, packet RSSI/SNR,
+ * the payload, then clear the IRQs (see radio_frame.h). The radio stays in
+ * whatever mode it was in.
+ * @param data Buffer for the payload
+ * @param maxLen Longest payload accepted; a longer frame is not copied
+ * @param frame Filled in with the frame's length, RSSI, SNR and CRC status
+ * @return false if RX_DONE was not set (nothing read, nothing cleared)
+ */
+bool radio_fetchFrame(Radio* radio, uint8_t* data, uint8_t maxLen, RadioFrame* frame);
 
 /**
  * Get received signal strength indicator
  * @return RSSI in dBm
  */
-int16_t radio_getRssi();
+int16_t radio_getRssi(Radio* radio);
 
 /**
  * Get signal-to-noise ratio
  * @return SNR in dB
  */
-int8_t radio_getSnr();
+int8_t radio_getSnr(Radio* radio);
+
+/**
+ * Get the instantaneous RSSI of the channel (while in RX, between frames)
+ * @return RSSI in dBm, same scale as radio_getRssi()
+ */
+int16_t radio_getRssiInst(Radio* radio);
 
 /**
  * Read a register value (platform-specific, may not be meaningful for all platforms)
  * @param reg Register address
  * @return Register value
  */
-uint8_t radio_readRegister(uint8_t reg);
+uint8_t radio_readRegister(Radio* radio, uint8_t reg);
 
 /**
  * Write a register value (platform-specific, may not be meaningful for all platforms)
  * @param reg Register address
  * @param value Value to write
  */
-void radio_writeRegister(uint8_t reg, uint8_t value);
+void radio_writeRegister(Radio* radio, uint8_t reg, uint8_t value);
 
 /**
- * Attach interrupt handler for packet events
+ * Time a full-length FIFO read over the per-byte SPI path and the bulk (DMA)
+ * path, and the readout of the buffered frame per getter vs fetchFrame() -
+ * see spi_bench.h. Blocks for a few milliseconds.
+ * @param result Filled in with per-read timings
+ * @return false if the radio or platform doesn't support it
+ */
+bool radio_benchmarkFifoRead(Radio* radio, SpiBenchmark* result);
+
+/**
+ * Advance background work of every radio (the SX1262 command queue): finish
+ * transfers, check command timeouts and report completed batches. Call every
+ * loop; a timeout shows up as radio_busy_hasFault().
+ */
+void radio_poll();
+
+/**
+ * Attach interrupt handler for packet events of the radio
  * @param handler Function pointer to interrupt handler
  */
-void radio_attachInterrupt(void (*handler)());
+void radio_attachInterrupt(Radio* radio, void (*handler)());
 
 /**
  * Check if a packet has been received
  * @return true if packet received, false otherwise
  */
-bool radio_isPacketReceived();
+bool radio_isPacketReceived(Radio* radio);
+
+/**
+ * Check if the last transmission has completed (TX_DONE IRQ set)
+ * @return true if TX_DONE is flagged, false otherwise
+ */
+bool radio_isTransmitDone(Radio* radio);
+
+/**
+ * Check if a channel activity detection started with MODE_CAD has finished
+ * @return true if CAD_DONE is flagged, false otherwise
+ */
+bool radio_isCadDone(Radio* radio);
+
+/**
+ * Check whether the finished CAD detected LoRa activity on the channel
+ * Only meaningful once radio_isCadDone() returns true
+ * @return true if CAD_DETECTED is flagged (channel busy), false if clear
+ */
+bool radio_isChannelActive(Radio* radio);
+
+/**
+ * Check whether a frame is currently being received in RX mode
+ * (preamble locked or header validated, RX_DONE not yet raised)
+ * @return true if leaving RX now would cut off an incoming frame
+ */
+bool radio_isReceiving(Radio* radio);
 
 /**
  * Get length of received packet
  * @return Packet length in bytes
  */
-uint8_t radio_getPacketLength();
+uint8_t radio_getPacketLength(Radio* radio);
 
 /**
  * Clear interrupt flags
  */
-void radio_clearIrqFlags();
+void radio_clearIrqFlags(Radio* radio);
 
 /**
  * Get IRQ status flags
  * @return 16-bit IRQ status flags
  */
-uint16_t radio_getIrqFlags();
+uint16_t radio_getIrqFlags(Radio* radio);
 
 /**
  * Check if received packet has CRC or header errors
  * Should be called after radio_isPacketReceived() returns true
  * @return true if packet has errors and should be rejected, false if valid
  */
-bool radio_hasPacketErrors();
+bool radio_hasPacketErrors(Radio* radio);
 
 // ============================================================================
 // Compatibility Macros (for legacy code using sx1276_* naming)
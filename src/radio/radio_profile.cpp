@@ -0,0 +1,31 @@
+#include "radio_profile.h"
+
+static TimingStats stats;
+
+bool radio_profile_isCurrent(const RadioProfile* profile, const RadioSettings* settings) {
+    if (!profile->compiled) {
+        return false;
+    }
+    const RadioSettings* compiled = &profile->settings;
+    return compiled->frequencyHz == settings->frequencyHz &&
+           compiled->bandwidth == settings->bandwidth &&
+           compiled->spreadingFactor == settings->spreadingFactor &&
+           compiled->codingRate == settings->codingRate &&
+           compiled->syncWord == settings->syncWord &&
+           compiled->preambleLength == settings->preambleLength &&
+           compiled->implicitHeader == settings->implicitHeader &&
+           compiled->invertIQ == settings->invertIQ &&
+           compiled->crcEnabled == settings->crcEnabled;
+}
+
+void radio_profile_recordSwitch(uint32_t elapsedUs) {
+    timing_stats_record(&stats, elapsedUs);
+}
+
+const TimingStats* radio_profile_getStats() {
+    return &stats;
+}
+
+void radio_profile_resetStats() {
+    timing_stats_reset(&stats);
+}
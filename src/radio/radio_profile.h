@@ -0,0 +1,51 @@
+#ifndef RADIO_PROFILE_H
+#define RADIO_PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../timing_stats.h"
+
+/**
+ * Precompiled Radio Profiles
+ * 
+ * A protocol's modem settings rarely change, yet they are applied on every
+ * protocol switch. radio_compileProfile() turns them into exactly what the
+ * driver sends (SX1276: a register image written in bursts, SX1262: encoded
+ * command payloads) once per configuration change, and radio_applyProfile()
+ * then switches the radio in a single call with no frequency or bandwidth
+ * arithmetic on the way.
+ */
+
+// Modem settings of one protocol (the values of the individual radio_set*() calls)
+typedef struct {
+    uint32_t frequencyHz;
+    uint8_t bandwidth;
+    uint8_t spreadingFactor;
+    uint8_t codingRate;
+    uint8_t syncWord;
+    uint16_t preambleLength;
+    bool implicitHeader;
+    bool invertIQ;
+    bool crcEnabled;
+} RadioSettings;
+
+// Room for the largest driver image (SX1262 command payloads, 17 bytes)
+#define RADIO_PROFILE_IMAGE_WORDS 5
+
+typedef struct {
+    RadioSettings settings;                     // Settings the image was compiled from
+    uint32_t image[RADIO_PROFILE_IMAGE_WORDS];  // Driver-specific layout (word aligned)
+    bool compiled;
+} RadioProfile;
+
+// True if `profile` was compiled from exactly these settings
+bool radio_profile_isCurrent(const RadioProfile* profile, const RadioSettings* settings);
+
+// Drivers report how long one radio_applyProfile() took
+void radio_profile_recordSwitch(uint32_t elapsedUs);
+
+// Profile switches, timed inside the driver
+const TimingStats* radio_profile_getStats();
+void radio_profile_resetStats();
+
+#endif // RADIO_PROFILE_H
@@ -0,0 +1,39 @@
+#include "radio_shadow.h"
+
+static RadioShadowStats stats;
+
+void radio_shadow_invalidate(RadioShadow* shadow) {
+    shadow->valid = 0;
+}
+
+bool radio_shadow_update(RadioShadow* shadow, RadioParam param, uint32_t value) {
+    uint16_t bit = (uint16_t)(1u << param);
+    if ((shadow->valid & bit) && shadow->value[param] == value) {
+        stats.skipped++;
+        return false;
+    }
+    shadow->value[param] = value;
+    shadow->valid |= bit;
+    stats.applied++;
+    return true;
+}
+
+void radio_shadow_forget(RadioShadow* shadow, RadioParam param) {
+    shadow->valid &= (uint16_t)~(1u << param);
+}
+
+uint32_t radio_shadow_get(const RadioShadow* shadow, RadioParam param, uint32_t fallback) {
+    if (shadow->valid & (1u << param)) {
+        return shadow->value[param];
+    }
+    return fallback;
+}
+
+const RadioShadowStats* radio_shadow_getStats() {
+    return &stats;
+}
+
+void radio_shadow_resetStats() {
+    stats.applied = 0;
+    stats.skipped = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef RADIO_SHADOW_H
+#define RADIO_SHADOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Radio Configuration Shadow
+ * 
+ * Each driver keeps a copy of the modem parameters it last applied to the
+ * chip. A setter asks radio_shadow_update() whether its value differs and
+ * only then talks to the radio, so switching protocols sends just the
+ * parameters that differ between the two configurations. Registers that pack
+ * several parameters are rebuilt from the shadow instead of read back.
+ * 
+ * A shadow starts invalid: after init every parameter is written once.
+ */
+
+typedef enum {
+    RADIO_PARAM_FREQUENCY = 0,
+    RADIO_PARAM_BANDWIDTH,
+    RADIO_PARAM_SPREADING_FACTOR,
+    RADIO_PARAM_CODING_RATE,
+    RADIO_PARAM_SYNC_WORD,
+    RADIO_PARAM_PREAMBLE,
+    RADIO_PARAM_HEADER_MODE,
+    RADIO_PARAM_INVERT_IQ,
+    RADIO_PARAM_CRC,
+    RADIO_PARAM_POWER,
+    RADIO_PARAM_COUNT
+} RadioParam;
+
+typedef struct {
+    uint32_t value[RADIO_PARAM_COUNT];
+    uint16_t valid;         // Bit per RadioParam: value matches the chip
+} RadioShadow;
+
+// Setter calls across all drivers
+typedef struct {
+    uint32_t applied;       // Parameter changed - written to the radio
+    uint32_t skipped;       // Parameter unchanged - radio not touched
+} RadioShadowStats;
+
+// Forget everything (after reset/init, or when the chip state is unknown)
+void radio_shadow_invalidate(RadioShadow* shadow);
+
+// Record `value` for `param`; true if it differs from the chip (write it)
+bool radio_shadow_update(RadioShadow* shadow, RadioParam param, uint32_t value);
+
+// Drop one parameter (its write failed, so the chip value is unknown)
+void radio_shadow_forget(RadioShadow* shadow, RadioParam param);
+
+// Shadowed value of `param`, or `fallback` (e.g. the reset default) if not known
+uint32_t radio_shadow_get(const RadioShadow* shadow, RadioParam param, uint32_t fallback);
+
+const RadioShadowStats* radio_shadow_getStats();
+void radio_shadow_resetStats();
+
+#endif // RADIO_SHADOW_H
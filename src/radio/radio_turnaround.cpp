@@ -0,0 +1,34 @@
+#include "radio_turnaround.h"
+
+static RadioTurnaroundStats stats;
+
+void radio_turnaround_setFastMode(bool enabled) {
+    stats.fastMode = enabled;
+}
+
+void radio_turnaround_recordRxToTx(uint32_t elapsedUs) {
+    timing_stats_record(&stats.rxToTx, elapsedUs);
+}
+
+void radio_turnaround_recordTxToRx(uint32_t elapsedUs) {
+    timing_stats_record(&stats.txToRx, elapsedUs);
+}
+
+void radio_turnaround_recordCalibration(bool performed) {
+    if (performed) {
+        stats.imageCalibrations++;
+    } else {
+        stats.imageCalibrationsSkipped++;
+    }
+}
+
+const RadioTurnaroundStats* radio_turnaround_getStats() {
+    return &stats;
+}
+
+void radio_turnaround_resetStats() {
+    stats.imageCalibrations = 0;
+    stats.imageCalibrationsSkipped = 0;
+    timing_stats_reset(&stats.rxToTx);
+    timing_stats_reset(&stats.txToRx);
+}
@@ -0,0 +1,41 @@
+#ifndef RADIO_TURNAROUND_H
+#define RADIO_TURNAROUND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../timing_stats.h"
+
+/**
+ * Radio RX/TX Turnaround Accounting
+ * 
+ * How long a radio takes to get from receiving to transmitting and back:
+ * 
+ *   RX -> TX: the radio stops listening (RX or the last LBT CAD) until SetTx
+ *             has been accepted (BUSY low, PA ramped)
+ *   TX -> RX: TX_DONE interrupt until the radio is back in RX, including a
+ *             protocol reconfiguration in between
+ * 
+ * In fast turnaround mode (SX126x) the oscillator keeps running between the
+ * two and the image calibration is done once per band; drivers report both
+ * the turnarounds and the calibrations they ran or skipped.
+ */
+
+typedef struct {
+    bool fastMode;                      // Driver runs the fast turnaround mode
+    uint32_t imageCalibrations;         // Image calibrations run
+    uint32_t imageCalibrationsSkipped;  // Frequency changes within the calibrated band
+    TimingStats rxToTx;
+    TimingStats txToRx;
+} RadioTurnaroundStats;
+
+void radio_turnaround_setFastMode(bool enabled);
+
+// Drivers report each turnaround and frequency change
+void radio_turnaround_recordRxToTx(uint32_t elapsedUs);
+void radio_turnaround_recordTxToRx(uint32_t elapsedUs);
+void radio_turnaround_recordCalibration(bool performed);
+
+const RadioTurnaroundStats* radio_turnaround_getStats();
+void radio_turnaround_resetStats();
+
+#endif // RADIO_TURNAROUND_H
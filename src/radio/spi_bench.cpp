@@ -0,0 +1,83 @@
+#include "spi_bench.h"
+#include "../platforms/platform_interface.h"
+#include <Arduino.h>
+#include <SPI.h>
+#include <string.h>
+
+static volatile bool backgroundDone = false;
+
+static void onBackgroundDone(void* context) {
+    (void)context;
+    backgroundDone = true;
+}
+
+static void selectRadio(int8_t nss, int8_t busy, uint32_t spiFreq) {
+    if (busy >= 0) {
+        while (digitalRead(busy) == HIGH) {
+        }
+    }
+    SPI.beginTransaction(SPISettings(spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(nss, LOW);
+}
+
+static void deselectRadio(int8_t nss) {
+    digitalWrite(nss, HIGH);
+    SPI.endTransaction();
+}
+
+void spi_bench_fifoRead(int8_t nss, int8_t busy, uint32_t spiFreq,
+                        const uint8_t* header, uint8_t headerLen, uint16_t payloadLen,
+                        SpiBenchmark* result) {
+    if (payloadLen > SPI_BENCH_PAYLOAD_MAX) {
+        payloadLen = SPI_BENCH_PAYLOAD_MAX;
+    }
+    if (headerLen > 4) {
+        headerLen = 4;
+    }
+    uint16_t len = headerLen + payloadLen;
+    
+    // Header then zeros out, the whole transaction in (both in RAM for DMA)
+    uint8_t tx[4 + SPI_BENCH_PAYLOAD_MAX];
+    uint8_t rx[4 + SPI_BENCH_PAYLOAD_MAX];
+    memset(tx, 0, len);
+    memcpy(tx, header, headerLen);
+    
+    uint32_t byteLoopUs = 0;
+    uint32_t bulkUs = 0;
+    uint32_t bulkCpuUs = 0;
+    
+    for (uint8_t run = 0; run < SPI_BENCH_RUNS; run++) {
+        selectRadio(nss, busy, spiFreq);
+        unsigned long startUs = micros();
+        for (uint16_t i = 0; i < len; i++) {
+            rx[i] = SPI.transfer(tx[i]);
+        }
+        byteLoopUs += micros() - startUs;
+        deselectRadio(nss);
+        
+        selectRadio(nss, busy, spiFreq);
+        startUs = micros();
+        platform_spiTransfer(tx, rx, len);
+        bulkUs += micros() - startUs;
+        deselectRadio(nss);
+        
+        selectRadio(nss, busy, spiFreq);
+        backgroundDone = false;
+        startUs = micros();
+        platform_spiStart(tx, rx, len, onBackgroundDone, nullptr);
+        bulkCpuUs += micros() - startUs;
+        while (!backgroundDone) {
+            startUs = micros();
+            platform_spiPoll();
+            if (backgroundDone) {
+                bulkCpuUs += micros() - startUs;  // The poll that completed it
+            }
+        }
+        deselectRadio(nss);
+    }
+    
+    result->bytes = len;
+    result->byteLoopUs = byteLoopUs / SPI_BENCH_RUNS;
+    result->bulkUs = bulkUs / SPI_BENCH_RUNS;
+    result->bulkCpuUs = bulkCpuUs / SPI_BENCH_RUNS;
+}
@@ -0,0 +1,44 @@
+#ifndef SPI_BENCH_H
+#define SPI_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Radio SPI Microbenchmark
+ * 
+ * Times one radio FIFO read (command header + payload in a single NSS
+ * window) three ways:
+ * - byte loop: one SPI.transfer() per byte, the classic path
+ * - bulk: platform_spiTransfer(), waited for (EasyDMA on RAK4631)
+ * - background: platform_spiStart(); only the CPU time spent starting and
+ *   completing the transfer counts, the bus time is free for other work
+ * 
+ * Bytes per microsecond is bytes / time; everything is averaged over
+ * SPI_BENCH_RUNS reads.
+ * 
+ * Drivers with a fetchFrame() also time reading out the frame currently in
+ * the radio buffer (RX_DONE to frame in RAM) with the old one-transaction-per-
+ * getter sequence and with fetchFrame(), both without clearing the IRQs.
+ */
+
+#define SPI_BENCH_RUNS 8
+#define SPI_BENCH_PAYLOAD_MAX 255
+
+typedef struct {
+    uint16_t bytes;         // Bytes clocked per read (header + payload)
+    uint32_t byteLoopUs;    // Per read: one SPI.transfer() per byte
+    uint32_t bulkUs;        // Per read: one bulk transfer
+    uint32_t bulkCpuUs;     // Per read: CPU time of a background transfer (bus time excluded)
+    uint8_t rxBytes;        // Payload length of the frame read out (0: readout not timed)
+    uint32_t rxGettersUs;   // Per readout: one transaction per getter
+    uint32_t rxFetchUs;     // Per readout: fetchFrame()
+} SpiBenchmark;
+
+// Time reads of `payloadLen` bytes (max SPI_BENCH_PAYLOAD_MAX) after `header`,
+// the radio's read-FIFO command. `busy` is the SX126x BUSY pin (-1 if none).
+void spi_bench_fifoRead(int8_t nss, int8_t busy, uint32_t spiFreq,
+                        const uint8_t* header, uint8_t headerLen, uint16_t payloadLen,
+                        SpiBenchmark* result);
+
+#endif // SPI_BENCH_H
@@ -2,6 +2,9 @@
 #include <SPI.h>
 #include "../../platforms/platform_interface.h"  // Platform interface for pin definitions
 #include "sx1262_direct.h"
+#include "../radio_shadow.h"
+#include "../radio_busy.h"
+#include <string.h>
 
 // SPI object is defined in platform-specific platform.cpp files
 // Since this file is only compiled for platforms that support SX1262 (RAK4631),
@@ -10,104 +13,307 @@
 // For nRF52 (RAK4631), SPI is defined in platforms/rak4631/platform.cpp, so we need extern declaration
 extern SPIClass SPI;
 
-// Static variables to cache pin numbers from platform interface
-static int8_t pin_nss = -1;
-static int8_t pin_busy = -1;
-static int8_t pin_dio1 = -1;
-static int8_t pin_power_en = -1;
-static uint32_t spi_freq = 8000000;
-
-// SX1262 Direct SPI Implementation
-// Similar to sx1276_direct but uses SX1262 command-based protocol
-
-// State tracking
-static uint8_t current_mode = 0x01; // STANDBY
-static uint8_t last_packet_length = 0;
-static int16_t last_rssi = 0;
-static int8_t last_snr = 0;
-static volatile bool packet_received_flag = false;
-static void (*user_interrupt_handler)() = nullptr;
-
-// Wait for BUSY pin to go low (SX1262 requirement)
-static void waitForBusy() {
-    if (pin_busy >= 0) {
-        while (digitalRead(pin_busy) == HIGH) {
-            delayMicroseconds(1);
-        }
+// Command engine state
+typedef enum {
+    ENGINE_IDLE,        // Nothing queued, BUSY low
+    ENGINE_READY,       // Next command can start (waiting for the SPI)
+    ENGINE_HEADER,      // Header transfer running
+    ENGINE_DATA,        // Data transfer running
+    ENGINE_WAIT_BUSY,   // Waiting for the radio to drop BUSY
+    ENGINE_FAULT        // A command timed out - nothing runs until init
+} EngineState;
+
+// Engine holding the SPI bus from a command's header to the end of its data
+// (one NSS window) - the other radio's engine waits in ENGINE_READY
+static Sx1262Direct* volatile busOwner = nullptr;
+
+static void startTransfer(Sx1262Direct* dev);
+
+// Take the SPI bus for one NSS window; false while the other radio holds it
+static bool claimBus(Sx1262Direct* dev) {
+    noInterrupts();
+    bool claimed = (busOwner == nullptr || busOwner == dev);
+    if (claimed) {
+        busOwner = dev;
     }
+    interrupts();
+    return claimed;
 }
 
-// Send SPI command and wait for BUSY
-static void sx1262_sendCommand(uint8_t cmd, uint8_t* data = nullptr, uint8_t dataLen = 0) {
-    waitForBusy();
-    
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
-    
-    SPI.transfer(cmd);
-    for (uint8_t i = 0; i < dataLen; i++) {
-        SPI.transfer(data[i]);
+static const Sx1262Command* currentCommand(Sx1262Direct* dev) {
+    return &dev->queue[dev->queueRun].commands[dev->commandIndex];
+}
+
+// Current command is done: move on, or go idle once the queue has run dry.
+// Runs with the BUSY interrupt unable to interfere (from it, or while the
+// engine is in a state it ignores).
+static void completeCommand(Sx1262Direct* dev) {
+    CommandBatch* batch = &dev->queue[dev->queueRun];
+    if (++dev->commandIndex >= batch->count) {
+        batch->ok = true;
+        batch->finished = true;
+        dev->queueRun = (dev->queueRun + 1) % SX1262_CMD_QUEUE_BATCHES;
+        dev->queueUnrun--;
+        dev->commandIndex = 0;
     }
-    
-    digitalWrite(pin_nss, HIGH);
+    if (dev->queueUnrun > 0) {
+        startTransfer(dev);
+    } else {
+        dev->engineState = ENGINE_IDLE;
+    }
+}
+
+// BUSY dropped: the radio has finished the command (or woken up)
+static void releaseBusy(Sx1262Direct* dev) {
+    radio_busy_recordWait(micros() - dev->busyStartUs);
+    if (dev->waking) {
+        dev->waking = false;
+        startTransfer(dev);
+    } else {
+        completeCommand(dev);
+    }
+}
+
+// A command kept BUSY high past its timeout: fail everything queued
+static void raiseFault(Sx1262Direct* dev) {
+    digitalWrite(dev->pinNss, HIGH);
+    while (dev->queueUnrun > 0) {
+        dev->queue[dev->queueRun].ok = false;
+        dev->queue[dev->queueRun].finished = true;
+        dev->queueRun = (dev->queueRun + 1) % SX1262_CMD_QUEUE_BATCHES;
+        dev->queueUnrun--;
+    }
+    dev->commandIndex = 0;
+    dev->waking = false;
+    dev->engineState = ENGINE_FAULT;
+    radio_busy_raiseFault();
+}
+
+static void beginBusyWait(Sx1262Direct* dev, uint32_t timeoutUs) {
+    dev->busyTimeoutUs = timeoutUs;
+    dev->busyStartUs = micros();
+    dev->engineState = ENGINE_WAIT_BUSY;
+}
+
+static void onDataDone(void* context) {
+    Sx1262Direct* dev = (Sx1262Direct*)context;
+    digitalWrite(dev->pinNss, HIGH);
     SPI.endTransaction();
+    busOwner = nullptr;
     
-    waitForBusy();
+    const Sx1262Command* cmd = currentCommand(dev);
+    if (cmd->header[0] == CMD_SET_SLEEP) {
+        // BUSY stays high while asleep - the next command wakes the radio first
+        dev->sleeping = true;
+        completeCommand(dev);
+        return;
+    }
+    beginBusyWait(dev, cmd->timeoutUs != 0 ? cmd->timeoutUs : RADIO_BUSY_TIMEOUT_US);
 }
 
-// Read response from SPI command
-static void sx1262_readCommand(uint8_t cmd, uint8_t* data, uint8_t dataLen) {
-    waitForBusy();
-    
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
-    
-    SPI.transfer(cmd);
-    for (uint8_t i = 0; i < dataLen; i++) {
-        data[i] = SPI.transfer(0x00);
+static void onHeaderDone(void* context) {
+    Sx1262Direct* dev = (Sx1262Direct*)context;
+    const Sx1262Command* cmd = currentCommand(dev);
+    if (cmd->dataLen == 0) {
+        onDataDone(context);
+        return;
+    }
+    dev->engineState = ENGINE_DATA;
+    platform_spiStart(cmd->txData, cmd->rxData, cmd->dataLen, onDataDone, dev);
+}
+
+// Start the current command; BUSY is low. Header and data each go out as one
+// background transfer (EasyDMA on RAK4631) in the same NSS window.
+static void startTransfer(Sx1262Direct* dev) {
+    if (dev->sleeping) {
+        // An NSS falling edge wakes the radio; BUSY drops once it is in STDBY_RC
+        dev->sleeping = false;
+        dev->waking = true;
+        digitalWrite(dev->pinNss, LOW);
+        delayMicroseconds(1);
+        digitalWrite(dev->pinNss, HIGH);
+        beginBusyWait(dev, RADIO_BUSY_TIMEOUT_US);
+        return;
     }
     
-    digitalWrite(pin_nss, HIGH);
-    SPI.endTransaction();
+    if (!claimBus(dev)) {
+        // The other radio is mid-command on the shared SPI - retried from poll
+        dev->engineState = ENGINE_READY;
+        return;
+    }
     
-    waitForBusy();
+    const Sx1262Command* cmd = currentCommand(dev);
+    dev->engineState = ENGINE_HEADER;
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
+    if (!platform_spiStart(cmd->header, nullptr, cmd->headerLen, onHeaderDone, dev)) {
+        // The SPI is still finishing another transfer - retried from poll
+        digitalWrite(dev->pinNss, HIGH);
+        SPI.endTransaction();
+        busOwner = nullptr;
+        dev->engineState = ENGINE_READY;
+    }
 }
 
-// Write register (16-bit address)
-static void sx1262_writeReg(uint16_t address, uint8_t* data, uint8_t len) {
-    uint8_t cmdData[3 + len];
-    cmdData[0] = (address >> 8) & 0xFF; // Address MSB
-    cmdData[1] = address & 0xFF;         // Address LSB
-    cmdData[2] = len;                     // Data length
-    for (uint8_t i = 0; i < len; i++) {
-        cmdData[3 + i] = data[i];
+// Interrupt entry points per instance (attachInterrupt takes no argument)
+static Sx1262Direct* isrInstances[SX1262_DIRECT_MAX_INSTANCES];
+
+// BUSY falling edge: the radio is ready for the next command
+static void dispatchBusy(Sx1262Direct* dev) {
+    if (dev != nullptr && dev->engineState == ENGINE_WAIT_BUSY) {
+        releaseBusy(dev);
     }
-    sx1262_sendCommand(CMD_WRITE_REGISTER, cmdData, 3 + len);
 }
 
-// Read register (16-bit address)
-static void sx1262_readReg(uint16_t address, uint8_t* data, uint8_t len) {
-    uint8_t cmdData[3];
-    cmdData[0] = (address >> 8) & 0xFF; // Address MSB
-    cmdData[1] = address & 0xFF;         // Address LSB
-    cmdData[2] = len;                     // Data length
+static void sx1262_busy_isr0() { dispatchBusy(isrInstances[0]); }
+static void sx1262_busy_isr1() { dispatchBusy(isrInstances[1]); }
+
+static void (*const busyIsrEntries[SX1262_DIRECT_MAX_INSTANCES])() = { sx1262_busy_isr0, sx1262_busy_isr1 };
+
+bool sx1262_direct_submit(Sx1262Direct* dev, const Sx1262Command* commands, uint8_t count,
+                          void (*done)(bool ok, void* context), void* context) {
+    if (count == 0 || dev->engineState == ENGINE_FAULT || dev->queueLen >= SX1262_CMD_QUEUE_BATCHES) {
+        return false;
+    }
     
-    waitForBusy();
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
+    noInterrupts();
+    CommandBatch* batch = &dev->queue[(dev->queueTail + dev->queueLen) % SX1262_CMD_QUEUE_BATCHES];
+    batch->commands = commands;
+    batch->count = count;
+    batch->finished = false;
+    batch->ok = false;
+    batch->done = done;
+    batch->context = context;
+    dev->queueLen++;
+    dev->queueUnrun++;
+    bool start = (dev->engineState == ENGINE_IDLE);
+    if (start) {
+        dev->engineState = ENGINE_READY;  // Keeps the BUSY interrupt out until started
+    }
+    interrupts();
     
-    SPI.transfer(CMD_READ_REGISTER);
-    SPI.transfer(cmdData[0]);
-    SPI.transfer(cmdData[1]);
-    SPI.transfer(cmdData[2]);
-    for (uint8_t i = 0; i < len; i++) {
-        data[i] = SPI.transfer(0x00);
+    if (start) {
+        startTransfer(dev);
     }
+    return true;
+}
+
+void sx1262_direct_poll(Sx1262Direct* dev) {
+    platform_spiPoll();  // Finishes header/data transfers
     
-    digitalWrite(pin_nss, HIGH);
-    SPI.endTransaction();
+    noInterrupts();
+    if (dev->engineState == ENGINE_READY) {
+        startTransfer(dev);
+    } else if (dev->engineState == ENGINE_WAIT_BUSY) {
+        // Catches a BUSY edge that came before the wait began; BUSY may take
+        // up to 600 ns to rise after NSS, so a low level only counts after that
+        uint32_t waitedUs = micros() - dev->busyStartUs;
+        if (waitedUs >= 2 && digitalRead(dev->pinBusy) == LOW) {
+            releaseBusy(dev);
+        } else if (waitedUs >= dev->busyTimeoutUs) {
+            raiseFault(dev);
+        }
+    }
+    interrupts();
     
-    waitForBusy();
+    // Report finished batches in submission order
+    while (dev->queueLen > 0 && dev->queue[dev->queueTail].finished) {
+        CommandBatch batch = dev->queue[dev->queueTail];
+        noInterrupts();
+        dev->queueTail = (dev->queueTail + 1) % SX1262_CMD_QUEUE_BATCHES;
+        dev->queueLen--;
+        interrupts();
+        if (batch.done != nullptr) {
+            batch.done(batch.ok, batch.context);
+        }
+    }
+}
+
+bool sx1262_direct_isIdle(Sx1262Direct* dev) {
+    return dev->queueLen == 0 && (dev->engineState == ENGINE_IDLE || dev->engineState == ENGINE_FAULT);
+}
+
+// Run everything queued; false if the radio faulted on the way
+static bool drainQueue(Sx1262Direct* dev) {
+    while (!sx1262_direct_isIdle(dev)) {
+        sx1262_direct_poll(dev);
+    }
+    return dev->engineState != ENGINE_FAULT;
+}
+
+static void onSyncDone(bool ok, void* context) {
+    *(volatile int8_t*)context = ok ? 1 : 0;
+}
+
+// Run `count` commands as one batch, queued behind anything already
+// submitted, and wait for them; false if the radio faulted on the way
+static bool sx1262_runBatch(Sx1262Direct* dev, const Sx1262Command* commands, uint8_t count) {
+    volatile int8_t result = -1;
+    while (!sx1262_direct_submit(dev, commands, count, onSyncDone, (void*)&result)) {
+        if (dev->engineState == ENGINE_FAULT) {
+            break;
+        }
+        sx1262_direct_poll(dev);  // Queue full - make room
+    }
+    while (result < 0 && dev->engineState != ENGINE_FAULT) {
+        sx1262_direct_poll(dev);
+    }
+    sx1262_direct_poll(dev);  // Report the batch even if a fault flushed it
+    return result == 1;
+}
+
+static void setCommand(Sx1262Command* cmd, const uint8_t* header, uint8_t headerLen,
+                       const uint8_t* txData, uint8_t* rxData, uint16_t dataLen) {
+    memcpy(cmd->header, header, headerLen);
+    cmd->headerLen = headerLen;
+    cmd->txData = txData;
+    cmd->rxData = rxData;
+    cmd->dataLen = dataLen;
+    cmd->timeoutUs = 0;
+}
+
+// One SPI transaction: `header` out, then `dataLen` bytes out of `txData` or
+// into `rxData`, queued behind anything already submitted and waited for.
+// Reads come back zeroed if the radio has faulted.
+static void sx1262_transaction(Sx1262Direct* dev, const uint8_t* header, uint8_t headerLen,
+                               const uint8_t* txData, uint8_t* rxData, uint16_t dataLen) {
+    Sx1262Command cmd;
+    setCommand(&cmd, header, headerLen, txData, rxData, dataLen);
+    if (!sx1262_runBatch(dev, &cmd, 1) && rxData != nullptr) {
+        memset(rxData, 0, dataLen);
+    }
+}
+
+// Send SPI command and wait for BUSY
+static void sx1262_sendCommand(Sx1262Direct* dev, uint8_t cmd, const uint8_t* data = nullptr, uint8_t dataLen = 0) {
+    sx1262_transaction(dev, &cmd, 1, data, nullptr, dataLen);
+}
+
+// Read response from SPI command: the radio answers the byte after the
+// opcode with its status, the response follows
+static void sx1262_readCommand(Sx1262Direct* dev, uint8_t cmd, uint8_t* data, uint8_t dataLen) {
+    const uint8_t header[2] = {cmd, 0x00};
+    sx1262_transaction(dev, header, 2, nullptr, data, dataLen);
+}
+
+// Write register (16-bit address)
+static void sx1262_writeReg(Sx1262Direct* dev, uint16_t address, uint8_t* data, uint8_t len) {
+    uint8_t header[4];
+    header[0] = CMD_WRITE_REGISTER;
+    header[1] = (address >> 8) & 0xFF; // Address MSB
+    header[2] = address & 0xFF;         // Address LSB
+    header[3] = len;                     // Data length
+    sx1262_transaction(dev, header, 4, data, nullptr, len);
+}
+
+// Read register (16-bit address)
+static void sx1262_readReg(Sx1262Direct* dev, uint16_t address, uint8_t* data, uint8_t len) {
+    uint8_t header[4];
+    header[0] = CMD_READ_REGISTER;
+    header[1] = (address >> 8) & 0xFF; // Address MSB
+    header[2] = address & 0xFF;         // Address LSB
+    header[3] = len;                     // Data length
+    sx1262_transaction(dev, header, 4, nullptr, data, len);
 }
 
 // Map SX1276 bandwidth codes to SX1262 bandwidth values
@@ -121,76 +327,127 @@ static uint8_t bw_code_to_sx1262(uint8_t bw_code) {
     return bw_code;
 }
 
+// SetRfFrequency payload: freq = (freq_hz * 2^25) / 32e6, MSB first
+static void encodeFrequency(uint32_t freq_hz, uint8_t freqData[4]) {
+    uint32_t freq_reg = (uint32_t)(((uint64_t)freq_hz << 25) / 32000000);
+    freqData[0] = (freq_reg >> 24) & 0xFF;
+    freqData[1] = (freq_reg >> 16) & 0xFF;
+    freqData[2] = (freq_reg >> 8) & 0xFF;
+    freqData[3] = freq_reg & 0xFF;
+}
+
 // IRQ handler wrapper
-static void sx1262_irq_handler() {
-    packet_received_flag = true;
-    if (user_interrupt_handler) {
-        user_interrupt_handler();
+static void dispatchIrq(Sx1262Direct* dev) {
+    if (dev == nullptr) {
+        return;
+    }
+    dev->packetReceived = true;
+    if (dev->interruptHandler) {
+        dev->interruptHandler();
     }
 }
 
-bool sx1262_direct_init() {
-    // Get pin numbers from platform interface
-    pin_nss = platform_getRadioNssPin();
-    pin_busy = platform_getRadioBusyPin();
-    pin_dio1 = platform_getRadioDio1Pin();
-    pin_power_en = platform_getRadioPowerEnablePin();
-    spi_freq = platform_getSpiFrequency();
+static void sx1262_irq_handler0() { dispatchIrq(isrInstances[0]); }
+static void sx1262_irq_handler1() { dispatchIrq(isrInstances[1]); }
+
+static void (*const irqEntries[SX1262_DIRECT_MAX_INSTANCES])() = { sx1262_irq_handler0, sx1262_irq_handler1 };
+
+bool sx1262_direct_init(Sx1262Direct* dev, uint8_t index, const RadioPins* pins) {
+    radio_shadow_invalidate(&dev->shadow);
+    if (index >= SX1262_DIRECT_MAX_INSTANCES) {
+        return false;
+    }
+    dev->index = index;
+    
+    // Report whatever a fault left queued, then start the engine over
+    sx1262_direct_poll(dev);
+    if (busOwner == dev) {
+        busOwner = nullptr;
+    }
+    dev->engineState = ENGINE_IDLE;
+    dev->sleeping = false;
+    dev->waking = false;
+    dev->mode = 0x01;
+    dev->sf = 7;
+    
+    dev->pinNss = pins->nss;
+    dev->pinReset = pins->reset;
+    dev->pinBusy = pins->busy;
+    dev->pinDio1 = pins->dio1;
+    dev->pinPowerEn = pins->powerEnable;
+    dev->spiFreq = platform_getSpiFrequency();
     
     // Validate required pins
-    if (pin_nss < 0 || pin_busy < 0 || pin_dio1 < 0) {
+    if (dev->pinNss < 0 || dev->pinBusy < 0 || dev->pinDio1 < 0) {
         return false;  // Required pins not available
     }
     
     // Initialize power enable pin (if available)
-    if (pin_power_en >= 0) {
-        pinMode(pin_power_en, OUTPUT);
-        digitalWrite(pin_power_en, HIGH);
+    if (dev->pinPowerEn >= 0) {
+        pinMode(dev->pinPowerEn, OUTPUT);
+        digitalWrite(dev->pinPowerEn, HIGH);
         delay(10); // Give SX1262 time to power up
     }
     
     // Initialize pins
-    pinMode(pin_nss, OUTPUT);
-    pinMode(pin_busy, INPUT);
-    pinMode(pin_dio1, INPUT);
+    pinMode(dev->pinNss, OUTPUT);
+    pinMode(dev->pinBusy, INPUT);
+    pinMode(dev->pinDio1, INPUT);
     
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
     
     // Initialize SPI
     SPI.begin();
     
+    // A reset also recovers a radio that stopped releasing BUSY
+    if (dev->pinReset >= 0) {
+        pinMode(dev->pinReset, OUTPUT);
+        digitalWrite(dev->pinReset, LOW);
+        delay(1);
+        digitalWrite(dev->pinReset, HIGH);
+    }
+    
     // Wait for BUSY to go low (chip ready)
-    waitForBusy();
+    uint32_t busyStart = micros();
+    while (digitalRead(dev->pinBusy) == HIGH) {
+        if (micros() - busyStart >= RADIO_BUSY_TIMEOUT_US) {
+            return false;  // Radio not responding
+        }
+    }
+    radio_busy_recordWait(micros() - busyStart);
+    isrInstances[index] = dev;
+    attachInterrupt(digitalPinToInterrupt(dev->pinBusy), busyIsrEntries[index], FALLING);
     
     // Set to standby mode
     uint8_t standbyMode = STANDBY_RC;
-    sx1262_sendCommand(CMD_SET_STANDBY, &standbyMode, 1);
+    sx1262_sendCommand(dev, CMD_SET_STANDBY, &standbyMode, 1);
     
     // Set regulator mode to LDO (for RAK4631)
     uint8_t regMode = 0x00; // LDO mode
-    sx1262_sendCommand(CMD_SET_REGULATOR_MODE, &regMode, 1);
+    sx1262_sendCommand(dev, CMD_SET_REGULATOR_MODE, &regMode, 1);
     
     // Radio is now initialized and ready
     // Protocol-specific configuration (frequency, bandwidth, etc.) should be done
     // by the protocol layer via the radio interface functions
     
-    // Configure DIO1 for RX_DONE and TX_DONE interrupts
+    // Configure DIO1 for RX_DONE, TX_DONE and CAD interrupts; HEADER_VALID is
+    // latched in the status only (polled by isReceiving, never raises DIO1)
     uint8_t dioParams[8];
-    dioParams[0] = 0x00; // IRQ mask MSB (IRQ_TX_DONE | IRQ_RX_DONE)
-    dioParams[1] = 0x03; // IRQ mask LSB
+    dioParams[0] = 0x01; // IRQ mask MSB (IRQ_CAD_DETECTED)
+    dioParams[1] = 0x93; // IRQ mask LSB (IRQ_CAD_DONE | IRQ_HEADER_VALID | IRQ_TX_DONE | IRQ_RX_DONE)
     dioParams[2] = 0x00; // DIO1 mask MSB
-    dioParams[3] = 0x03; // DIO1 mask LSB (DIO1 = IRQ_TX_DONE | IRQ_RX_DONE)
+    dioParams[3] = 0x83; // DIO1 mask LSB (DIO1 = IRQ_CAD_DONE | IRQ_TX_DONE | IRQ_RX_DONE)
     dioParams[4] = 0x00; // DIO2 mask MSB
     dioParams[5] = 0x00; // DIO2 mask LSB
     dioParams[6] = 0x00; // DIO3 mask MSB
     dioParams[7] = 0x00; // DIO3 mask LSB
-    sx1262_sendCommand(CMD_SET_DIO_IRQ_PARAMS, dioParams, 8);
+    sx1262_sendCommand(dev, CMD_SET_DIO_IRQ_PARAMS, dioParams, 8);
     
     // Clear any pending IRQs
-    sx1262_direct_clearIrqFlags();
+    sx1262_direct_clearIrqFlags(dev);
     
     // Set to RX continuous mode
-    sx1262_direct_setMode(0x05); // RX_CONTINUOUS
+    sx1262_direct_setMode(dev, 0x05); // RX_CONTINUOUS
     
     return true;
 }
@@ -203,89 +460,106 @@ uint32_t sx1262_direct_getMaxFrequency() {
     return SX1262_MAX_FREQUENCY_HZ;
 }
 
-void sx1262_direct_setFrequency(uint32_t freq_hz) {
-    // SX1262 frequency calculation: freq = (freq_hz * 2^25) / 32e6
-    uint32_t freq_reg = (uint32_t)((uint64_t)freq_hz << 25) / 32000000;
+void sx1262_direct_setFrequency(Sx1262Direct* dev, uint32_t freq_hz) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_FREQUENCY, freq_hz)) {
+        return;
+    }
     
     uint8_t freqData[4];
-    freqData[0] = (freq_reg >> 24) & 0xFF;
-    freqData[1] = (freq_reg >> 16) & 0xFF;
-    freqData[2] = (freq_reg >> 8) & 0xFF;
-    freqData[3] = freq_reg & 0xFF;
-    
-    sx1262_sendCommand(CMD_SET_RF_FREQUENCY, freqData, 4);
+    encodeFrequency(freq_hz, freqData);
+    sx1262_sendCommand(dev, CMD_SET_RF_FREQUENCY, freqData, 4);
 }
 
-void sx1262_direct_setPower(uint8_t power) {
+void sx1262_direct_setPower(Sx1262Direct* dev, uint8_t power) {
     if (power > 22) power = 22; // RAK4631 max is 22 dBm
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_POWER, power)) {
+        return;
+    }
     
     // PA config: [0]=power, [1]=rampTime (0x04 = 200us)
     uint8_t paConfig[2];
     paConfig[0] = power;
     paConfig[1] = 0x04; // Ramp time
     
-    sx1262_sendCommand(CMD_SET_PA_CONFIG, paConfig, 2);
+    sx1262_sendCommand(dev, CMD_SET_PA_CONFIG, paConfig, 2);
 }
 
-void sx1262_direct_setBandwidth(uint8_t bw) {
+void sx1262_direct_setBandwidth(Sx1262Direct* dev, uint8_t bw) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_BANDWIDTH, bw)) {
+        return;
+    }
     uint8_t bw_sx1262 = bw_code_to_sx1262(bw);
     
     // Read current LoRa config
     uint8_t config[1];
-    sx1262_readReg(REG_LORA_CONFIG_2, config, 1);
+    sx1262_readReg(dev, REG_LORA_CONFIG_2, config, 1);
     
     // Set bandwidth bits (bits 4-7)
     config[0] = (config[0] & 0x0F) | (bw_sx1262 << 4);
     
     uint8_t writeData[1] = {config[0]};
-    sx1262_writeReg(REG_LORA_CONFIG_2, writeData, 1);
+    sx1262_writeReg(dev, REG_LORA_CONFIG_2, writeData, 1);
 }
 
-void sx1262_direct_setSpreadingFactor(uint8_t sf) {
+void sx1262_direct_setSpreadingFactor(Sx1262Direct* dev, uint8_t sf) {
     if (sf < 6) sf = 6;
     if (sf > 12) sf = 12;
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_SPREADING_FACTOR, sf)) {
+        return;
+    }
     
     // Read current LoRa config
     uint8_t config[1];
-    sx1262_readReg(REG_LORA_CONFIG_2, config, 1);
+    sx1262_readReg(dev, REG_LORA_CONFIG_2, config, 1);
     
     // Set spreading factor bits (bits 0-3)
     config[0] = (config[0] & 0xF0) | (sf - 5);
+    dev->sf = sf;
     
     uint8_t writeData[1] = {config[0]};
-    sx1262_writeReg(REG_LORA_CONFIG_2, writeData, 1);
+    sx1262_writeReg(dev, REG_LORA_CONFIG_2, writeData, 1);
 }
 
-void sx1262_direct_setCodingRate(uint8_t cr) {
+void sx1262_direct_setCodingRate(Sx1262Direct* dev, uint8_t cr) {
     if (cr < 5) cr = 5;
     if (cr > 8) cr = 8;
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_CODING_RATE, cr)) {
+        return;
+    }
     
     // Read current LoRa config
     uint8_t config[1];
-    sx1262_readReg(REG_LORA_CONFIG_1, config, 1);
+    sx1262_readReg(dev, REG_LORA_CONFIG_1, config, 1);
     
     // Set coding rate bits (bits 1-3)
     config[0] = (config[0] & 0xF1) | ((cr - 4) << 1);
     
     uint8_t writeData[1] = {config[0]};
-    sx1262_writeReg(REG_LORA_CONFIG_1, writeData, 1);
+    sx1262_writeReg(dev, REG_LORA_CONFIG_1, writeData, 1);
 }
 
-void sx1262_direct_setSyncWord(uint8_t syncWord) {
+void sx1262_direct_setSyncWord(Sx1262Direct* dev, uint8_t syncWord) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_SYNC_WORD, syncWord)) {
+        return;
+    }
     uint8_t syncData[2] = {syncWord, syncWord}; // MSB and LSB (same for 8-bit sync word)
-    sx1262_writeReg(REG_LORA_SYNC_WORD_MSB, syncData, 2);
+    sx1262_writeReg(dev, REG_LORA_SYNC_WORD_MSB, syncData, 2);
 }
 
-void sx1262_direct_setPreambleLength(uint16_t length) {
+void sx1262_direct_setPreambleLength(Sx1262Direct* dev, uint16_t length) {
     // SX1262 preamble length is set via SetTxParams command
     // For now, store it - it will be used when setting TX mode
     // Note: This is a simplified version - preamble is typically set with TX params
     // The actual preamble length is configured when entering TX mode
 }
 
-void sx1262_direct_setCrc(bool enable) {
+void sx1262_direct_setCrc(Sx1262Direct* dev, bool enable) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_CRC, enable)) {
+        return;
+    }
+    
     uint8_t config[1];
-    sx1262_readReg(REG_LORA_CONFIG_1, config, 1);
+    sx1262_readReg(dev, REG_LORA_CONFIG_1, config, 1);
     
     if (enable) {
         config[0] |= 0x20; // Enable CRC
@@ -294,12 +568,16 @@ void sx1262_direct_setCrc(bool enable) {
     }
     
     uint8_t writeData[1] = {config[0]};
-    sx1262_writeReg(REG_LORA_CONFIG_1, writeData, 1);
+    sx1262_writeReg(dev, REG_LORA_CONFIG_1, writeData, 1);
 }
 
-void sx1262_direct_setHeaderMode(bool implicit) {
+void sx1262_direct_setHeaderMode(Sx1262Direct* dev, bool implicit) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_HEADER_MODE, implicit)) {
+        return;
+    }
+    
     uint8_t config[1];
-    sx1262_readReg(REG_LORA_CONFIG_1, config, 1);
+    sx1262_readReg(dev, REG_LORA_CONFIG_1, config, 1);
     
     if (implicit) {
         config[0] |= 0x01; // Implicit header mode
@@ -308,40 +586,164 @@ void sx1262_direct_setHeaderMode(bool implicit) {
     }
     
     uint8_t writeData[1] = {config[0]};
-    sx1262_writeReg(REG_LORA_CONFIG_1, writeData, 1);
+    sx1262_writeReg(dev, REG_LORA_CONFIG_1, writeData, 1);
 }
 
-void sx1262_direct_setInvertIQ(bool invert) {
-    uint8_t iqData[1];
-    sx1262_readReg(REG_IQ_POLARITY, iqData, 1);
+void sx1262_direct_setInvertIQ(Sx1262Direct* dev, bool invert) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_INVERT_IQ, invert)) {
+        return;
+    }
     
-    if (invert) {
-        iqData[0] = 0x01; // Inverted IQ
-    } else {
-        iqData[0] = 0x00; // Normal IQ
+    // The whole register is rewritten - no need to read it first
+    uint8_t iqData[1] = { (uint8_t)(invert ? 0x01 : 0x00) };  // Inverted / normal IQ
+    sx1262_writeReg(dev, REG_IQ_POLARITY, iqData, 1);
+}
+
+// Command payloads of one radio profile, encoded once and sent as-is
+typedef struct {
+    uint8_t rfFrequency[4];         // SetRfFrequency
+    uint8_t modulationParams[4];    // SetModulationParams: SF, BW, CR, low data rate optimize
+    uint8_t packetParams[6];        // SetPacketParams: preamble (2), header type, payload length, CRC, invert IQ
+    uint8_t syncWord[2];            // WriteRegister REG_LORA_SYNC_WORD_MSB..LSB
+} SX1262ProfileImage;
+
+static_assert(sizeof(SX1262ProfileImage) <= sizeof(RadioProfile::image), "SX1262 profile image too large");
+
+// SetModulationParams bandwidth values and widths (Hz) per bandwidth code
+// (0=7.8kHz ... 9=500kHz); the SX126x encoding is not in ascending order
+static const uint8_t modulationBandwidth[] = {0x00, 0x08, 0x01, 0x09, 0x02, 0x0A, 0x03, 0x04, 0x05, 0x06};
+static const uint32_t bandwidthHz[] = {7810, 10420, 15630, 20830, 31250, 41670, 62500, 125000, 250000, 500000};
+
+void sx1262_direct_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    SX1262ProfileImage* image = (SX1262ProfileImage*)profile->image;
+    uint8_t sf = settings->spreadingFactor;
+    if (sf < 6) sf = 6;
+    if (sf > 12) sf = 12;
+    uint8_t cr = settings->codingRate;
+    if (cr < 5) cr = 5;
+    if (cr > 8) cr = 8;
+    uint8_t bw = (settings->bandwidth > 9) ? 7 : settings->bandwidth; // Default to 125kHz
+    
+    encodeFrequency(settings->frequencyHz, image->rfFrequency);
+    
+    // Low data rate optimization is required once a symbol lasts 16.38 ms or more
+    uint32_t symbolUs = ((1UL << sf) * 1000000UL) / bandwidthHz[bw];
+    image->modulationParams[0] = sf;
+    image->modulationParams[1] = modulationBandwidth[bw];
+    image->modulationParams[2] = cr - 4;
+    image->modulationParams[3] = (symbolUs >= 16380) ? 0x01 : 0x00;
+    
+    image->packetParams[0] = (uint8_t)(settings->preambleLength >> 8);
+    image->packetParams[1] = (uint8_t)settings->preambleLength;
+    image->packetParams[2] = settings->implicitHeader ? 0x01 : 0x00;
+    image->packetParams[3] = 0xFF;  // Max payload length (implicit header RX)
+    image->packetParams[4] = settings->crcEnabled ? 0x01 : 0x00;
+    image->packetParams[5] = settings->invertIQ ? 0x01 : 0x00;
+    
+    image->syncWord[0] = settings->syncWord;  // Same layout as sx1262_direct_setSyncWord()
+    image->syncWord[1] = settings->syncWord;
+    
+    profile->settings = *settings;
+    profile->compiled = true;
+}
+
+static void onProfileApplied(bool ok, void* context) {
+    Sx1262Direct* dev = (Sx1262Direct*)context;
+    dev->profilePending = false;
+    if (ok) {
+        radio_profile_recordSwitch(micros() - dev->profileStartUs);
+    }
+}
+
+static void setProfileCommand(Sx1262Command* cmd, uint8_t opcode, const uint8_t* params, uint8_t len) {
+    cmd->header[0] = opcode;
+    cmd->headerLen = 1;
+    cmd->txData = params;
+    cmd->rxData = nullptr;
+    cmd->dataLen = len;
+    cmd->timeoutUs = 0;
+}
+
+void sx1262_direct_applyProfile(Sx1262Direct* dev, const RadioProfile* profile) {
+    // The previous switch still owns profileCommands
+    while (dev->profilePending && dev->engineState != ENGINE_FAULT) {
+        sx1262_direct_poll(dev);
+    }
+    
+    unsigned long startUs = micros();
+    const SX1262ProfileImage* image = (const SX1262ProfileImage*)profile->image;
+    const RadioSettings* settings = &profile->settings;
+    
+    // Record every parameter in the shadow, then send only the commands
+    // whose parameters changed
+    bool frequency = radio_shadow_update(&dev->shadow, RADIO_PARAM_FREQUENCY, settings->frequencyHz);
+    bool modulation = radio_shadow_update(&dev->shadow, RADIO_PARAM_SPREADING_FACTOR, image->modulationParams[0]);
+    modulation |= radio_shadow_update(&dev->shadow, RADIO_PARAM_BANDWIDTH, settings->bandwidth);
+    modulation |= radio_shadow_update(&dev->shadow, RADIO_PARAM_CODING_RATE, image->modulationParams[2] + 4);
+    bool packet = radio_shadow_update(&dev->shadow, RADIO_PARAM_PREAMBLE, settings->preambleLength);
+    packet |= radio_shadow_update(&dev->shadow, RADIO_PARAM_HEADER_MODE, settings->implicitHeader);
+    packet |= radio_shadow_update(&dev->shadow, RADIO_PARAM_CRC, settings->crcEnabled);
+    packet |= radio_shadow_update(&dev->shadow, RADIO_PARAM_INVERT_IQ, settings->invertIQ);
+    bool syncWord = radio_shadow_update(&dev->shadow, RADIO_PARAM_SYNC_WORD, settings->syncWord);
+    
+    // Queued as one batch: the caller goes on while the radio works through
+    // it, and anything it sends next is queued behind
+    uint8_t count = 0;
+    if (frequency) {
+        setProfileCommand(&dev->profileCommands[count++], CMD_SET_RF_FREQUENCY, image->rfFrequency, 4);
+    }
+    if (modulation) {
+        setProfileCommand(&dev->profileCommands[count++], CMD_SET_MODULATION_PARAMS, image->modulationParams, 4);
+        dev->sf = image->modulationParams[0];
+    }
+    if (packet) {
+        setProfileCommand(&dev->profileCommands[count++], CMD_SET_PACKET_PARAMS, image->packetParams, 6);
+    }
+    if (syncWord) {
+        Sx1262Command* cmd = &dev->profileCommands[count++];
+        setProfileCommand(cmd, CMD_WRITE_REGISTER, image->syncWord, 2);
+        cmd->header[1] = (REG_LORA_SYNC_WORD_MSB >> 8) & 0xFF;  // Same bytes as sx1262_writeReg()
+        cmd->header[2] = REG_LORA_SYNC_WORD_MSB & 0xFF;
+        cmd->header[3] = 2;
+        cmd->headerLen = 4;
+    }
+    if (count == 0) {
+        radio_profile_recordSwitch(micros() - startUs);
+        return;
     }
     
-    sx1262_writeReg(REG_IQ_POLARITY, iqData, 1);
+    dev->profileStartUs = startUs;
+    dev->profilePending = true;
+    while (!sx1262_direct_submit(dev, dev->profileCommands, count, onProfileApplied, dev)) {
+        if (dev->engineState == ENGINE_FAULT) {
+            dev->profilePending = false;
+            return;
+        }
+        sx1262_direct_poll(dev);  // Queue full - make room
+    }
 }
 
-void sx1262_direct_setMode(uint8_t mode) {
-    current_mode = mode;
+void sx1262_direct_setMode(Sx1262Direct* dev, uint8_t mode) {
+    dev->mode = mode;
     
     switch (mode) {
         case 0x00: // SLEEP
-            sx1262_sendCommand(CMD_SET_SLEEP);
+            sx1262_sendCommand(dev, CMD_SET_SLEEP);
             break;
         case 0x01: // STDBY
             {
                 uint8_t standbyMode = STANDBY_RC;
-                sx1262_sendCommand(CMD_SET_STANDBY, &standbyMode, 1);
+                sx1262_sendCommand(dev, CMD_SET_STANDBY, &standbyMode, 1);
             }
             break;
         case 0x03: // TX
-            // TX mode is set when transmitting (handled in writeFifo)
+            // Payload was staged by writeFifo() - fire SetTx (TX_DONE raises DIO1)
             {
-                uint8_t standbyMode = STANDBY_RC;
-                sx1262_sendCommand(CMD_SET_STANDBY, &standbyMode, 1);
+                uint8_t txParams[3];
+                txParams[0] = 0x00; // Timeout MSB
+                txParams[1] = 0x00; // Timeout MID
+                txParams[2] = 0x00; // Timeout LSB (0 = no timeout)
+                sx1262_sendCommand(dev, CMD_SET_TX, txParams, 3);
             }
             break;
         case 0x05: // RX_CONTINUOUS
@@ -350,39 +752,43 @@ void sx1262_direct_setMode(uint8_t mode) {
                 rxParams[0] = 0x00; // Timeout MSB (0 = continuous)
                 rxParams[1] = 0x00; // Timeout LSB
                 rxParams[2] = 0x00; // RX window mode (continuous)
-                sx1262_sendCommand(CMD_SET_RX, rxParams, 3);
+                sx1262_sendCommand(dev, CMD_SET_RX, rxParams, 3);
+            }
+            break;
+        case 0x07: // CAD
+            // 2-symbol CAD, detection peak per SF (Semtech AN1200.48), CAD_ONLY exit
+            {
+                uint8_t cadParams[7];
+                cadParams[0] = 0x01; // cadSymbolNum: 2 symbols
+                cadParams[1] = (dev->sf >= 12) ? 30 : (dev->sf >= 9) ? (uint8_t)(15 + dev->sf) : 22;
+                cadParams[2] = 10;   // cadDetMin
+                cadParams[3] = 0x00; // cadExitMode: CAD_ONLY (back to STDBY_RC)
+                cadParams[4] = 0x00; // cadTimeout (unused for CAD_ONLY)
+                cadParams[5] = 0x00;
+                cadParams[6] = 0x00;
+                sx1262_sendCommand(dev, CMD_SET_CAD_PARAMS, cadParams, 7);
+                sx1262_sendCommand(dev, CMD_SET_CAD);
             }
             break;
     }
 }
 
-void sx1262_direct_writeFifo(uint8_t* data, uint8_t len) {
+void sx1262_direct_writeFifo(Sx1262Direct* dev, uint8_t* data, uint8_t len) {
     // Ensure we're in standby before TX
     uint8_t standbyMode = STANDBY_RC;
-    sx1262_sendCommand(CMD_SET_STANDBY, &standbyMode, 1);
-    
-    // Write buffer
-    uint8_t writeCmd[1 + len];
-    writeCmd[0] = 0x00; // Offset (start of buffer)
-    for (uint8_t i = 0; i < len; i++) {
-        writeCmd[1 + i] = data[i];
-    }
-    sx1262_sendCommand(CMD_WRITE_BUFFER, writeCmd, 1 + len);
+    sx1262_sendCommand(dev, CMD_SET_STANDBY, &standbyMode, 1);
     
-    // Set TX with timeout
-    uint8_t txParams[3];
-    txParams[0] = 0x00; // Timeout MSB
-    txParams[1] = 0x00; // Timeout LSB (0 = no timeout)
-    txParams[2] = 0x00; // Ramp time
-    sx1262_sendCommand(CMD_SET_TX, txParams, 3);
+    // Write buffer straight from the caller's frame
+    const uint8_t header[2] = {CMD_WRITE_BUFFER, 0x00}; // Offset (start of buffer)
+    sx1262_transaction(dev, header, 2, data, nullptr, len);
     
-    current_mode = 0x03; // TX
+    // TX itself is started by sx1262_direct_setMode(MODE_TX)
 }
 
-void sx1262_direct_readFifo(uint8_t* data, uint8_t len) {
+void sx1262_direct_readFifo(Sx1262Direct* dev, uint8_t* data, uint8_t len) {
     // Get RX buffer status to get offset (we already have length from getPacketLength)
     uint8_t rxStatus[2];
-    sx1262_readCommand(CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
+    sx1262_readCommand(dev, CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
     
     uint8_t rxPacketLen = rxStatus[0]; // Payload length from RX buffer status
     uint8_t offset = rxStatus[1];      // RX start buffer pointer
@@ -402,103 +808,214 @@ void sx1262_direct_readFifo(uint8_t* data, uint8_t len) {
     }
     
     // Read buffer
-    uint8_t readCmd[2];
-    readCmd[0] = offset;  // Offset
-    readCmd[1] = packetLen;  // Length
-    
-    waitForBusy();
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
-    
-    SPI.transfer(CMD_READ_BUFFER);
-    SPI.transfer(readCmd[0]);
-    SPI.transfer(readCmd[1]);
-    for (uint8_t i = 0; i < packetLen; i++) {
-        data[i] = SPI.transfer(0x00);
-    }
-    
-    digitalWrite(pin_nss, HIGH);
-    SPI.endTransaction();
-    
-    waitForBusy();
+    uint8_t header[3];
+    header[0] = CMD_READ_BUFFER;
+    header[1] = offset;     // Offset
+    header[2] = packetLen;  // Length
+    sx1262_transaction(dev, header, 3, nullptr, data, packetLen);
     
     // Get RSSI and SNR from packet status
     uint8_t status[3];
-    sx1262_readCommand(CMD_GET_PACKET_STATUS, status, 3);
-    last_rssi = -(status[0] / 2); // RSSI in dBm
-    last_snr = ((int8_t)status[1]) / 4; // SNR in dB
+    sx1262_readCommand(dev, CMD_GET_PACKET_STATUS, status, 3);
+    dev->lastRssi = -(status[0] / 2); // RSSI in dBm
+    dev->lastSnr = ((int8_t)status[1]) / 4; // SNR in dB
     
     // Save packet length BEFORE clearing IRQ flags (which resets last_packet_length)
-    last_packet_length = packetLen;
+    dev->lastPacketLength = packetLen;
     
     // Note: Don't clear IRQ flags here - let the caller do it after getting the length
     // Clearing here would reset last_packet_length to 0, making getPacketLength() fail
     
     // Restart RX if we were in RX mode
-    if (current_mode == 0x05) {
-        sx1262_direct_setMode(0x05);
+    if (dev->mode == 0x05) {
+        sx1262_direct_setMode(dev, 0x05);
+    }
+}
+
+// Read out a completed frame as two command batches instead of one BUSY-gated
+// transaction per getter: IRQ, RX buffer and packet status back to back,
+// then the payload read and (optionally) the IRQ clear. Unless `anyFrame`,
+// nothing is read past the status when RX_DONE is not set.
+static bool fetchFrame(Sx1262Direct* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame, bool anyFrame, bool clearIrq) {
+    uint8_t irqStatus[2];
+    uint8_t rxStatus[2];        // Payload length, RX start buffer pointer
+    uint8_t packetStatus[3];    // RSSI, SNR, signal RSSI
+    const uint8_t getIrq[2] = {CMD_GET_IRQ_STATUS, 0x00};
+    const uint8_t getRxBuffer[2] = {CMD_GET_RX_BUFFER_STATUS, 0x00};
+    const uint8_t getPacket[2] = {CMD_GET_PACKET_STATUS, 0x00};
+    Sx1262Command commands[3];
+    setCommand(&commands[0], getIrq, 2, nullptr, irqStatus, 2);
+    setCommand(&commands[1], getRxBuffer, 2, nullptr, rxStatus, 2);
+    setCommand(&commands[2], getPacket, 2, nullptr, packetStatus, 3);
+    if (!sx1262_runBatch(dev, commands, 3)) {
+        return false;
+    }
+    
+    uint16_t irq = ((uint16_t)irqStatus[0] << 8) | irqStatus[1];
+    if (!anyFrame && (irq & IRQ_RX_DONE) == 0) {
+        return false;
+    }
+    frame->rxLength = rxStatus[0];
+    frame->length = (rxStatus[0] <= maxLen) ? rxStatus[0] : 0;
+    frame->rssi = -(packetStatus[0] / 2);
+    frame->snr = ((int8_t)packetStatus[1]) / 4;
+    frame->crcError = (irq & (IRQ_CRC_ERROR | IRQ_HEADER_ERROR)) != 0;
+    
+    // ReadBuffer: opcode, offset, status (NOP), then the payload
+    const uint8_t readBuffer[3] = {CMD_READ_BUFFER, rxStatus[1], 0x00};
+    const uint8_t clearIrqHeader[1] = {CMD_CLEAR_IRQ_STATUS};
+    const uint8_t clearAll[2] = {0xFF, 0xFF};
+    uint8_t count = 0;
+    if (frame->length > 0) {
+        setCommand(&commands[count++], readBuffer, 3, nullptr, data, frame->length);
+    }
+    if (clearIrq) {
+        setCommand(&commands[count++], clearIrqHeader, 1, clearAll, nullptr, 2);
     }
+    if (count > 0 && !sx1262_runBatch(dev, commands, count)) {
+        frame->length = 0;
+    }
+    
+    dev->lastPacketLength = frame->length;
+    dev->lastRssi = frame->rssi;
+    dev->lastSnr = frame->snr;
+    if (clearIrq) {
+        dev->packetReceived = false;
+    }
+    return true;
+}
+
+bool sx1262_direct_fetchFrame(Sx1262Direct* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    return fetchFrame(dev, data, maxLen, frame, false, true);
 }
 
-int16_t sx1262_direct_getRssi() {
+int16_t sx1262_direct_getRssi(Sx1262Direct* dev) {
     uint8_t status[3];
-    sx1262_readCommand(CMD_GET_PACKET_STATUS, status, 3);
+    sx1262_readCommand(dev, CMD_GET_PACKET_STATUS, status, 3);
     return -(status[0] / 2); // RSSI in dBm
 }
 
-int8_t sx1262_direct_getSnr() {
+int8_t sx1262_direct_getSnr(Sx1262Direct* dev) {
     uint8_t status[3];
-    sx1262_readCommand(CMD_GET_PACKET_STATUS, status, 3);
+    sx1262_readCommand(dev, CMD_GET_PACKET_STATUS, status, 3);
     return ((int8_t)status[1]) / 4; // SNR in dB
 }
 
-uint8_t sx1262_direct_getPacketLength() {
+int16_t sx1262_direct_getRssiInst(Sx1262Direct* dev) {
+    uint8_t status[1];
+    sx1262_readCommand(dev, CMD_GET_RSSI_INST, status, 1);
+    return -(status[0] / 2); // RSSI in dBm
+}
+
+uint8_t sx1262_direct_getPacketLength(Sx1262Direct* dev) {
     // Always read RX buffer status directly (like RadioLib does)
     // Don't rely on cached value as it may be stale
     uint8_t rxStatus[2];
-    sx1262_readCommand(CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
+    sx1262_readCommand(dev, CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
     uint8_t packetLen = rxStatus[0]; // Payload length
     
     // Update cache for consistency
-    last_packet_length = packetLen;
+    dev->lastPacketLength = packetLen;
     
     return packetLen;
 }
 
-bool sx1262_direct_isPacketReceived() {
-    if (packet_received_flag) {
+bool sx1262_direct_isPacketReceived(Sx1262Direct* dev) {
+    if (dev->packetReceived) {
         return true;
     }
     
     // Check IRQ status
     uint8_t irqStatus[2];
-    sx1262_readCommand(CMD_GET_IRQ_STATUS, irqStatus, 2);
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
     return (irqStatus[1] & IRQ_RX_DONE) != 0;
 }
 
-void sx1262_direct_clearIrqFlags() {
+bool sx1262_direct_isTransmitDone(Sx1262Direct* dev) {
+    uint8_t irqStatus[2];
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
+    return (irqStatus[1] & IRQ_TX_DONE) != 0;
+}
+
+bool sx1262_direct_isCadDone(Sx1262Direct* dev) {
+    uint8_t irqStatus[2];
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
+    return (irqStatus[1] & IRQ_CAD_DONE) != 0;
+}
+
+bool sx1262_direct_isChannelActive(Sx1262Direct* dev) {
+    uint8_t irqStatus[2];
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
+    return (irqStatus[0] & (IRQ_CAD_DETECTED >> 8)) != 0;
+}
+
+bool sx1262_direct_isReceiving(Sx1262Direct* dev) {
+    // HEADER_VALID rather than PREAMBLE_DETECTED: a preamble detection on noise
+    // latches with nothing to clear it, a valid header is always followed by RX_DONE
+    uint8_t irqStatus[2];
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
+    return (irqStatus[1] & IRQ_HEADER_VALID) != 0 && (irqStatus[1] & IRQ_RX_DONE) == 0;
+}
+
+void sx1262_direct_clearIrqFlags(Sx1262Direct* dev) {
     uint8_t clearIrq[2] = {0xFF, 0xFF}; // Clear all IRQs
-    sx1262_sendCommand(CMD_CLEAR_IRQ_STATUS, clearIrq, 2);
-    packet_received_flag = false;
-    last_packet_length = 0; // Reset cached length after clearing IRQ
+    sx1262_sendCommand(dev, CMD_CLEAR_IRQ_STATUS, clearIrq, 2);
+    dev->packetReceived = false;
+    dev->lastPacketLength = 0; // Reset cached length after clearing IRQ
+}
+
+bool sx1262_direct_benchmarkFifoRead(Sx1262Direct* dev, SpiBenchmark* result) {
+    // The benchmark drives the SPI itself - let queued commands finish first
+    if (dev->pinNss < 0 || !drainQueue(dev)) return false;
+    while (!claimBus(dev)) {
+        platform_spiPoll();  // The other radio's command finishes and frees the bus
+    }
+    
+    // ReadBuffer: opcode, offset, status (NOP), then the payload
+    const uint8_t header[3] = {CMD_READ_BUFFER, 0x00, 0x00};
+    spi_bench_fifoRead(dev->pinNss, dev->pinBusy, dev->spiFreq, header, sizeof(header), SPI_BENCH_PAYLOAD_MAX, result);
+    busOwner = nullptr;
+    
+    // Read out whatever frame the buffer holds, leaving the IRQs alone: the
+    // getter sequence the RX path used to run, then one fetchFrame()
+    uint8_t frameData[SPI_BENCH_PAYLOAD_MAX];
+    RadioFrame frame;
+    unsigned long startUs = micros();
+    for (uint8_t run = 0; run < SPI_BENCH_RUNS; run++) {
+        sx1262_direct_isPacketReceived(dev);
+        uint8_t len = sx1262_direct_getPacketLength(dev);
+        sx1262_direct_readFifo(dev, frameData, len);
+        sx1262_direct_getPacketLength(dev);
+        sx1262_direct_getRssi(dev);
+        sx1262_direct_getSnr(dev);
+    }
+    result->rxGettersUs = (micros() - startUs) / SPI_BENCH_RUNS;
+    
+    startUs = micros();
+    for (uint8_t run = 0; run < SPI_BENCH_RUNS; run++) {
+        fetchFrame(dev, frameData, SPI_BENCH_PAYLOAD_MAX, &frame, true, false);
+    }
+    result->rxFetchUs = (micros() - startUs) / SPI_BENCH_RUNS;
+    result->rxBytes = frame.length;
+    return true;
 }
 
-void sx1262_direct_attachInterrupt(void (*handler)()) {
-    user_interrupt_handler = handler;
-    if (pin_dio1 >= 0) {
-        attachInterrupt(digitalPinToInterrupt(pin_dio1), sx1262_irq_handler, RISING);
+void sx1262_direct_attachInterrupt(Sx1262Direct* dev, void (*handler)()) {
+    dev->interruptHandler = handler;
+    if (dev->pinDio1 >= 0) {
+        attachInterrupt(digitalPinToInterrupt(dev->pinDio1), irqEntries[dev->index], RISING);
     }
 }
 
-uint16_t sx1262_direct_getIrqFlags() {
+uint16_t sx1262_direct_getIrqFlags(Sx1262Direct* dev) {
     uint8_t irqStatus[2];
-    sx1262_readCommand(CMD_GET_IRQ_STATUS, irqStatus, 2);
+    sx1262_readCommand(dev, CMD_GET_IRQ_STATUS, irqStatus, 2);
     // Return 16-bit IRQ status: MSB in [0], LSB in [1]
     return ((uint16_t)irqStatus[0] << 8) | irqStatus[1];
 }
 
-bool sx1262_direct_hasPacketErrors() {
-    uint16_t irqFlags = sx1262_direct_getIrqFlags();
+bool sx1262_direct_hasPacketErrors(Sx1262Direct* dev) {
+    uint16_t irqFlags = sx1262_direct_getIrqFlags(dev);
     // Check CRC error (bit 6 in LSB = 0x0040) and header error (bit 5 in LSB = 0x0020)
     // IRQ flags: [MSB][LSB], errors are in LSB byte
     if (irqFlags & 0x0040) { // IRQ_CRC_ERROR
@@ -510,15 +1027,17 @@ bool sx1262_direct_hasPacketErrors() {
     return false; // No errors detected
 }
 
-uint8_t sx1262_direct_readRegister(uint8_t reg) {
+uint8_t sx1262_direct_readRegister(Sx1262Direct* dev, uint8_t reg) {
     // Compatibility function - SX1262 uses 16-bit addresses
     uint8_t data[1];
-    sx1262_readReg((uint16_t)reg, data, 1);
+    sx1262_readReg(dev, (uint16_t)reg, data, 1);
     return data[0];
 }
 
-void sx1262_direct_writeRegister(uint8_t reg, uint8_t value) {
+void sx1262_direct_writeRegister(Sx1262Direct* dev, uint8_t reg, uint8_t value) {
+    // A raw write may change anything the shadow describes
+    radio_shadow_invalidate(&dev->shadow);
     // Compatibility function - SX1262 uses 16-bit addresses
     uint8_t data[1] = {value};
-    sx1262_writeReg((uint16_t)reg, data, 1);
+    sx1262_writeReg(dev, (uint16_t)reg, data, 1);
 }
@@ -3,6 +3,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../radio_profile.h"
+#include "../spi_bench.h"
+#include "../radio_frame.h"
+#include "../radio_shadow.h"
+#include "../../platforms/platform_interface.h"
 
 // SX1262 Command Definitions (direct SPI implementation)
 // SX1262 uses command-based SPI protocol (not register-based like SX1276)
@@ -15,6 +20,7 @@
 #define CMD_SET_RX                  0x82
 #define CMD_SET_RX_DUTY_CYCLE       0x94
 #define CMD_SET_CAD                 0xC5
+#define CMD_SET_CAD_PARAMS          0x88
 #define CMD_SET_TX_CONTINUOUS_WAVE  0xD1
 #define CMD_SET_TX_INFINITE_PREAMBLE 0xD2
 #define CMD_SET_REGULATOR_MODE      0x96
@@ -32,7 +38,10 @@
 #define CMD_SET_DIO2_AS_RF_SWITCH_CTRL 0x9D
 #define CMD_SET_DIO3_AS_TCXO_CTRL   0x97
 #define CMD_SET_RF_FREQUENCY        0x86
+#define CMD_SET_MODULATION_PARAMS   0x8B
+#define CMD_SET_PACKET_PARAMS       0x8C
 #define CMD_GET_PACKET_STATUS       0x14
+#define CMD_GET_RSSI_INST           0x15
 #define CMD_GET_RX_BUFFER_STATUS    0x13
 
 // Register Addresses (for WriteRegister/ReadRegister commands)
@@ -70,36 +79,127 @@
 #define SX1262_MIN_FREQUENCY_HZ  150000000UL
 #define SX1262_MAX_FREQUENCY_HZ  960000000UL
 
-// Function Prototypes (matching sx1276_direct.h API)
-bool sx1262_direct_init();
+// Asynchronous command engine
+// Commands run in submission order. The next transfer starts from the BUSY
+// falling-edge interrupt as soon as the radio is ready; a command that keeps
+// BUSY high past its timeout flushes the queue and raises a radio fault
+// (radio_busy.h) that only sx1262_direct_init() clears. The synchronous
+// functions below go through the same queue.
+#define SX1262_CMD_HEADER_MAX       4   // Opcode + address/offset bytes
+#define SX1262_CMD_QUEUE_BATCHES    4
+
+typedef struct {
+    uint8_t header[SX1262_CMD_HEADER_MAX];  // Opcode first
+    uint8_t headerLen;
+    const uint8_t* txData;      // Parameters / payload (null: clock out 0x00)
+    uint8_t* rxData;            // Response (may be null)
+    uint16_t dataLen;
+    uint32_t timeoutUs;         // Longest BUSY may stay high afterwards (0 = RADIO_BUSY_TIMEOUT_US)
+} Sx1262Command;
+
+// Radios one build can drive (each needs its own interrupt entry points)
+#define SX1262_DIRECT_MAX_INSTANCES 2
+
+typedef struct {
+    const Sx1262Command* commands;
+    uint8_t count;
+    volatile bool finished;
+    bool ok;
+    void (*done)(bool ok, void* context);
+    void* context;
+} CommandBatch;
+
+// One SX1262 on its own pins. Every function takes the radio it acts on; the
+// caller owns the storage (zero-initialized) and calls init first. Radios on
+// the same SPI bus take turns: a command holds the bus from its header to
+// the end of its data, the other radio's next command waits for it.
+typedef struct {
+    int8_t pinNss;
+    int8_t pinReset;
+    int8_t pinBusy;
+    int8_t pinDio1;
+    int8_t pinPowerEn;
+    uint8_t index;                  // Interrupt entry points used
+    uint32_t spiFreq;
+    
+    uint8_t mode;                   // Last setMode() mode
+    uint8_t sf;                     // Used to pick the CAD detection peak
+    uint8_t lastPacketLength;
+    int16_t lastRssi;
+    int8_t lastSnr;
+    volatile bool packetReceived;
+    void (*interruptHandler)();
+    
+    // Last applied modem configuration - unchanged parameters are not re-sent
+    RadioShadow shadow;
+    
+    // Command engine
+    CommandBatch queue[SX1262_CMD_QUEUE_BATCHES];
+    uint8_t queueTail;              // Oldest batch not yet reported
+    uint8_t queueLen;               // Batches not yet reported
+    volatile uint8_t queueRun;      // Batch being run
+    volatile uint8_t queueUnrun;    // Batches not yet run to the end
+    volatile uint8_t commandIndex;
+    volatile uint8_t engineState;
+    volatile uint32_t busyStartUs;
+    volatile uint32_t busyTimeoutUs;
+    volatile bool sleeping;         // SetSleep sent - BUSY stays high until woken
+    volatile bool waking;           // Current BUSY wait is the wake-up, not a command
+    
+    // Commands of the profile switch in flight (they point into the profile)
+    Sx1262Command profileCommands[4];
+    volatile bool profilePending;
+    uint32_t profileStartUs;
+} Sx1262Direct;
+
+// Queue `count` commands; done(ok, context) is called from sx1262_direct_poll()
+// once the last one has released BUSY (ok = false if a fault flushed them).
+// The commands and their buffers must stay valid until then.
+// False if the queue is full or the radio has faulted.
+bool sx1262_direct_submit(Sx1262Direct* dev, const Sx1262Command* commands, uint8_t count,
+                          void (*done)(bool ok, void* context), void* context);
+void sx1262_direct_poll(Sx1262Direct* dev);  // Completes transfers, checks timeouts, reports batches
+bool sx1262_direct_isIdle(Sx1262Direct* dev);
+
+// Function Prototypes (matching sx1276_direct.h API, plus the instance)
+bool sx1262_direct_init(Sx1262Direct* dev, uint8_t index, const RadioPins* pins);
 uint32_t sx1262_direct_getMinFrequency();
 uint32_t sx1262_direct_getMaxFrequency();
-void sx1262_direct_setFrequency(uint32_t freq_hz);
-void sx1262_direct_setPower(uint8_t power);
-void sx1262_direct_setPreambleLength(uint16_t length);
-void sx1262_direct_setCrc(bool enable);
-void sx1262_direct_setSyncWord(uint8_t syncWord);
-void sx1262_direct_setHeaderMode(bool implicit);
-void sx1262_direct_setBandwidth(uint8_t bw);
-void sx1262_direct_setSpreadingFactor(uint8_t sf);
-void sx1262_direct_setCodingRate(uint8_t cr);
-void sx1262_direct_setInvertIQ(bool invert);
-void sx1262_direct_setMode(uint8_t mode);
-void sx1262_direct_writeFifo(uint8_t* data, uint8_t len);
-void sx1262_direct_readFifo(uint8_t* data, uint8_t len);
-int16_t sx1262_direct_getRssi();
-int8_t sx1262_direct_getSnr();
-uint8_t sx1262_direct_readRegister(uint8_t reg);
-void sx1262_direct_writeRegister(uint8_t reg, uint8_t value);
-void sx1262_direct_attachInterrupt(void (*handler)());
+void sx1262_direct_setFrequency(Sx1262Direct* dev, uint32_t freq_hz);
+void sx1262_direct_setPower(Sx1262Direct* dev, uint8_t power);
+void sx1262_direct_setPreambleLength(Sx1262Direct* dev, uint16_t length);
+void sx1262_direct_setCrc(Sx1262Direct* dev, bool enable);
+void sx1262_direct_setSyncWord(Sx1262Direct* dev, uint8_t syncWord);
+void sx1262_direct_setHeaderMode(Sx1262Direct* dev, bool implicit);
+void sx1262_direct_setBandwidth(Sx1262Direct* dev, uint8_t bw);
+void sx1262_direct_setSpreadingFactor(Sx1262Direct* dev, uint8_t sf);
+void sx1262_direct_setCodingRate(Sx1262Direct* dev, uint8_t cr);
+void sx1262_direct_setInvertIQ(Sx1262Direct* dev, bool invert);
+void sx1262_direct_compileProfile(const RadioSettings* settings, RadioProfile* profile);
+void sx1262_direct_applyProfile(Sx1262Direct* dev, const RadioProfile* profile);
+bool sx1262_direct_benchmarkFifoRead(Sx1262Direct* dev, SpiBenchmark* result);
+void sx1262_direct_setMode(Sx1262Direct* dev, uint8_t mode);
+void sx1262_direct_writeFifo(Sx1262Direct* dev, uint8_t* data, uint8_t len);
+void sx1262_direct_readFifo(Sx1262Direct* dev, uint8_t* data, uint8_t len);
+bool sx1262_direct_fetchFrame(Sx1262Direct* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame);
+int16_t sx1262_direct_getRssi(Sx1262Direct* dev);
+int8_t sx1262_direct_getSnr(Sx1262Direct* dev);
+int16_t sx1262_direct_getRssiInst(Sx1262Direct* dev);
+uint8_t sx1262_direct_readRegister(Sx1262Direct* dev, uint8_t reg);
+void sx1262_direct_writeRegister(Sx1262Direct* dev, uint8_t reg, uint8_t value);
+void sx1262_direct_attachInterrupt(Sx1262Direct* dev, void (*handler)());
 
 // Get IRQ status flags (returns 16-bit value: MSB in [0], LSB in [1])
-uint16_t sx1262_direct_getIrqFlags();
+uint16_t sx1262_direct_getIrqFlags(Sx1262Direct* dev);
 
 // Check if received packet has CRC or header errors
-bool sx1262_direct_hasPacketErrors();
-bool sx1262_direct_isPacketReceived();
-uint8_t sx1262_direct_getPacketLength();
-void sx1262_direct_clearIrqFlags();
+bool sx1262_direct_hasPacketErrors(Sx1262Direct* dev);
+bool sx1262_direct_isPacketReceived(Sx1262Direct* dev);
+bool sx1262_direct_isTransmitDone(Sx1262Direct* dev);
+bool sx1262_direct_isCadDone(Sx1262Direct* dev);
+bool sx1262_direct_isChannelActive(Sx1262Direct* dev);
+bool sx1262_direct_isReceiving(Sx1262Direct* dev);
+uint8_t sx1262_direct_getPacketLength(Sx1262Direct* dev);
+void sx1262_direct_clearIrqFlags(Sx1262Direct* dev);
 
 #endif // SX1262_DIRECT_H
@@ -28,35 +28,123 @@ extern SPIClass SPI;
 
 // Then include our headers (which may reference RadioLib types)
 #include "sx1262_radiolib.h"
+#include "../radio_shadow.h"
+#include "../radio_busy.h"
+#include "../radio_turnaround.h"
 #include "../../platforms/platform_interface.h"
 // Note: We use numeric constants (0x00, 0x01, 0x03, 0x05) in switch statements
 // to avoid conflicts with RadioLib's Module::MODE_* enum
 
-// RadioLib module instance
-static Module* radioModule = nullptr;
-static SX1262* radio = nullptr;
+// RadioLib's Arduino HAL clocks one SPI.transfer() per byte. Hand each
+// transaction (RadioLib drives NSS and BUSY around it) to the platform as one
+// bulk transfer instead - a single EasyDMA job on RAK4631.
+// RadioLib also polls BUSY through the HAL before and after each command:
+// every high stretch is timed, and one that outlasts RADIO_BUSY_TIMEOUT_US
+// raises a radio fault (RadioLib itself only gives up after a second).
+class BulkSpiHal : public ArduinoHal {
+public:
+    BulkSpiHal(SPIClass& spi, SPISettings spiSettings, uint32_t busyPin)
+        : ArduinoHal(spi, spiSettings), busyPin(busyPin) {}
+    
+    void spiTransfer(uint8_t* out, size_t len, uint8_t* in) override {
+        platform_spiTransfer(out, in, (uint16_t)len);
+    }
+    
+    uint32_t digitalRead(uint32_t pin) override {
+        uint32_t level = ArduinoHal::digitalRead(pin);
+        if (pin != busyPin) {
+            return level;
+        }
+        
+        uint32_t nowUs = micros();
+        if (level == HIGH) {
+            if (!busyWaiting) {
+                busyWaiting = true;
+                busyTimedOut = false;
+                busyStartUs = nowUs;
+            } else if (!busyTimedOut && nowUs - busyStartUs >= RADIO_BUSY_TIMEOUT_US) {
+                busyTimedOut = true;
+                radio_busy_raiseFault();
+            }
+        } else if (busyWaiting) {
+            busyWaiting = false;
+            radio_busy_recordWait(nowUs - busyStartUs);
+        }
+        return level;
+    }
+    
+private:
+    uint32_t busyPin;
+    bool busyWaiting = false;
+    bool busyTimedOut = false;
+    uint32_t busyStartUs = 0;
+};
 
-// Interrupt handler
-static void (*interruptHandler)() = nullptr;
+// SX126x SetDioIrqParams opcode (sent raw, see enableHeaderValidIrq)
+#define SX1262_CMD_SET_DIO_IRQ_PARAMS 0x08
+// SX126x ClearIrqStatus opcode (sent raw, see fetchFrame)
+#define SX1262_CMD_CLEAR_IRQ_STATUS 0x02
 
-// Buffer for pending transmission
-static uint8_t* pendingTxData = nullptr;
-static uint8_t pendingTxLen = 0;
+// RadioLib's startTransmit() sets the TX modulation quality bit for the
+// bandwidth (SX126x errata 15.1); a preloaded transmit bypasses it
+#define SX1262_REG_TX_MODULATION 0x0889
 
-// Interrupt service routine
-static void sx1262_isr() {
-    if (interruptHandler != nullptr) {
-        interruptHandler();
+// RadioLib calls its interrupt actions without arguments - one entry point
+// per instance slot finds the radio that raised DIO1
+static Sx1262RadioLib* isrInstances[SX1262_RADIOLIB_MAX_INSTANCES];
+
+static void dispatchIsr(Sx1262RadioLib* dev) {
+    if (dev == nullptr) {
+        return;
+    }
+    if (dev->mode == 0x03) {
+        dev->txDoneUs = micros();
+        dev->txDoneSeen = true;
+    }
+    if (dev->preloadListening && dev->preloadRxEvents < 255) {
+        dev->preloadRxEvents++;
+    }
+    if (dev->interruptHandler != nullptr) {
+        dev->interruptHandler();
     }
 }
 
-bool sx1262_radiolib_init() {
-    // Get pin numbers from platform interface
-    int8_t pin_nss = platform_getRadioNssPin();
-    int8_t pin_reset = platform_getRadioResetPin();
-    int8_t pin_dio1 = platform_getRadioDio1Pin();
-    int8_t pin_busy = platform_getRadioBusyPin();
-    int8_t pin_power_en = platform_getRadioPowerEnablePin();
+static void sx1262_isr0() { dispatchIsr(isrInstances[0]); }
+static void sx1262_isr1() { dispatchIsr(isrInstances[1]); }
+
+static void (*const isrEntries[SX1262_RADIOLIB_MAX_INSTANCES])() = { sx1262_isr0, sx1262_isr1 };
+
+bool sx1262_radiolib_init(Sx1262RadioLib* dev, uint8_t index, const RadioPins* pins) {
+    radio_shadow_invalidate(&dev->shadow);
+    dev->preloadValid = false;
+    dev->preloadArmed = false;
+    dev->preloadListening = false;
+    dev->txModulationSet = false;
+    dev->fastTurnaround = false;
+    dev->imageBand = 0;
+    dev->mode = 0x01;
+    dev->rxLeft = false;
+    dev->txDoneSeen = false;
+    if (index >= SX1262_RADIOLIB_MAX_INSTANCES) {
+        return false;
+    }
+    dev->pinNss = pins->nss;
+    dev->pinBusy = pins->busy;
+    
+    // Called again to recover from a radio fault - drop the old instances
+    delete dev->radio;
+    dev->radio = nullptr;
+    delete dev->module;
+    dev->module = nullptr;
+    delete dev->hal;
+    dev->hal = nullptr;
+    
+    // Pins of this radio (platform_getRadioPins())
+    int8_t pin_nss = pins->nss;
+    int8_t pin_reset = pins->reset;
+    int8_t pin_dio1 = pins->dio1;
+    int8_t pin_busy = pins->busy;
+    int8_t pin_power_en = pins->powerEnable;
     uint32_t spi_freq = platform_getSpiFrequency();
     
     // Validate required pins
@@ -112,20 +200,25 @@ bool sx1262_radiolib_init() {
     // Create RadioLib module
     // SX1262 uses DIO1 for interrupts, BUSY pin for busy indication
     // Note: RadioLib Module constructor accepts -1 for reset pin (no reset)
-    radioModule = new Module(pin_nss, pin_dio1, pin_reset, pin_busy, SPI, SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
+    dev->hal = new BulkSpiHal(SPI, SPISettings(spi_freq, MSBFIRST, SPI_MODE0), pin_busy);
+    dev->module = new Module(dev->hal, pin_nss, pin_dio1, pin_reset, pin_busy);
     
-    if (radioModule == nullptr) {
+    if (dev->module == nullptr) {
         // Failed to allocate module
+        delete dev->hal;
+        dev->hal = nullptr;
         return false;
     }
     
     // Create SX1262 instance
-    radio = new SX1262(radioModule);
+    dev->radio = new SX1262(dev->module);
     
-    if (radio == nullptr) {
+    if (dev->radio == nullptr) {
         // Failed to allocate radio
-        delete radioModule;
-        radioModule = nullptr;
+        delete dev->module;
+        dev->module = nullptr;
+        delete dev->hal;
+        dev->hal = nullptr;
         return false;
     }
     
@@ -140,7 +233,7 @@ bool sx1262_radiolib_init() {
     //   uint8_t cr = 7, uint8_t syncWord = RADIOLIB_SX126X_SYNC_WORD_PRIVATE, int8_t power = 10, 
     //   uint16_t preambleLength = 8, float tcxoVoltage = 0.0, bool useRegulatorLDO = false)
     // CRITICAL: Pass tcxoVoltage for boards with TCXO (like RAK4631 which needs 1.8V on DIO3)
-    int state = radio->begin(
+    int state = dev->radio->begin(
         434.0,                                 // freq (will be reconfigured by protocol)
         125.0,                                 // bw (will be reconfigured by protocol)
         9,                                     // sf (will be reconfigured by protocol)
@@ -155,23 +248,35 @@ bool sx1262_radiolib_init() {
     if (state != RADIOLIB_ERR_NONE) {
         // Radio initialization failed - could be SPI communication issue or hardware problem
         // Clean up allocated objects
-        delete radio;
-        radio = nullptr;
-        delete radioModule;
-        radioModule = nullptr;
+        delete dev->radio;
+        dev->radio = nullptr;
+        delete dev->module;
+        dev->module = nullptr;
+        delete dev->hal;
+        dev->hal = nullptr;
         return false;
     }
     
     // Configure DIO2 as RF switch control if platform requires it
     // This is CRITICAL for RAK4631 - DIO2 controls the antenna switch
     if (useDio2AsRfSwitch) {
-        radio->setDio2AsRfSwitch(true);
+        dev->radio->setDio2AsRfSwitch(true);
     }
     
+    // Fast turnaround: after TX_DONE / RX_DONE the chip drops to STDBY_XOSC
+    // instead of STDBY_RC, so the TCXO is still running for the next SetRx/SetTx
+    dev->fastTurnaround = platform_useFastTurnaround();
+    if (dev->fastTurnaround) {
+        uint8_t fallbackMode = RADIOLIB_SX126X_RX_TX_FALLBACK_MODE_STDBY_XOSC;
+        dev->module->SPIwriteStream(RADIOLIB_SX126X_CMD_SET_RX_TX_FALLBACK_MODE, &fallbackMode, 1);
+    }
+    radio_turnaround_setFastMode(dev->fastTurnaround);
+    
     // Set DIO1 interrupt mapping (TX_DONE and RX_DONE)
     // Use setPacketReceivedAction and setPacketSentAction which handle interrupt setup internally
-    radio->setPacketReceivedAction(sx1262_isr);
-    radio->setPacketSentAction(sx1262_isr);
+    isrInstances[index] = dev;
+    dev->radio->setPacketReceivedAction(isrEntries[index]);
+    dev->radio->setPacketSentAction(isrEntries[index]);
     
     return true;
 }
@@ -184,179 +289,547 @@ uint32_t sx1262_radiolib_getMaxFrequency() {
     return SX1262_MAX_FREQUENCY_HZ;
 }
 
-void sx1262_radiolib_setFrequency(uint32_t freq_hz) {
-    if (radio != nullptr) {
-        radio->setFrequency((float)freq_hz / 1000000.0);
+// Send `param` only if it changed; a rejected value leaves it unknown so the
+// next call retries it
+static bool shadowChanged(Sx1262RadioLib* dev, RadioParam param, uint32_t value) {
+    return dev->radio != nullptr && radio_shadow_update(&dev->shadow, param, value);
+}
+
+static void checkApplied(Sx1262RadioLib* dev, RadioParam param, int16_t state) {
+    if (state != RADIOLIB_ERR_NONE) {
+        radio_shadow_forget(&dev->shadow, param);
     }
 }
 
-void sx1262_radiolib_setPower(uint8_t power) {
-    if (radio != nullptr) {
-        radio->setOutputPower(power);
+// Image calibration band (SX126x datasheet 9.2.1, as RadioLib calibrates it)
+// holding `freq_hz`; outside the listed bands, the 4 MHz steps around it
+static void imageBand(uint32_t freq_hz, uint8_t band[2]) {
+    if (freq_hz > 900000000UL) {
+        band[0] = 0xE1; band[1] = 0xE9;     // 902 - 928 MHz
+    } else if (freq_hz > 850000000UL) {
+        band[0] = 0xD7; band[1] = 0xDB;     // 863 - 870 MHz
+    } else if (freq_hz > 770000000UL) {
+        band[0] = 0xC1; band[1] = 0xC5;     // 779 - 787 MHz
+    } else if (freq_hz > 460000000UL) {
+        band[0] = 0x75; band[1] = 0x81;     // 470 - 510 MHz
+    } else if (freq_hz > 425000000UL) {
+        band[0] = 0x6B; band[1] = 0x6F;     // 430 - 440 MHz
+    } else {
+        band[0] = (uint8_t)((freq_hz - 1000000UL) / 4000000UL);
+        band[1] = (uint8_t)((freq_hz + 1000000UL + 3999999UL) / 4000000UL);
     }
 }
 
-void sx1262_radiolib_setPreambleLength(uint16_t length) {
-    if (radio != nullptr) {
-        radio->setPreambleLength(length);
+// Tune to `freq_hz` through RadioLib, so its cached frequency stays right.
+// Without fast turnaround, setFrequency() calibrates the image on every
+// call. In fast turnaround mode it calibrates only when the band differs
+// from the one last calibrated - MeshCore and Meshtastic share the
+// 902 - 928 MHz band.
+static int16_t applyFrequency(Sx1262RadioLib* dev, uint32_t freq_hz, float freqMHz) {
+    if (!dev->fastTurnaround) {
+        return dev->radio->setFrequency(freqMHz);
     }
+    
+    uint8_t band[2];
+    imageBand(freq_hz, band);
+    uint16_t bandKey = ((uint16_t)band[0] << 8) | band[1];
+    bool calibrate = bandKey != dev->imageBand;
+    int16_t state = dev->radio->setFrequency(freqMHz, !calibrate);
+    if (state != RADIOLIB_ERR_NONE) {
+        // A failed calibration leaves the band unknown
+        if (calibrate) {
+            dev->imageBand = 0;
+        }
+        return state;
+    }
+    if (calibrate) {
+        dev->imageBand = bandKey;
+    }
+    radio_turnaround_recordCalibration(calibrate);
+    return state;
 }
 
-void sx1262_radiolib_setCrc(bool enable) {
-    if (radio != nullptr) {
-        radio->setCRC(enable ? 2 : 0); // 0 = disabled, 2 = enabled
+void sx1262_radiolib_setFrequency(Sx1262RadioLib* dev, uint32_t freq_hz) {
+    if (shadowChanged(dev, RADIO_PARAM_FREQUENCY, freq_hz)) {
+        checkApplied(dev, RADIO_PARAM_FREQUENCY, applyFrequency(dev, freq_hz, (float)freq_hz / 1000000.0));
     }
 }
 
-void sx1262_radiolib_setSyncWord(uint8_t syncWord) {
-    if (radio != nullptr) {
-        radio->setSyncWord(syncWord);
+void sx1262_radiolib_setPower(Sx1262RadioLib* dev, uint8_t power) {
+    if (shadowChanged(dev, RADIO_PARAM_POWER, power)) {
+        checkApplied(dev, RADIO_PARAM_POWER, dev->radio->setOutputPower(power));
     }
 }
 
-void sx1262_radiolib_setHeaderMode(bool implicit) {
-    if (radio != nullptr) {
+void sx1262_radiolib_setPreambleLength(Sx1262RadioLib* dev, uint16_t length) {
+    if (shadowChanged(dev, RADIO_PARAM_PREAMBLE, length)) {
+        checkApplied(dev, RADIO_PARAM_PREAMBLE, dev->radio->setPreambleLength(length));
+    }
+}
+
+void sx1262_radiolib_setCrc(Sx1262RadioLib* dev, bool enable) {
+    if (shadowChanged(dev, RADIO_PARAM_CRC, enable)) {
+        checkApplied(dev, RADIO_PARAM_CRC, dev->radio->setCRC(enable ? 2 : 0)); // 0 = disabled, 2 = enabled
+    }
+}
+
+void sx1262_radiolib_setSyncWord(Sx1262RadioLib* dev, uint8_t syncWord) {
+    if (shadowChanged(dev, RADIO_PARAM_SYNC_WORD, syncWord)) {
+        checkApplied(dev, RADIO_PARAM_SYNC_WORD, dev->radio->setSyncWord(syncWord));
+    }
+}
+
+void sx1262_radiolib_setHeaderMode(Sx1262RadioLib* dev, bool implicit) {
+    if (shadowChanged(dev, RADIO_PARAM_HEADER_MODE, implicit)) {
         if (implicit) {
-            radio->implicitHeader(0xFF); // Use max length for implicit header
+            checkApplied(dev, RADIO_PARAM_HEADER_MODE, dev->radio->implicitHeader(0xFF)); // Use max length for implicit header
         } else {
-            radio->explicitHeader();
+            checkApplied(dev, RADIO_PARAM_HEADER_MODE, dev->radio->explicitHeader());
         }
     }
 }
 
-void sx1262_radiolib_setBandwidth(uint8_t bw) {
-    if (radio != nullptr) {
-        // Convert bandwidth code to RadioLib bandwidth
-        // bw codes: 0=7.8kHz, 1=10.4kHz, 2=15.6kHz, 3=20.8kHz, 4=31.25kHz, 5=41.7kHz, 6=62.5kHz, 7=125kHz, 8=250kHz, 9=500kHz
-        float bandwidths[] = {7.8, 10.4, 15.6, 20.8, 31.25, 41.7, 62.5, 125.0, 250.0, 500.0};
-        if (bw < sizeof(bandwidths)/sizeof(bandwidths[0])) {
-            radio->setBandwidth(bandwidths[bw]);
-        }
+// Convert bandwidth code to RadioLib bandwidth in kHz (0 for an invalid code)
+// bw codes: 0=7.8kHz, 1=10.4kHz, 2=15.6kHz, 3=20.8kHz, 4=31.25kHz, 5=41.7kHz, 6=62.5kHz, 7=125kHz, 8=250kHz, 9=500kHz
+static float bandwidthKHz(uint8_t bw) {
+    static const float bandwidths[] = {7.8, 10.4, 15.6, 20.8, 31.25, 41.7, 62.5, 125.0, 250.0, 500.0};
+    return bw < sizeof(bandwidths)/sizeof(bandwidths[0]) ? bandwidths[bw] : 0.0f;
+}
+
+void sx1262_radiolib_setBandwidth(Sx1262RadioLib* dev, uint8_t bw) {
+    float khz = bandwidthKHz(bw);
+    if (khz > 0.0f && shadowChanged(dev, RADIO_PARAM_BANDWIDTH, bw)) {
+        checkApplied(dev, RADIO_PARAM_BANDWIDTH, dev->radio->setBandwidth(khz));
     }
 }
 
-void sx1262_radiolib_setSpreadingFactor(uint8_t sf) {
-    if (radio != nullptr) {
-        radio->setSpreadingFactor(sf);
+void sx1262_radiolib_setSpreadingFactor(Sx1262RadioLib* dev, uint8_t sf) {
+    if (shadowChanged(dev, RADIO_PARAM_SPREADING_FACTOR, sf)) {
+        checkApplied(dev, RADIO_PARAM_SPREADING_FACTOR, dev->radio->setSpreadingFactor(sf));
+    }
+}
+
+void sx1262_radiolib_setCodingRate(Sx1262RadioLib* dev, uint8_t cr) {
+    if (shadowChanged(dev, RADIO_PARAM_CODING_RATE, cr)) {
+        checkApplied(dev, RADIO_PARAM_CODING_RATE, dev->radio->setCodingRate(cr));
+    }
+}
+
+void sx1262_radiolib_setInvertIQ(Sx1262RadioLib* dev, bool invert) {
+    if (shadowChanged(dev, RADIO_PARAM_INVERT_IQ, invert)) {
+        checkApplied(dev, RADIO_PARAM_INVERT_IQ, dev->radio->invertIQ(invert));
+    }
+}
+
+// RadioLib takes frequency and bandwidth as floating point MHz/kHz and builds
+// the SPI commands itself (its cached packet parameters must stay in sync), so
+// a profile holds the converted arguments; everything else passes through
+typedef struct {
+    float frequencyMHz;
+    float bandwidthKHz;
+} RadioLibProfileImage;
+
+static_assert(sizeof(RadioLibProfileImage) <= sizeof(RadioProfile::image), "RadioLib profile image too large");
+
+void sx1262_radiolib_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    RadioLibProfileImage* image = (RadioLibProfileImage*)profile->image;
+    image->frequencyMHz = (float)settings->frequencyHz / 1000000.0f;
+    image->bandwidthKHz = bandwidthKHz(settings->bandwidth);
+    profile->settings = *settings;
+    profile->compiled = true;
+}
+
+void sx1262_radiolib_applyProfile(Sx1262RadioLib* dev, const RadioProfile* profile) {
+    if (dev->radio == nullptr) return;
+    unsigned long startUs = micros();
+    const RadioLibProfileImage* image = (const RadioLibProfileImage*)profile->image;
+    const RadioSettings* settings = &profile->settings;
+    
+    if (shadowChanged(dev, RADIO_PARAM_FREQUENCY, settings->frequencyHz)) {
+        checkApplied(dev, RADIO_PARAM_FREQUENCY, applyFrequency(dev, settings->frequencyHz, image->frequencyMHz));
+    }
+    if (image->bandwidthKHz > 0.0f && shadowChanged(dev, RADIO_PARAM_BANDWIDTH, settings->bandwidth)) {
+        checkApplied(dev, RADIO_PARAM_BANDWIDTH, dev->radio->setBandwidth(image->bandwidthKHz));
+    }
+    sx1262_radiolib_setSpreadingFactor(dev, settings->spreadingFactor);
+    sx1262_radiolib_setCodingRate(dev, settings->codingRate);
+    sx1262_radiolib_setSyncWord(dev, settings->syncWord);
+    sx1262_radiolib_setPreambleLength(dev, settings->preambleLength);
+    sx1262_radiolib_setHeaderMode(dev, settings->implicitHeader);
+    sx1262_radiolib_setInvertIQ(dev, settings->invertIQ);
+    sx1262_radiolib_setCrc(dev, settings->crcEnabled);
+    
+    radio_profile_recordSwitch(micros() - startUs);
+}
+
+// Read out a completed frame with raw commands, each status read once:
+// GetIrqStatus, GetRxBufferStatus, GetPacketStatus, ReadBuffer and
+// ClearIrqStatus. The getter path (available(), getPacketLength(),
+// readData(), getRSSI(), getSNR()) repeats several of them. Unless
+// `anyFrame`, nothing is read past the IRQ status when RX_DONE is not set.
+static bool fetchFrame(Sx1262RadioLib* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame,
+                       bool anyFrame, bool clearIrq) {
+    if (dev->module == nullptr) return false;
+    
+    uint8_t irqStatus[2];
+    dev->module->SPIreadStream(RADIOLIB_SX126X_CMD_GET_IRQ_STATUS, irqStatus, 2);
+    uint16_t irq = ((uint16_t)irqStatus[0] << 8) | irqStatus[1];
+    if (!anyFrame && (irq & RADIOLIB_SX126X_IRQ_RX_DONE) == 0) {
+        return false;
+    }
+    
+    uint8_t rxStatus[2];        // Payload length, RX start buffer pointer
+    uint8_t packetStatus[3];    // RSSI, SNR, signal RSSI
+    dev->module->SPIreadStream(RADIOLIB_SX126X_CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
+    dev->module->SPIreadStream(RADIOLIB_SX126X_CMD_GET_PACKET_STATUS, packetStatus, 3);
+    frame->rxLength = rxStatus[0];
+    frame->length = (rxStatus[0] <= maxLen) ? rxStatus[0] : 0;
+    frame->rssi = -(packetStatus[0] / 2);
+    frame->snr = ((int8_t)packetStatus[1]) / 4;
+    frame->crcError = (irq & (RADIOLIB_SX126X_IRQ_CRC_ERR | RADIOLIB_SX126X_IRQ_HEADER_ERR)) != 0;
+    
+    if (frame->length > 0) {
+        uint8_t readBuffer[2] = {RADIOLIB_SX126X_CMD_READ_BUFFER, rxStatus[1]};
+        if (dev->module->SPIreadStream(readBuffer, 2, data, frame->length) != RADIOLIB_ERR_NONE) {
+            frame->length = 0;
+        }
+    }
+    if (clearIrq) {
+        uint8_t clearAll[2] = {0xFF, 0xFF};
+        dev->module->SPIwriteStream(SX1262_CMD_CLEAR_IRQ_STATUS, clearAll, 2);
     }
+    return true;
+}
+
+bool sx1262_radiolib_fetchFrame(Sx1262RadioLib* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    return fetchFrame(dev, data, maxLen, frame, false, true);
 }
 
-void sx1262_radiolib_setCodingRate(uint8_t cr) {
-    if (radio != nullptr) {
-        radio->setCodingRate(cr);
+bool sx1262_radiolib_benchmarkFifoRead(Sx1262RadioLib* dev, SpiBenchmark* result) {
+    if (dev->radio == nullptr) return false;
+    
+    // ReadBuffer: opcode, offset, status (NOP), then the payload
+    const uint8_t header[3] = {RADIOLIB_SX126X_CMD_READ_BUFFER, 0x00, 0x00};
+    spi_bench_fifoRead(dev->pinNss, dev->pinBusy, platform_getSpiFrequency(),
+                       header, sizeof(header), SPI_BENCH_PAYLOAD_MAX, result);
+    
+    // Read out whatever frame the buffer holds: the getter sequence the RX
+    // path used to run (readData() clears the IRQs as it goes), then
+    // fetchFrame() without the clear
+    uint8_t frameData[SPI_BENCH_PAYLOAD_MAX];
+    RadioFrame frame;
+    unsigned long startUs = micros();
+    for (uint8_t run = 0; run < SPI_BENCH_RUNS; run++) {
+        sx1262_radiolib_isPacketReceived(dev);
+        uint8_t len = sx1262_radiolib_getPacketLength(dev);
+        sx1262_radiolib_readFifo(dev, frameData, len);
+        sx1262_radiolib_getPacketLength(dev);
+        sx1262_radiolib_getRssi(dev);
+        sx1262_radiolib_getSnr(dev);
+    }
+    result->rxGettersUs = (micros() - startUs) / SPI_BENCH_RUNS;
+    
+    startUs = micros();
+    for (uint8_t run = 0; run < SPI_BENCH_RUNS; run++) {
+        fetchFrame(dev, frameData, SPI_BENCH_PAYLOAD_MAX, &frame, true, false);
     }
+    result->rxFetchUs = (micros() - startUs) / SPI_BENCH_RUNS;
+    result->rxBytes = frame.length;
+    return true;
 }
 
-void sx1262_radiolib_setInvertIQ(bool invert) {
-    if (radio != nullptr) {
-        radio->invertIQ(invert);
+// Not every RadioLib release latches HEADER_VALID in its default RX IRQ set.
+// Re-issue SetDioIrqParams with it added to the status mask only, leaving DIO1
+// on RX_DONE so the packet-received callback behaves exactly as before.
+static void enableHeaderValidIrq(Sx1262RadioLib* dev) {
+    if (dev->module == nullptr) return;
+    uint16_t irqMask = RADIOLIB_SX126X_IRQ_RX_DONE | RADIOLIB_SX126X_IRQ_TIMEOUT |
+                       RADIOLIB_SX126X_IRQ_CRC_ERR | RADIOLIB_SX126X_IRQ_HEADER_ERR |
+                       RADIOLIB_SX126X_IRQ_HEADER_VALID;
+    uint16_t dio1Mask = RADIOLIB_SX126X_IRQ_RX_DONE;
+    uint8_t dioParams[8] = {
+        (uint8_t)(irqMask >> 8), (uint8_t)irqMask,
+        (uint8_t)(dio1Mask >> 8), (uint8_t)dio1Mask,
+        0x00, 0x00, 0x00, 0x00
+    };
+    dev->module->SPIwriteStream(SX1262_CMD_SET_DIO_IRQ_PARAMS, dioParams, 8);
+}
+
+// Key up on the armed preload: what startTransmit() does after uploading the
+// payload, with the TX base pointed at the preload. startReceive() restores
+// the RX packet parameters and buffer base afterwards.
+static void transmitPreload(Sx1262RadioLib* dev) {
+    if (!dev->txModulationSet) {
+        uint8_t value = dev->module->SPIreadRegister(SX1262_REG_TX_MODULATION);
+        dev->module->SPIwriteRegister(SX1262_REG_TX_MODULATION, value | 0x04);
+        dev->txModulationSet = true;
     }
+    
+    uint8_t bufferBase[2] = {dev->preloadBase, 0x00};
+    uint16_t irqMask = RADIOLIB_SX126X_IRQ_TX_DONE | RADIOLIB_SX126X_IRQ_TIMEOUT;
+    uint16_t dio1Mask = RADIOLIB_SX126X_IRQ_TX_DONE;
+    uint8_t dioParams[8] = {
+        (uint8_t)(irqMask >> 8), (uint8_t)irqMask,
+        (uint8_t)(dio1Mask >> 8), (uint8_t)dio1Mask,
+        0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t txTimeout[3] = {0x00, 0x00, 0x00}; // No timeout - TX_DONE is polled with a bound
+    dev->module->SPIwriteStream(RADIOLIB_SX126X_CMD_SET_PACKET_PARAMS, dev->preloadPacketParams, 6);
+    dev->module->SPIwriteStream(RADIOLIB_SX126X_CMD_SET_BUFFER_BASE_ADDRESS, bufferBase, 2);
+    dev->module->SPIwriteStream(SX1262_CMD_SET_DIO_IRQ_PARAMS, dioParams, 8);
+    dev->module->SPIwriteStream(RADIOLIB_SX126X_CMD_SET_TX, txTimeout, 3);
 }
 
-void sx1262_radiolib_setMode(uint8_t mode) {
-    if (radio == nullptr) return;
+void sx1262_radiolib_setMode(Sx1262RadioLib* dev, uint8_t mode) {
+    if (dev->radio == nullptr) return;
+    
+    // Leaving RX: a frame cut off mid-reception has already written into the
+    // buffer without raising RX_DONE
+    if (mode != 0x05 && dev->preloadListening) {
+        dev->preloadListening = false;
+        if (dev->preloadValid && sx1262_radiolib_isReceiving(dev)) {
+            dev->preloadValid = false;
+        }
+    }
+    
+    // RX -> TX turnaround starts when the radio stops listening: leaving RX,
+    // or the standby after the last LBT CAD
+    uint8_t previousMode = dev->mode;
+    if ((previousMode == 0x05 || previousMode == 0x07) && mode != previousMode) {
+        dev->rxLeft = true;
+        dev->rxLeftUs = micros();
+    }
+    dev->mode = mode;
     
     // Use numeric constants to avoid conflicts with RadioLib's MODE_* definitions
     switch (mode) {
         case 0x00: // MODE_SLEEP
-            radio->sleep();
+            dev->radio->sleep();
+            dev->preloadValid = false; // Buffer is lost in sleep
             break;
         case 0x01: // MODE_STDBY
-            radio->standby();
+            // STDBY_XOSC keeps the TCXO running; STDBY_RC turns it off
+            dev->radio->standby(dev->fastTurnaround ? RADIOLIB_SX126X_STANDBY_XOSC : RADIOLIB_SX126X_STANDBY_RC);
             break;
         case 0x03: // MODE_TX
-            // Start transmission with pending data
-            if (pendingTxData != nullptr && pendingTxLen > 0) {
-                radio->startTransmit(pendingTxData, pendingTxLen);
-                pendingTxData = nullptr;
-                pendingTxLen = 0;
+            dev->txDoneSeen = false;
+            if (dev->preloadArmed) {
+                dev->preloadArmed = false;
+                transmitPreload(dev);
+            } else if (dev->pendingTxData != nullptr && dev->pendingTxLen > 0) {
+                // Start transmission with pending data
+                dev->radio->startTransmit(dev->pendingTxData, dev->pendingTxLen);
+                dev->pendingTxData = nullptr;
+                dev->pendingTxLen = 0;
+                dev->txModulationSet = radio_shadow_get(&dev->shadow, RADIO_PARAM_BANDWIDTH, 9) != 9;
+            }
+            // SetTx returns once BUSY drops - oscillator up and PA ramped
+            if (dev->rxLeft) {
+                dev->rxLeft = false;
+                radio_turnaround_recordRxToTx(micros() - dev->rxLeftUs);
             }
             break;
         case 0x05: // MODE_RX_CONTINUOUS
-            radio->startReceive();
+            dev->radio->startReceive();
+            enableHeaderValidIrq(dev);
+            dev->preloadListening = true;
+            dev->rxLeft = false;
+            // The command after SetRx waited for BUSY, so the radio is receiving
+            if (dev->txDoneSeen) {
+                dev->txDoneSeen = false;
+                radio_turnaround_recordTxToRx(micros() - dev->txDoneUs);
+            }
+            break;
+        case 0x07: // MODE_CAD
+            // RadioLib picks CAD parameters for the current SF and routes CAD IRQs to the DIO pin
+            dev->radio->startChannelScan();
             break;
     }
 }
 
-void sx1262_radiolib_writeFifo(uint8_t* data, uint8_t len) {
-    if (radio != nullptr && data != nullptr) {
+void sx1262_radiolib_writeFifo(Sx1262RadioLib* dev, uint8_t* data, uint8_t len) {
+    if (dev->radio != nullptr && data != nullptr) {
         // Store data for transmission (will be sent when setMode(MODE_TX) is called)
         // Note: This assumes data buffer remains valid until transmission starts
-        pendingTxData = data;
-        pendingTxLen = len;
+        dev->pendingTxData = data;
+        dev->pendingTxLen = len;
+        dev->preloadValid = false;
+        dev->preloadArmed = false;
     }
 }
 
-void sx1262_radiolib_readFifo(uint8_t* data, uint8_t len) {
-    if (radio != nullptr && data != nullptr) {
-        radio->readData(data, len);
+bool sx1262_radiolib_preloadTx(Sx1262RadioLib* dev, const uint8_t* data, uint8_t len) {
+    dev->preloadValid = false;
+    dev->preloadArmed = false;
+    if (dev->module == nullptr || data == nullptr || len == 0) {
+        return false;
+    }
+    
+    dev->preloadBase = (uint8_t)(256 - len);
+    dev->preloadLen = len;
+    dev->preloadRxEvents = 0;
+    uint8_t header[2] = {RADIOLIB_SX126X_CMD_WRITE_BUFFER, dev->preloadBase};
+    if (dev->module->SPIwriteStream(header, 2, (uint8_t*)data, len) != RADIOLIB_ERR_NONE) {
+        return false;
     }
+    dev->preloadValid = true;
+    return true;
 }
 
-int16_t sx1262_radiolib_getRssi() {
-    if (radio != nullptr) {
-        return radio->getRSSI();
+bool sx1262_radiolib_armTxPreload(Sx1262RadioLib* dev) {
+    if (!dev->preloadValid || dev->module == nullptr) {
+        return false;
+    }
+    dev->preloadValid = false;
+    
+    // One reception since the preload: GetRxBufferStatus tells where it
+    // landed. More than one can't be checked - upload again.
+    uint8_t rxEvents = dev->preloadRxEvents;
+    if (rxEvents > 1) {
+        return false;
+    }
+    if (rxEvents == 1) {
+        uint8_t rxStatus[2]; // Payload length, start pointer
+        dev->module->SPIreadStream(RADIOLIB_SX126X_CMD_GET_RX_BUFFER_STATUS, rxStatus, 2);
+        if (rxStatus[1] >= dev->preloadBase || rxStatus[1] + rxStatus[0] > dev->preloadBase) {
+            return false;
+        }
+    }
+    
+    // SetPacketParams from the shadow, as RadioLib would build it. 500 kHz is
+    // left to startTransmit(), which also handles its modulation quirk.
+    const uint32_t unknown = 0xFFFFFFFFUL;
+    uint32_t bandwidth = radio_shadow_get(&dev->shadow, RADIO_PARAM_BANDWIDTH, unknown);
+    uint32_t preamble = radio_shadow_get(&dev->shadow, RADIO_PARAM_PREAMBLE, unknown);
+    uint32_t implicit = radio_shadow_get(&dev->shadow, RADIO_PARAM_HEADER_MODE, unknown);
+    uint32_t crc = radio_shadow_get(&dev->shadow, RADIO_PARAM_CRC, unknown);
+    uint32_t invertIQ = radio_shadow_get(&dev->shadow, RADIO_PARAM_INVERT_IQ, unknown);
+    if (bandwidth == unknown || bandwidth == 9 || preamble == unknown || implicit == unknown ||
+        crc == unknown || invertIQ == unknown) {
+        return false;
+    }
+    dev->preloadPacketParams[0] = (uint8_t)(preamble >> 8);
+    dev->preloadPacketParams[1] = (uint8_t)preamble;
+    dev->preloadPacketParams[2] = implicit ? 0x01 : 0x00;
+    dev->preloadPacketParams[3] = dev->preloadLen;
+    dev->preloadPacketParams[4] = crc ? 0x01 : 0x00;
+    dev->preloadPacketParams[5] = invertIQ ? 0x01 : 0x00;
+    
+    // Takes the place of writeFifo() for the next setMode(MODE_TX)
+    dev->pendingTxData = nullptr;
+    dev->pendingTxLen = 0;
+    dev->preloadArmed = true;
+    return true;
+}
+
+void sx1262_radiolib_readFifo(Sx1262RadioLib* dev, uint8_t* data, uint8_t len) {
+    if (dev->radio != nullptr && data != nullptr) {
+        dev->radio->readData(data, len);
+    }
+}
+
+int16_t sx1262_radiolib_getRssi(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getRSSI();
     }
     return -127;
 }
 
-int8_t sx1262_radiolib_getSnr() {
-    if (radio != nullptr) {
-        return radio->getSNR();
+int8_t sx1262_radiolib_getSnr(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getSNR();
     }
     return 0;
 }
 
-uint8_t sx1262_radiolib_readRegister(uint8_t reg) {
-    if (radioModule != nullptr) {
+int16_t sx1262_radiolib_getRssiInst(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getRSSI(false); // GetRssiInst
+    }
+    return -127;
+}
+
+uint8_t sx1262_radiolib_readRegister(Sx1262RadioLib* dev, uint8_t reg) {
+    if (dev->module != nullptr) {
         // SX1262 uses 16-bit register addresses, but we'll use the low byte
-        return radioModule->SPIreadRegister(reg);
+        return dev->module->SPIreadRegister(reg);
     }
     return 0;
 }
 
-void sx1262_radiolib_writeRegister(uint8_t reg, uint8_t value) {
-    if (radioModule != nullptr) {
+void sx1262_radiolib_writeRegister(Sx1262RadioLib* dev, uint8_t reg, uint8_t value) {
+    // A raw write may change anything the shadow describes
+    radio_shadow_invalidate(&dev->shadow);
+    if (dev->module != nullptr) {
         // SX1262 uses 16-bit register addresses, but we'll use the low byte
-        radioModule->SPIwriteRegister(reg, value);
+        dev->module->SPIwriteRegister(reg, value);
     }
 }
 
-void sx1262_radiolib_attachInterrupt(void (*handler)()) {
-    interruptHandler = handler;
+void sx1262_radiolib_attachInterrupt(Sx1262RadioLib* dev, void (*handler)()) {
+    dev->interruptHandler = handler;
+}
+
+bool sx1262_radiolib_isPacketReceived(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->available();
+    }
+    return false;
+}
+
+bool sx1262_radiolib_isTransmitDone(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIrqFlags() & RADIOLIB_SX126X_IRQ_TX_DONE) != 0;
+    }
+    return false;
+}
+
+bool sx1262_radiolib_isCadDone(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIrqFlags() & RADIOLIB_SX126X_IRQ_CAD_DONE) != 0;
+    }
+    return false;
+}
+
+bool sx1262_radiolib_isChannelActive(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIrqFlags() & RADIOLIB_SX126X_IRQ_CAD_DETECTED) != 0;
+    }
+    return false;
 }
 
-bool sx1262_radiolib_isPacketReceived() {
-    if (radio != nullptr) {
-        return radio->available();
+bool sx1262_radiolib_isReceiving(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        uint32_t flags = dev->radio->getIrqFlags();
+        return (flags & RADIOLIB_SX126X_IRQ_HEADER_VALID) != 0 && (flags & RADIOLIB_SX126X_IRQ_RX_DONE) == 0;
     }
     return false;
 }
 
-uint8_t sx1262_radiolib_getPacketLength() {
-    if (radio != nullptr) {
-        return radio->getPacketLength();
+uint8_t sx1262_radiolib_getPacketLength(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getPacketLength();
     }
     return 0;
 }
 
-void sx1262_radiolib_clearIrqFlags() {
-    if (radio != nullptr) {
-        radio->clearIrqFlags(RADIOLIB_SX126X_IRQ_ALL);
+void sx1262_radiolib_clearIrqFlags(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        dev->radio->clearIrqFlags(RADIOLIB_SX126X_IRQ_ALL);
     }
 }
 
-uint16_t sx1262_radiolib_getIrqFlags() {
-    if (radio != nullptr) {
-        return (uint16_t)radio->getIrqFlags();
+uint16_t sx1262_radiolib_getIrqFlags(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (uint16_t)dev->radio->getIrqFlags();
     }
     return 0;
 }
 
-bool sx1262_radiolib_hasPacketErrors() {
-    if (radio != nullptr) {
+bool sx1262_radiolib_hasPacketErrors(Sx1262RadioLib* dev) {
+    if (dev->radio != nullptr) {
         // Check for CRC error or header error using RadioLib's getIrqFlags
-        uint32_t flags = radio->getIrqFlags();
+        uint32_t flags = dev->radio->getIrqFlags();
         return (flags & (RADIOLIB_SX126X_IRQ_CRC_ERR | RADIOLIB_SX126X_IRQ_HEADER_ERR)) != 0;
     }
     return false;
@@ -3,37 +3,103 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../radio_profile.h"
+#include "../radio_shadow.h"
+#include "../radio_frame.h"
+#include "../spi_bench.h"
+#include "../../platforms/platform_interface.h"
 
 // Frequency Range Constants (SX1262: 150-960 MHz)
 #define SX1262_MIN_FREQUENCY_HZ  150000000UL
 #define SX1262_MAX_FREQUENCY_HZ  960000000UL
 
-// Function Prototypes (matches sx1262_direct interface)
-bool sx1262_radiolib_init();
+// Radios one build can drive (each needs its own interrupt entry point)
+#define SX1262_RADIOLIB_MAX_INSTANCES 2
+
+class BulkSpiHal;
+class Module;
+class SX1262;
+
+// One SX1262 driven through RadioLib. Every function takes the radio it acts
+// on, so a platform can run one instance per fitted radio, each on its own
+// pins; the caller owns the storage (zero-initialized) and calls init first.
+typedef struct {
+    int8_t pinNss;
+    int8_t pinBusy;
+    BulkSpiHal* hal;
+    Module* module;
+    SX1262* radio;
+    void (*interruptHandler)();
+    
+    // Last applied modem configuration - each RadioLib setter is a separate
+    // SPI command sequence, so unchanged parameters are not sent again
+    RadioShadow shadow;
+    
+    // Frame for the next setMode(MODE_TX) (writeFifo() keeps the pointer)
+    uint8_t* pendingTxData;
+    uint8_t pendingTxLen;
+    
+    // TX preload (radio_preloadTx): RadioLib receives from buffer offset 0,
+    // the preloaded frame waits at the top of the buffer. Receptions
+    // completed since the preload are counted by the ISR while listening.
+    uint8_t preloadBase;
+    uint8_t preloadLen;
+    bool preloadValid;
+    bool preloadArmed;
+    uint8_t preloadPacketParams[6];
+    volatile bool preloadListening;
+    volatile uint8_t preloadRxEvents;
+    bool txModulationSet;           // TX modulation bit set for a bandwidth below 500 kHz
+    
+    // Fast turnaround (platform_useFastTurnaround): stand by on XOSC and
+    // calibrate the image once per band. The last mode and the turnaround
+    // start times feed radio_turnaround.h.
+    bool fastTurnaround;
+    uint16_t imageBand;             // Band last calibrated (imageBand()), 0 = none
+    volatile uint8_t mode;          // Last setMode() mode
+    bool rxLeft;                    // Stopped listening (RX or CAD), SetTx not sent yet
+    uint32_t rxLeftUs;
+    volatile bool txDoneSeen;       // TX_DONE raised, not back in RX yet
+    volatile uint32_t txDoneUs;
+} Sx1262RadioLib;
+
+// Function Prototypes (matches sx1262_direct interface, plus the instance)
+bool sx1262_radiolib_init(Sx1262RadioLib* dev, uint8_t index, const RadioPins* pins);
 uint32_t sx1262_radiolib_getMinFrequency();
 uint32_t sx1262_radiolib_getMaxFrequency();
-void sx1262_radiolib_setFrequency(uint32_t freq_hz);
-void sx1262_radiolib_setPower(uint8_t power);
-void sx1262_radiolib_setPreambleLength(uint16_t length);
-void sx1262_radiolib_setCrc(bool enable);
-void sx1262_radiolib_setSyncWord(uint8_t syncWord);
-void sx1262_radiolib_setHeaderMode(bool implicit);
-void sx1262_radiolib_setBandwidth(uint8_t bw);
-void sx1262_radiolib_setSpreadingFactor(uint8_t sf);
-void sx1262_radiolib_setCodingRate(uint8_t cr);
-void sx1262_radiolib_setInvertIQ(bool invert);
-void sx1262_radiolib_setMode(uint8_t mode);
-void sx1262_radiolib_writeFifo(uint8_t* data, uint8_t len);
-void sx1262_radiolib_readFifo(uint8_t* data, uint8_t len);
-int16_t sx1262_radiolib_getRssi();
-int8_t sx1262_radiolib_getSnr();
-uint8_t sx1262_radiolib_readRegister(uint8_t reg);
-void sx1262_radiolib_writeRegister(uint8_t reg, uint8_t value);
-void sx1262_radiolib_attachInterrupt(void (*handler)());
-bool sx1262_radiolib_isPacketReceived();
-uint8_t sx1262_radiolib_getPacketLength();
-void sx1262_radiolib_clearIrqFlags();
-uint16_t sx1262_radiolib_getIrqFlags();
-bool sx1262_radiolib_hasPacketErrors();
+void sx1262_radiolib_setFrequency(Sx1262RadioLib* dev, uint32_t freq_hz);
+void sx1262_radiolib_setPower(Sx1262RadioLib* dev, uint8_t power);
+void sx1262_radiolib_setPreambleLength(Sx1262RadioLib* dev, uint16_t length);
+void sx1262_radiolib_setCrc(Sx1262RadioLib* dev, bool enable);
+void sx1262_radiolib_setSyncWord(Sx1262RadioLib* dev, uint8_t syncWord);
+void sx1262_radiolib_setHeaderMode(Sx1262RadioLib* dev, bool implicit);
+void sx1262_radiolib_setBandwidth(Sx1262RadioLib* dev, uint8_t bw);
+void sx1262_radiolib_setSpreadingFactor(Sx1262RadioLib* dev, uint8_t sf);
+void sx1262_radiolib_setCodingRate(Sx1262RadioLib* dev, uint8_t cr);
+void sx1262_radiolib_setInvertIQ(Sx1262RadioLib* dev, bool invert);
+void sx1262_radiolib_compileProfile(const RadioSettings* settings, RadioProfile* profile);
+void sx1262_radiolib_applyProfile(Sx1262RadioLib* dev, const RadioProfile* profile);
+bool sx1262_radiolib_benchmarkFifoRead(Sx1262RadioLib* dev, SpiBenchmark* result);
+void sx1262_radiolib_setMode(Sx1262RadioLib* dev, uint8_t mode);
+void sx1262_radiolib_writeFifo(Sx1262RadioLib* dev, uint8_t* data, uint8_t len);
+bool sx1262_radiolib_preloadTx(Sx1262RadioLib* dev, const uint8_t* data, uint8_t len);
+bool sx1262_radiolib_armTxPreload(Sx1262RadioLib* dev);
+void sx1262_radiolib_readFifo(Sx1262RadioLib* dev, uint8_t* data, uint8_t len);
+bool sx1262_radiolib_fetchFrame(Sx1262RadioLib* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame);
+int16_t sx1262_radiolib_getRssi(Sx1262RadioLib* dev);
+int8_t sx1262_radiolib_getSnr(Sx1262RadioLib* dev);
+int16_t sx1262_radiolib_getRssiInst(Sx1262RadioLib* dev);
+uint8_t sx1262_radiolib_readRegister(Sx1262RadioLib* dev, uint8_t reg);
+void sx1262_radiolib_writeRegister(Sx1262RadioLib* dev, uint8_t reg, uint8_t value);
+void sx1262_radiolib_attachInterrupt(Sx1262RadioLib* dev, void (*handler)());
+bool sx1262_radiolib_isPacketReceived(Sx1262RadioLib* dev);
+bool sx1262_radiolib_isTransmitDone(Sx1262RadioLib* dev);
+bool sx1262_radiolib_isCadDone(Sx1262RadioLib* dev);
+bool sx1262_radiolib_isChannelActive(Sx1262RadioLib* dev);
+bool sx1262_radiolib_isReceiving(Sx1262RadioLib* dev);
+uint8_t sx1262_radiolib_getPacketLength(Sx1262RadioLib* dev);
+void sx1262_radiolib_clearIrqFlags(Sx1262RadioLib* dev);
+uint16_t sx1262_radiolib_getIrqFlags(Sx1262RadioLib* dev);
+bool sx1262_radiolib_hasPacketErrors(Sx1262RadioLib* dev);
 
 #endif // SX1262_RADIOLIB_H
@@ -1,79 +1,102 @@
 #include "sx1276_direct.h"
-#include "../../platforms/platform_interface.h"  // Platform interface for pin definitions
+#include "../../platforms/platform_interface.h"  // Platform interface for SPI settings
 #include <SPI.h>
 #include <avr/interrupt.h>
 #include <Arduino.h>
 
-// Static variables to cache pin numbers from platform interface
-static int8_t pin_nss = -1;
-static int8_t pin_reset = -1;
-static int8_t pin_dio0 = -1;
-static uint32_t spi_freq = 1000000;
-
 // SX1276 SPI Communication (internal helpers)
-static uint8_t sx1276_readReg(uint8_t reg) {
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
+static uint8_t sx1276_readReg(Sx1276Direct* dev, uint8_t reg) {
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
     SPI.transfer(reg & 0x7F); // Read: bit 7 = 0
     uint8_t value = SPI.transfer(0x00);
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
     SPI.endTransaction();
     return value;
 }
 
-static void sx1276_writeReg(uint8_t reg, uint8_t value) {
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
+static void sx1276_writeReg(Sx1276Direct* dev, uint8_t reg, uint8_t value) {
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
     SPI.transfer(reg | 0x80); // Write: bit 7 = 1
     SPI.transfer(value);
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
+    SPI.endTransaction();
+}
+
+// Burst write: the address auto-increments, one NSS cycle for `len` registers
+static void sx1276_writeBurst(Sx1276Direct* dev, uint8_t reg, const uint8_t* data, uint8_t len) {
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
+    SPI.transfer(reg | 0x80);
+    for (uint8_t i = 0; i < len; i++) {
+        SPI.transfer(data[i]);
+    }
+    digitalWrite(dev->pinNss, HIGH);
+    SPI.endTransaction();
+}
+
+// Burst read: `len` consecutive registers in one NSS cycle
+static void sx1276_readBurst(Sx1276Direct* dev, uint8_t reg, uint8_t* data, uint8_t len) {
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
+    SPI.transfer(reg & 0x7F);
+    for (uint8_t i = 0; i < len; i++) {
+        data[i] = SPI.transfer(0x00);
+    }
+    digitalWrite(dev->pinNss, HIGH);
     SPI.endTransaction();
 }
 
-bool sx1276_direct_init() {
-    // Get pin numbers from platform interface
-    pin_nss = platform_getRadioNssPin();
-    pin_reset = platform_getRadioResetPin();
-    pin_dio0 = platform_getRadioDio0Pin();
-    spi_freq = platform_getSpiFrequency();
+bool sx1276_direct_init(Sx1276Direct* dev, const RadioPins* pins) {
+    radio_shadow_invalidate(&dev->shadow);
+    dev->preloadValid = false;
+    dev->opMode = MODE_SLEEP;
+    
+    // Pins of this radio (platform_getRadioPins())
+    dev->pinNss = pins->nss;
+    dev->pinReset = pins->reset;
+    dev->pinDio0 = pins->dio0;
+    dev->spiFreq = platform_getSpiFrequency();
     
     // Validate required pins
-    if (pin_nss < 0 || pin_dio0 < 0) {
+    if (dev->pinNss < 0 || dev->pinDio0 < 0) {
         return false;  // Required pins not available
     }
     
     // Initialize SPI pins
-    pinMode(pin_nss, OUTPUT);
-    if (pin_reset >= 0) {
-        pinMode(pin_reset, OUTPUT);
+    pinMode(dev->pinNss, OUTPUT);
+    if (dev->pinReset >= 0) {
+        pinMode(dev->pinReset, OUTPUT);
     }
-    pinMode(pin_dio0, INPUT);
+    pinMode(dev->pinDio0, INPUT);
     
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
     
     // Initialize SPI
     SPI.begin();
     
     // Reset SX1276 (if reset pin available)
-    if (pin_reset >= 0) {
-        digitalWrite(pin_reset, LOW);
+    if (dev->pinReset >= 0) {
+        digitalWrite(dev->pinReset, LOW);
         delay(10);
-        digitalWrite(pin_reset, HIGH);
+        digitalWrite(dev->pinReset, HIGH);
         delay(10);
     }
     
     // Check version register (SX1276 returns 0x12, SX1272 returns 0x11)
-    uint8_t version = sx1276_readReg(REG_VERSION);
+    uint8_t version = sx1276_readReg(dev, REG_VERSION);
     if (version != 0x12 && version != 0x11) {
         return false; // Wrong chip or not responding
     }
     
     // Put in sleep mode
-    sx1276_writeReg(REG_OP_MODE, MODE_SLEEP | MODE_LONG_RANGE_MODE);
+    sx1276_writeReg(dev, REG_OP_MODE, MODE_SLEEP | MODE_LONG_RANGE_MODE);
     delay(10);
     
     // Set to standby
-    sx1276_writeReg(REG_OP_MODE, MODE_STDBY | MODE_LONG_RANGE_MODE);
+    sx1276_writeReg(dev, REG_OP_MODE, MODE_STDBY | MODE_LONG_RANGE_MODE);
+    dev->opMode = MODE_STDBY;
     delay(10);
     
     // Radio is now initialized and ready
@@ -81,26 +104,27 @@ bool sx1276_direct_init() {
     // by the protocol layer via the radio interface functions
     
     // Set default IQ inversion (protocols will override as needed)
-    sx1276_direct_setInvertIQ(false);
+    sx1276_direct_setInvertIQ(dev, false);
     
     // Configure FIFO addresses
-    sx1276_writeReg(REG_FIFO_TX_BASE_ADDR, 0x00);
-    sx1276_writeReg(REG_FIFO_RX_BASE_ADDR, 0x00);
+    sx1276_writeReg(dev, REG_FIFO_TX_BASE_ADDR, 0x00);
+    sx1276_writeReg(dev, REG_FIFO_RX_BASE_ADDR, 0x00);
+    dev->txBaseAddr = 0x00;
     
     // CRITICAL: Configure LNA for maximum sensitivity
     // LNA_GAIN_1 (max gain) + LNA_BOOST_ON (150% current)
-    sx1276_writeReg(REG_LNA, LNA_GAIN_1 | LNA_BOOST_ON);
+    sx1276_writeReg(dev, REG_LNA, LNA_GAIN_1 | LNA_BOOST_ON);
     
     // CRITICAL: Enable AGC Auto in MODEM_CONFIG_3
     // This allows the radio to automatically adjust gain for optimal reception
-    sx1276_writeReg(REG_MODEM_CONFIG_3, AGC_AUTO_ON);
+    sx1276_writeReg(dev, REG_MODEM_CONFIG_3, AGC_AUTO_ON);
     
     // Configure DIO0 mapping for RX_DONE (will be remapped for TX)
     // DIO0: 00 = RxDone (in RX mode), TxDone (in TX mode)
-    sx1276_writeReg(REG_DIO_MAPPING_1, 0x00);
+    sx1276_writeReg(dev, REG_DIO_MAPPING_1, 0x00);
     
     // Clear all IRQ flags
-    sx1276_writeReg(REG_IRQ_FLAGS, 0xFF);
+    sx1276_writeReg(dev, REG_IRQ_FLAGS, 0xFF);
     
     return true;
 }
@@ -113,30 +137,83 @@ uint32_t sx1276_direct_getMaxFrequency() {
     return SX1276_MAX_FREQUENCY_HZ;
 }
 
-void sx1276_direct_setFrequency(uint32_t freq_hz) {
-    // FREQ_STEP = 32 MHz / 2^19 = 61.03515625 Hz per step
-    // regFreq = freq_hz / FREQ_STEP
-    const double FREQ_STEP = 61.03515625;
-    uint32_t regFreq = (uint32_t)((double)freq_hz / FREQ_STEP);
-    
-    // Set STANDBY mode before changing frequency (required by SX1276)
-    uint8_t currentMode = sx1276_readReg(REG_OP_MODE);
-    if ((currentMode & 0x07) != MODE_STDBY) {
-        sx1276_writeReg(REG_OP_MODE, (currentMode & 0xF8) | MODE_STDBY | MODE_LONG_RANGE_MODE);
+// Register encoders shared by the setters and radio profiles
+
+static uint8_t clampSpreadingFactor(uint8_t sf) {
+    // SF: 6-12
+    if (sf < 6) sf = 6;
+    if (sf > 12) sf = 12;
+    return sf;
+}
+
+static uint8_t clampCodingRate(uint8_t cr) {
+    if (cr < 5) cr = 5;
+    if (cr > 8) cr = 8;
+    return cr;
+}
+
+// FRF (MSB, MID, LSB) = freq * 2^19 / 32 MHz, i.e. 61.03515625 Hz per step.
+// Computed as freq * 2^13 / 500 kHz, split so integer math never overflows.
+static void encodeFrequency(uint32_t freq_hz, uint8_t frf[3]) {
+    uint32_t regFreq = ((freq_hz / 500000UL) << 13) + (((freq_hz % 500000UL) << 13) / 500000UL);
+    frf[0] = (uint8_t)(regFreq >> 16);
+    frf[1] = (uint8_t)(regFreq >> 8);
+    frf[2] = (uint8_t)regFreq;
+}
+
+// MODEM_CONFIG_1: bandwidth | coding rate | implicit header
+static uint8_t encodeModemConfig1(uint8_t bw, uint8_t cr, bool implicit) {
+    return (bw << 4) | ((cr - 4) << 1) | (implicit ? 0x01 : 0x00);
+}
+
+// MODEM_CONFIG_2: spreading factor | payload CRC
+static uint8_t encodeModemConfig2(uint8_t sf, bool crc) {
+    return (sf << 4) | (crc ? 0x04 : 0x00);
+}
+
+// MODEM_CONFIG_3: always keep AGC_AUTO_ON, add LOW_DATA_RATE_OPTIMIZE for
+// SF11/SF12 (required for symbol times > 16ms)
+static uint8_t encodeModemConfig3(uint8_t sf) {
+    return AGC_AUTO_ON | (sf >= 11 ? LOW_DATA_RATE_OPTIMIZE : 0);
+}
+
+// MODEM_CONFIG_1 from the shadow (chip reset values for anything not set
+// yet: 125 kHz, 4/5, explicit)
+static void writeModemConfig1(Sx1276Direct* dev) {
+    uint8_t bw = (uint8_t)radio_shadow_get(&dev->shadow, RADIO_PARAM_BANDWIDTH, 7);
+    uint8_t cr = (uint8_t)radio_shadow_get(&dev->shadow, RADIO_PARAM_CODING_RATE, 5);
+    bool implicit = radio_shadow_get(&dev->shadow, RADIO_PARAM_HEADER_MODE, 0) != 0;
+    sx1276_writeReg(dev, REG_MODEM_CONFIG_1, encodeModemConfig1(bw, cr, implicit));
+}
+
+// MODEM_CONFIG_2 from the shadow (reset: SF7, CRC off)
+static void writeModemConfig2(Sx1276Direct* dev) {
+    uint8_t sf = (uint8_t)radio_shadow_get(&dev->shadow, RADIO_PARAM_SPREADING_FACTOR, 7);
+    bool crc = radio_shadow_get(&dev->shadow, RADIO_PARAM_CRC, 0) != 0;
+    sx1276_writeReg(dev, REG_MODEM_CONFIG_2, encodeModemConfig2(sf, crc));
+}
+
+// Set STANDBY mode before changing frequency (required by SX1276)
+static void enterStandbyForFrequency(Sx1276Direct* dev) {
+    if (dev->opMode != MODE_STDBY && dev->opMode != MODE_SLEEP) {
+        sx1276_writeReg(dev, REG_OP_MODE, MODE_STDBY | MODE_LONG_RANGE_MODE);
+        dev->opMode = MODE_STDBY;
         delay(1); // Small delay for mode change
     }
+}
+
+void sx1276_direct_setFrequency(Sx1276Direct* dev, uint32_t freq_hz) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_FREQUENCY, freq_hz)) {
+        return;
+    }
     
-    // Write frequency registers (MSB, MID, LSB)
-    uint8_t FRQ_MSB = (uint8_t)((regFreq >> 16) & 0xFF);
-    uint8_t FRQ_MID = (uint8_t)((regFreq >> 8) & 0xFF);
-    uint8_t FRQ_LSB = (uint8_t)(regFreq & 0xFF);
-    
-    sx1276_writeReg(REG_FRF_MSB, FRQ_MSB);
-    sx1276_writeReg(REG_FRF_MID, FRQ_MID);
-    sx1276_writeReg(REG_FRF_LSB, FRQ_LSB);
+    uint8_t frf[3];
+    encodeFrequency(freq_hz, frf);
+    enterStandbyForFrequency(dev);
+    sx1276_writeBurst(dev, REG_FRF_MSB, frf, 3);
 }
 
-void sx1276_direct_setPower(uint8_t power) {
+void sx1276_direct_setPower(Sx1276Direct* dev, uint8_t power) {
     // SX1276 PA_CONFIG register (0x09):
     // Bit 7: PaSelect - 0=RFO, 1=PA_BOOST (use PA_BOOST for higher power)
     // Bits 6-4: MaxPower - not used when PA_BOOST selected
@@ -146,6 +223,9 @@ void sx1276_direct_setPower(uint8_t power) {
     
     if (power > 17) power = 17;  // Max without PA_DAC
     if (power < 2) power = 2;    // Min with PA_BOOST
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_POWER, power)) {
+        return;
+    }
     
     // PA_BOOST mode: Pout = 2 + OutputPower, so OutputPower = power - 2
     uint8_t outputPower = power - 2;
@@ -153,186 +233,348 @@ void sx1276_direct_setPower(uint8_t power) {
     
     // PA_BOOST (bit 7) + OutputPower (bits 3-0)
     uint8_t paConfig = 0x80 | outputPower;
-    sx1276_writeReg(REG_PA_CONFIG, paConfig);
+    sx1276_writeReg(dev, REG_PA_CONFIG, paConfig);
 }
 
-void sx1276_direct_setBandwidth(uint8_t bw) {
+void sx1276_direct_setBandwidth(Sx1276Direct* dev, uint8_t bw) {
     // BW: 0=7.8kHz, 1=10.4kHz, 2=15.6kHz, 3=20.8kHz, 4=31.25kHz, 5=41.7kHz, 6=62.5kHz, 7=125kHz, 8=250kHz, 9=500kHz
-    uint8_t config1 = sx1276_readReg(REG_MODEM_CONFIG_1);
-    config1 = (config1 & 0x0F) | (bw << 4);
-    sx1276_writeReg(REG_MODEM_CONFIG_1, config1);
+    if (radio_shadow_update(&dev->shadow, RADIO_PARAM_BANDWIDTH, bw & 0x0F)) {
+        writeModemConfig1(dev);
+    }
 }
 
-void sx1276_direct_setSpreadingFactor(uint8_t sf) {
-    // SF: 6-12
-    if (sf < 6) sf = 6;
-    if (sf > 12) sf = 12;
-    
-    uint8_t config2 = sx1276_readReg(REG_MODEM_CONFIG_2);
-    config2 = (config2 & 0x0F) | (sf << 4);
-    sx1276_writeReg(REG_MODEM_CONFIG_2, config2);
-    
-    // Configure MODEM_CONFIG_3 based on spreading factor
-    // Always keep AGC_AUTO_ON, add LOW_DATA_RATE_OPTIMIZE for SF11/SF12
-    uint8_t config3 = AGC_AUTO_ON;  // Always enable AGC
-    if (sf >= 11) {
-        // Enable Low Data Rate Optimize for SF11/SF12 with low bandwidths
-        // This is required for symbol times > 16ms
-        config3 |= LOW_DATA_RATE_OPTIMIZE;
+// SF6 requires special detection optimize settings (0x05 / 0x0C),
+// SF7-12 use the standard ones (0x03 / 0x0A)
+static void writeSpreadingFactorTuning(Sx1276Direct* dev, uint8_t sf) {
+    sx1276_writeReg(dev, REG_MODEM_CONFIG_3, encodeModemConfig3(sf));
+    sx1276_writeReg(dev, REG_DETECTION_OPTIMIZE, sf == 6 ? 0x05 : 0x03);
+    sx1276_writeReg(dev, REG_DETECTION_THRESHOLD, sf == 6 ? 0x0C : 0x0A);
+}
+
+void sx1276_direct_setSpreadingFactor(Sx1276Direct* dev, uint8_t sf) {
+    sf = clampSpreadingFactor(sf);
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_SPREADING_FACTOR, sf)) {
+        return;
     }
-    sx1276_writeReg(REG_MODEM_CONFIG_3, config3);
     
-    // SF6 requires special detection optimize settings
-    if (sf == 6) {
-        // For SF6, set detection optimize to 0x05 and threshold to 0x0C
-        sx1276_writeReg(REG_DETECTION_OPTIMIZE, 0x05);
-        sx1276_writeReg(REG_DETECTION_THRESHOLD, 0x0C);
-    } else {
-        // For SF7-12, use standard settings
-        sx1276_writeReg(REG_DETECTION_OPTIMIZE, 0x03);
-        sx1276_writeReg(REG_DETECTION_THRESHOLD, 0x0A);
+    writeModemConfig2(dev);
+    writeSpreadingFactorTuning(dev, sf);
+}
+
+void sx1276_direct_setCodingRate(Sx1276Direct* dev, uint8_t cr) {
+    cr = clampCodingRate(cr);
+    if (radio_shadow_update(&dev->shadow, RADIO_PARAM_CODING_RATE, cr)) {
+        writeModemConfig1(dev);
     }
 }
 
-void sx1276_direct_setCodingRate(uint8_t cr) {
-    if (cr < 5) cr = 5;
-    if (cr > 8) cr = 8;
+void sx1276_direct_setInvertIQ(Sx1276Direct* dev, bool invert) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_INVERT_IQ, invert)) {
+        return;
+    }
+    // Bit 6 (RX) and bit 0 (TX) over the register's other (reset) bits
+    sx1276_writeReg(dev, REG_INVERT_IQ, INVERT_IQ_RESERVED | (invert ? 0x41 : 0x00));
+}
+
+// Register image of one radio profile. Groups are in register order so each
+// is written in a single burst.
+typedef struct {
+    uint8_t frf[3];                 // REG_FRF_MSB..REG_FRF_LSB
+    uint8_t modemConfig[2];         // REG_MODEM_CONFIG_1..REG_MODEM_CONFIG_2
+    uint8_t preamble[2];            // REG_PREAMBLE_MSB..REG_PREAMBLE_LSB
+    uint8_t modemConfig3;
+    uint8_t detectionOptimize;
+    uint8_t detectionThreshold;
+    uint8_t syncWord;
+    uint8_t invertIQ;
+} SX1276ProfileImage;
+
+static_assert(sizeof(SX1276ProfileImage) <= sizeof(RadioProfile::image), "SX1276 profile image too large");
+
+void sx1276_direct_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    SX1276ProfileImage* image = (SX1276ProfileImage*)profile->image;
+    uint8_t sf = clampSpreadingFactor(settings->spreadingFactor);
+    
+    encodeFrequency(settings->frequencyHz, image->frf);
+    image->modemConfig[0] = encodeModemConfig1(settings->bandwidth & 0x0F, clampCodingRate(settings->codingRate),
+                                               settings->implicitHeader);
+    image->modemConfig[1] = encodeModemConfig2(sf, settings->crcEnabled);
+    image->preamble[0] = (uint8_t)(settings->preambleLength >> 8);
+    image->preamble[1] = (uint8_t)settings->preambleLength;
+    image->modemConfig3 = encodeModemConfig3(sf);
+    image->detectionOptimize = (sf == 6) ? 0x05 : 0x03;
+    image->detectionThreshold = (sf == 6) ? 0x0C : 0x0A;
+    image->syncWord = settings->syncWord;
+    image->invertIQ = INVERT_IQ_RESERVED | (settings->invertIQ ? 0x41 : 0x00);
     
-    uint8_t config1 = sx1276_readReg(REG_MODEM_CONFIG_1);
-    config1 = (config1 & 0xF1) | ((cr - 4) << 1);
-    sx1276_writeReg(REG_MODEM_CONFIG_1, config1);
+    profile->settings = *settings;
+    profile->compiled = true;
 }
 
-void sx1276_direct_setInvertIQ(bool invert) {
-    uint8_t invertIQ = sx1276_readReg(REG_INVERT_IQ);
-    if (invert) {
-        invertIQ |= 0x40; // Set bit 6
-        invertIQ |= 0x01;  // Set bit 0
-    } else {
-        invertIQ &= ~0x40; // Clear bit 6
-        invertIQ &= ~0x01;  // Clear bit 0
+void sx1276_direct_applyProfile(Sx1276Direct* dev, const RadioProfile* profile) {
+    unsigned long startUs = micros();
+    const SX1276ProfileImage* image = (const SX1276ProfileImage*)profile->image;
+    const RadioSettings* settings = &profile->settings;
+    
+    // Record every parameter in the shadow (same values the setters would
+    // store), then write only the register groups that changed
+    bool frequency = radio_shadow_update(&dev->shadow, RADIO_PARAM_FREQUENCY, settings->frequencyHz);
+    bool spreading = radio_shadow_update(&dev->shadow, RADIO_PARAM_SPREADING_FACTOR,
+                                         clampSpreadingFactor(settings->spreadingFactor));
+    bool modem = spreading;
+    modem |= radio_shadow_update(&dev->shadow, RADIO_PARAM_BANDWIDTH, settings->bandwidth & 0x0F);
+    modem |= radio_shadow_update(&dev->shadow, RADIO_PARAM_CODING_RATE, clampCodingRate(settings->codingRate));
+    modem |= radio_shadow_update(&dev->shadow, RADIO_PARAM_HEADER_MODE, settings->implicitHeader);
+    modem |= radio_shadow_update(&dev->shadow, RADIO_PARAM_CRC, settings->crcEnabled);
+    bool preamble = radio_shadow_update(&dev->shadow, RADIO_PARAM_PREAMBLE, settings->preambleLength);
+    bool syncWord = radio_shadow_update(&dev->shadow, RADIO_PARAM_SYNC_WORD, settings->syncWord);
+    bool invertIQ = radio_shadow_update(&dev->shadow, RADIO_PARAM_INVERT_IQ, settings->invertIQ);
+    
+    if (frequency) {
+        enterStandbyForFrequency(dev);
+        sx1276_writeBurst(dev, REG_FRF_MSB, image->frf, 3);
+    }
+    if (modem) {
+        sx1276_writeBurst(dev, REG_MODEM_CONFIG_1, image->modemConfig, 2);
+    }
+    if (preamble) {
+        sx1276_writeBurst(dev, REG_PREAMBLE_MSB, image->preamble, 2);
     }
-    sx1276_writeReg(REG_INVERT_IQ, invertIQ);
+    if (spreading) {
+        sx1276_writeReg(dev, REG_MODEM_CONFIG_3, image->modemConfig3);
+        sx1276_writeReg(dev, REG_DETECTION_OPTIMIZE, image->detectionOptimize);
+        sx1276_writeReg(dev, REG_DETECTION_THRESHOLD, image->detectionThreshold);
+    }
+    if (syncWord) {
+        sx1276_writeReg(dev, REG_SYNC_WORD, image->syncWord);
+    }
+    if (invertIQ) {
+        sx1276_writeReg(dev, REG_INVERT_IQ, image->invertIQ);
+    }
+    
+    radio_profile_recordSwitch(micros() - startUs);
 }
 
-void sx1276_direct_setMode(uint8_t mode) {
+void sx1276_direct_setMode(Sx1276Direct* dev, uint8_t mode) {
     // Clear IRQ flags before mode change
-    sx1276_writeReg(REG_IRQ_FLAGS, 0xFF);
+    sx1276_writeReg(dev, REG_IRQ_FLAGS, 0xFF);
     
     // Configure DIO0 mapping based on mode
     // DIO0 bits 7-6: 00=RxDone, 01=TxDone, 10=CadDone
     if (mode == MODE_TX) {
         // For TX mode, map DIO0 to TxDone (01 in bits 7-6)
-        sx1276_writeReg(REG_DIO_MAPPING_1, 0x40);
+        sx1276_writeReg(dev, REG_DIO_MAPPING_1, 0x40);
     } else if (mode == MODE_RX_CONTINUOUS) {
         // For RX mode, map DIO0 to RxDone (00 in bits 7-6)
-        sx1276_writeReg(REG_DIO_MAPPING_1, 0x00);
+        sx1276_writeReg(dev, REG_DIO_MAPPING_1, 0x00);
+    } else if (mode == MODE_CAD) {
+        // For CAD mode, map DIO0 to CadDone (10 in bits 7-6)
+        sx1276_writeReg(dev, REG_DIO_MAPPING_1, 0x80);
+    } else if (mode == MODE_SLEEP) {
+        dev->preloadValid = false; // FIFO is not retained in sleep
     }
     
     uint8_t targetMode = MODE_LONG_RANGE_MODE | mode;
-    sx1276_writeReg(REG_OP_MODE, targetMode);
+    sx1276_writeReg(dev, REG_OP_MODE, targetMode);
+    dev->opMode = mode;
 }
 
-void sx1276_direct_writeFifo(uint8_t* data, uint8_t len) {
-    sx1276_writeReg(REG_FIFO_ADDR_PTR, 0x00);
-    sx1276_writeReg(REG_PAYLOAD_LENGTH, len);
+void sx1276_direct_writeFifo(Sx1276Direct* dev, uint8_t* data, uint8_t len) {
+    dev->preloadValid = false;  // Uploaded from the bottom - may run into it
+    if (dev->txBaseAddr != 0x00) {
+        sx1276_writeReg(dev, REG_FIFO_TX_BASE_ADDR, 0x00);
+        dev->txBaseAddr = 0x00;
+    }
+    sx1276_writeReg(dev, REG_FIFO_ADDR_PTR, 0x00);
+    sx1276_writeReg(dev, REG_PAYLOAD_LENGTH, len);
     
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
     SPI.transfer(REG_FIFO | 0x80);
     for (uint8_t i = 0; i < len; i++) {
         SPI.transfer(data[i]);
     }
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
     SPI.endTransaction();
 }
 
-void sx1276_direct_readFifo(uint8_t* data, uint8_t len) {
-    uint8_t addr = sx1276_readReg(REG_FIFO_RX_CURRENT_ADDR);
-    sx1276_writeReg(REG_FIFO_ADDR_PTR, addr);
+bool sx1276_direct_preloadTx(Sx1276Direct* dev, const uint8_t* data, uint8_t len) {
+    dev->preloadValid = false;
+    if (len == 0) {
+        return false;
+    }
+    
+    // Written through the SPI address pointer - the receiver keeps its own
+    dev->preloadBase = (uint8_t)(256 - len);
+    dev->preloadLen = len;
+    dev->preloadRxByteAddr = sx1276_readReg(dev, REG_FIFO_RX_BYTE_ADDR);
+    sx1276_writeReg(dev, REG_FIFO_ADDR_PTR, dev->preloadBase);
+    sx1276_writeBurst(dev, REG_FIFO, data, len);
+    dev->preloadValid = true;
+    return true;
+}
+
+bool sx1276_direct_armTxPreload(Sx1276Direct* dev) {
+    if (!dev->preloadValid) {
+        return false;
+    }
+    dev->preloadValid = false;
+    
+    // The receiver only writes upwards from where it was: it has reached the
+    // preload if it is now inside it or has wrapped around. This also catches
+    // a reception cut short by leaving RX, which never raised RX_DONE.
+    uint8_t rxByteAddr = sx1276_readReg(dev, REG_FIFO_RX_BYTE_ADDR);
+    if (rxByteAddr != dev->preloadRxByteAddr &&
+        (rxByteAddr >= dev->preloadBase || rxByteAddr < dev->preloadRxByteAddr)) {
+        return false;
+    }
+    
+    sx1276_writeReg(dev, REG_FIFO_TX_BASE_ADDR, dev->preloadBase);
+    sx1276_writeReg(dev, REG_PAYLOAD_LENGTH, dev->preloadLen);
+    dev->txBaseAddr = dev->preloadBase;
+    return true;
+}
+
+void sx1276_direct_readFifo(Sx1276Direct* dev, uint8_t* data, uint8_t len) {
+    uint8_t addr = sx1276_readReg(dev, REG_FIFO_RX_CURRENT_ADDR);
+    sx1276_writeReg(dev, REG_FIFO_ADDR_PTR, addr);
     
-    SPI.beginTransaction(SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
-    digitalWrite(pin_nss, LOW);
+    SPI.beginTransaction(SPISettings(dev->spiFreq, MSBFIRST, SPI_MODE0));
+    digitalWrite(dev->pinNss, LOW);
     SPI.transfer(REG_FIFO & 0x7F);
     for (uint8_t i = 0; i < len; i++) {
         data[i] = SPI.transfer(0x00);
     }
-    digitalWrite(pin_nss, HIGH);
+    digitalWrite(dev->pinNss, HIGH);
     SPI.endTransaction();
 }
 
-int16_t sx1276_direct_getRssi() {
-    return -164 + sx1276_readReg(REG_PKT_RSSI_VALUE);
+// RegFifoRxCurrentAddr (0x10) through RegPktRssiValue (0x1A) hold everything
+// about the last frame, so one burst read replaces a read per getter
+#define RX_STATUS_FIRST  REG_FIFO_RX_CURRENT_ADDR
+#define RX_STATUS_LEN    (REG_PKT_RSSI_VALUE - REG_FIFO_RX_CURRENT_ADDR + 1)
+
+bool sx1276_direct_fetchFrame(Sx1276Direct* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    uint8_t status[RX_STATUS_LEN];
+    sx1276_readBurst(dev, RX_STATUS_FIRST, status, RX_STATUS_LEN);
+    uint8_t irqFlags = status[REG_IRQ_FLAGS - RX_STATUS_FIRST];
+    if ((irqFlags & IRQ_RX_DONE_MASK) == 0) {
+        return false;
+    }
+    
+    uint8_t rxLength = status[REG_RX_NB_BYTES - RX_STATUS_FIRST];
+    frame->rxLength = rxLength;
+    frame->length = (rxLength <= maxLen) ? rxLength : 0;
+    frame->rssi = -164 + status[REG_PKT_RSSI_VALUE - RX_STATUS_FIRST];
+    frame->snr = (int8_t)status[REG_PKT_SNR_VALUE - RX_STATUS_FIRST] / 4;
+    frame->crcError = (irqFlags & IRQ_CRC_ERROR_MASK) != 0;
+    
+    if (frame->length > 0) {
+        sx1276_writeReg(dev, REG_FIFO_ADDR_PTR, status[0]);
+        sx1276_readBurst(dev, REG_FIFO, data, frame->length);
+    }
+    sx1276_writeReg(dev, REG_IRQ_FLAGS, 0xFF);
+    return true;
+}
+
+int16_t sx1276_direct_getRssi(Sx1276Direct* dev) {
+    return -164 + sx1276_readReg(dev, REG_PKT_RSSI_VALUE);
 }
 
-int8_t sx1276_direct_getSnr() {
-    return (int8_t)sx1276_readReg(REG_PKT_SNR_VALUE) / 4;
+int8_t sx1276_direct_getSnr(Sx1276Direct* dev) {
+    return (int8_t)sx1276_readReg(dev, REG_PKT_SNR_VALUE) / 4;
 }
 
-void sx1276_direct_setPreambleLength(uint16_t length) {
-    sx1276_writeReg(REG_PREAMBLE_MSB, (uint8_t)(length >> 8));
-    sx1276_writeReg(REG_PREAMBLE_LSB, (uint8_t)(length));
+int16_t sx1276_direct_getRssiInst(Sx1276Direct* dev) {
+    // Same offset as the packet RSSI so the two compare
+    return -164 + sx1276_readReg(dev, REG_RSSI_VALUE);
 }
 
-void sx1276_direct_setCrc(bool enable) {
-    uint8_t config2 = sx1276_readReg(REG_MODEM_CONFIG_2);
-    if (enable) {
-        config2 |= 0x04;
-    } else {
-        config2 &= ~0x04;
+void sx1276_direct_setPreambleLength(Sx1276Direct* dev, uint16_t length) {
+    if (!radio_shadow_update(&dev->shadow, RADIO_PARAM_PREAMBLE, length)) {
+        return;
     }
-    sx1276_writeReg(REG_MODEM_CONFIG_2, config2);
+    uint8_t preamble[2] = { (uint8_t)(length >> 8), (uint8_t)length };
+    sx1276_writeBurst(dev, REG_PREAMBLE_MSB, preamble, 2);
 }
 
-void sx1276_direct_setSyncWord(uint8_t syncWord) {
-    sx1276_writeReg(REG_SYNC_WORD, syncWord);
+void sx1276_direct_setCrc(Sx1276Direct* dev, bool enable) {
+    // Bit 2 of REG_MODEM_CONFIG_2
+    if (radio_shadow_update(&dev->shadow, RADIO_PARAM_CRC, enable)) {
+        writeModemConfig2(dev);
+    }
+}
+
+void sx1276_direct_setSyncWord(Sx1276Direct* dev, uint8_t syncWord) {
+    if (radio_shadow_update(&dev->shadow, RADIO_PARAM_SYNC_WORD, syncWord)) {
+        sx1276_writeReg(dev, REG_SYNC_WORD, syncWord);
+    }
 }
 
-void sx1276_direct_setHeaderMode(bool implicit) {
+void sx1276_direct_setHeaderMode(Sx1276Direct* dev, bool implicit) {
     // Bit 0 of REG_MODEM_CONFIG_1: 0 = explicit, 1 = implicit
-    uint8_t config1 = sx1276_readReg(REG_MODEM_CONFIG_1);
-    if (implicit) {
-        config1 |= 0x01; // Set bit 0 for implicit header mode
-    } else {
-        config1 &= ~0x01; // Clear bit 0 for explicit header mode
+    if (radio_shadow_update(&dev->shadow, RADIO_PARAM_HEADER_MODE, implicit)) {
+        writeModemConfig1(dev);
     }
-    sx1276_writeReg(REG_MODEM_CONFIG_1, config1);
 }
 
-uint8_t sx1276_direct_readRegister(uint8_t reg) {
-    return sx1276_readReg(reg);
+uint8_t sx1276_direct_readRegister(Sx1276Direct* dev, uint8_t reg) {
+    return sx1276_readReg(dev, reg);
 }
 
-void sx1276_direct_writeRegister(uint8_t reg, uint8_t value) {
-    sx1276_writeReg(reg, value);
+void sx1276_direct_writeRegister(Sx1276Direct* dev, uint8_t reg, uint8_t value) {
+    // A raw write may change anything the shadow describes
+    radio_shadow_invalidate(&dev->shadow);
+    sx1276_writeReg(dev, reg, value);
 }
 
-void sx1276_direct_attachInterrupt(void (*handler)()) {
-    if (pin_dio0 >= 0) {
-        attachInterrupt(digitalPinToInterrupt(pin_dio0), handler, RISING);
+void sx1276_direct_attachInterrupt(Sx1276Direct* dev, void (*handler)()) {
+    if (dev->pinDio0 >= 0) {
+        attachInterrupt(digitalPinToInterrupt(dev->pinDio0), handler, RISING);
     }
 }
 
-bool sx1276_direct_isPacketReceived() {
-    uint8_t irqFlags = sx1276_readReg(REG_IRQ_FLAGS);
+bool sx1276_direct_isPacketReceived(Sx1276Direct* dev) {
+    uint8_t irqFlags = sx1276_readReg(dev, REG_IRQ_FLAGS);
     return (irqFlags & IRQ_RX_DONE_MASK) != 0;
 }
 
-uint8_t sx1276_direct_getPacketLength() {
-    return sx1276_readReg(REG_RX_NB_BYTES);
+bool sx1276_direct_isTransmitDone(Sx1276Direct* dev) {
+    uint8_t irqFlags = sx1276_readReg(dev, REG_IRQ_FLAGS);
+    return (irqFlags & IRQ_TX_DONE_MASK) != 0;
+}
+
+bool sx1276_direct_isCadDone(Sx1276Direct* dev) {
+    uint8_t irqFlags = sx1276_readReg(dev, REG_IRQ_FLAGS);
+    return (irqFlags & IRQ_CAD_DONE_MASK) != 0;
+}
+
+bool sx1276_direct_isChannelActive(Sx1276Direct* dev) {
+    uint8_t irqFlags = sx1276_readReg(dev, REG_IRQ_FLAGS);
+    return (irqFlags & IRQ_CAD_DETECTED_MASK) != 0;
+}
+
+bool sx1276_direct_isReceiving(Sx1276Direct* dev) {
+    // ModemStat drops back to idle once the frame ends, so no flag clearing needed
+    uint8_t modemStat = sx1276_readReg(dev, REG_MODEM_STAT);
+    return (modemStat & (MODEM_STAT_SIGNAL_SYNC | MODEM_STAT_HEADER_VALID)) != 0;
+}
+
+uint8_t sx1276_direct_getPacketLength(Sx1276Direct* dev) {
+    return sx1276_readReg(dev, REG_RX_NB_BYTES);
 }
 
-void sx1276_direct_clearIrqFlags() {
-    sx1276_writeReg(REG_IRQ_FLAGS, 0xFF); // Clear all flags
+void sx1276_direct_clearIrqFlags(Sx1276Direct* dev) {
+    sx1276_writeReg(dev, REG_IRQ_FLAGS, 0xFF); // Clear all flags
 }
 
-uint16_t sx1276_direct_getIrqFlags() {
+uint16_t sx1276_direct_getIrqFlags(Sx1276Direct* dev) {
     // SX1276 IRQ flags are 8-bit (unlike SX1262 which is 16-bit)
-    return (uint16_t)sx1276_readReg(REG_IRQ_FLAGS);
+    return (uint16_t)sx1276_readReg(dev, REG_IRQ_FLAGS);
 }
 
-bool sx1276_direct_hasPacketErrors() {
-    uint16_t irqFlags = sx1276_direct_getIrqFlags();
+bool sx1276_direct_hasPacketErrors(Sx1276Direct* dev) {
+    uint16_t irqFlags = sx1276_direct_getIrqFlags(dev);
     // Check CRC error (bit 5 = 0x20)
     if (irqFlags & IRQ_CRC_ERROR_MASK) {
         return true; // CRC error - packet corrupted
@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../radio_profile.h"
+#include "../radio_shadow.h"
+#include "../radio_frame.h"
+#include "../../platforms/platform_interface.h"
 
 // SX1276 Register Definitions (ATmega-specific)
 #define REG_FIFO                 0x00
@@ -18,14 +22,17 @@
 #define REG_FIFO_RX_CURRENT_ADDR 0x10
 #define REG_IRQ_FLAGS            0x12
 #define REG_RX_NB_BYTES          0x13
+#define REG_MODEM_STAT           0x18
+#define REG_PKT_SNR_VALUE        0x19
 #define REG_PKT_RSSI_VALUE       0x1A
-#define REG_PKT_SNR_VALUE        0x1B
+#define REG_RSSI_VALUE           0x1B
 #define REG_MODEM_CONFIG_1       0x1D
 #define REG_MODEM_CONFIG_2       0x1E
 #define REG_MODEM_CONFIG_3       0x26
 #define REG_PREAMBLE_MSB         0x20
 #define REG_PREAMBLE_LSB         0x21
 #define REG_PAYLOAD_LENGTH       0x22
+#define REG_FIFO_RX_BYTE_ADDR    0x25
 #define REG_DETECTION_OPTIMIZE   0x31
 #define REG_DETECTION_THRESHOLD  0x37
 #define REG_SYNC_WORD            0x39
@@ -39,6 +46,7 @@
 #define MODE_STDBY               0x01
 #define MODE_TX                  0x03
 #define MODE_RX_CONTINUOUS       0x05
+#define MODE_CAD                 0x07
 
 // IRQ Flags (SX1276 REG_IRQ_FLAGS bits)
 #define IRQ_TX_DONE_MASK         0x08
@@ -46,6 +54,12 @@
 #define IRQ_CRC_ERROR_MASK       0x20  // Payload CRC error
 #define IRQ_HEADER_VALID_MASK    0x10  // Valid header received
 #define IRQ_HEADER_ERROR_MASK    0x08  // Header CRC error (also used for TX_DONE)
+#define IRQ_CAD_DONE_MASK        0x04
+#define IRQ_CAD_DETECTED_MASK    0x01
+
+// Modem status (SX1276 REG_MODEM_STAT bits, live - not latched)
+#define MODEM_STAT_SIGNAL_SYNC   0x02  // Preamble locked
+#define MODEM_STAT_HEADER_VALID  0x08  // Header decoded, payload incoming
 
 // Frequency Range Constants (SX1276: 137-1020 MHz)
 #define SX1276_MIN_FREQUENCY_HZ  137000000UL
@@ -59,32 +73,68 @@
 #define AGC_AUTO_ON              0b00000100  // Bit 2: Enable AGC auto (CRITICAL for RX!)
 #define LOW_DATA_RATE_OPTIMIZE   0b00001000  // Bit 3: Enable for SF11/SF12 with low BW
 
-// Function Prototypes (internal implementation)
-bool sx1276_direct_init();
+// RegInvertIQ reset value (0x27) without the RX (bit 6) and TX (bit 0) invert bits
+#define INVERT_IQ_RESERVED       0x26
+
+// One SX1276 on its own pins. Every function takes the radio it acts on, so
+// a platform can run one instance per fitted radio; the caller owns the
+// storage and calls init first.
+typedef struct {
+    int8_t pinNss;
+    int8_t pinReset;
+    int8_t pinDio0;
+    uint32_t spiFreq;
+    
+    // Last applied modem configuration and operating mode - setters skip
+    // unchanged values and build packed registers from here, never read back
+    RadioShadow shadow;
+    uint8_t opMode;
+    
+    // TX preload: the frame sits at the top of the FIFO (preloadBase..0xFF)
+    // while the receiver writes upwards from RX base 0x00
+    uint8_t txBaseAddr;
+    uint8_t preloadBase;
+    uint8_t preloadLen;
+    uint8_t preloadRxByteAddr;      // Receiver position when the preload was written
+    bool preloadValid;
+} Sx1276Direct;
+
+// Function Prototypes (internal implementation, plus the instance)
+bool sx1276_direct_init(Sx1276Direct* dev, const RadioPins* pins);
 uint32_t sx1276_direct_getMinFrequency();
 uint32_t sx1276_direct_getMaxFrequency();
-void sx1276_direct_setFrequency(uint32_t freq_hz);
-void sx1276_direct_setPower(uint8_t power);
-void sx1276_direct_setPreambleLength(uint16_t length);
-void sx1276_direct_setCrc(bool enable);
-void sx1276_direct_setSyncWord(uint8_t syncWord);
-void sx1276_direct_setHeaderMode(bool implicit);
-void sx1276_direct_setBandwidth(uint8_t bw);
-void sx1276_direct_setSpreadingFactor(uint8_t sf);
-void sx1276_direct_setCodingRate(uint8_t cr);
-void sx1276_direct_setInvertIQ(bool invert);
-void sx1276_direct_setMode(uint8_t mode);
-void sx1276_direct_writeFifo(uint8_t* data, uint8_t len);
-void sx1276_direct_readFifo(uint8_t* data, uint8_t len);
-int16_t sx1276_direct_getRssi();
-int8_t sx1276_direct_getSnr();
-uint8_t sx1276_direct_readRegister(uint8_t reg);
-void sx1276_direct_writeRegister(uint8_t reg, uint8_t value);
-void sx1276_direct_attachInterrupt(void (*handler)());
-bool sx1276_direct_isPacketReceived();
-uint8_t sx1276_direct_getPacketLength();
-void sx1276_direct_clearIrqFlags();
-uint16_t sx1276_direct_getIrqFlags();
-bool sx1276_direct_hasPacketErrors();
+void sx1276_direct_setFrequency(Sx1276Direct* dev, uint32_t freq_hz);
+void sx1276_direct_setPower(Sx1276Direct* dev, uint8_t power);
+void sx1276_direct_setPreambleLength(Sx1276Direct* dev, uint16_t length);
+void sx1276_direct_setCrc(Sx1276Direct* dev, bool enable);
+void sx1276_direct_setSyncWord(Sx1276Direct* dev, uint8_t syncWord);
+void sx1276_direct_setHeaderMode(Sx1276Direct* dev, bool implicit);
+void sx1276_direct_setBandwidth(Sx1276Direct* dev, uint8_t bw);
+void sx1276_direct_setSpreadingFactor(Sx1276Direct* dev, uint8_t sf);
+void sx1276_direct_setCodingRate(Sx1276Direct* dev, uint8_t cr);
+void sx1276_direct_setInvertIQ(Sx1276Direct* dev, bool invert);
+void sx1276_direct_compileProfile(const RadioSettings* settings, RadioProfile* profile);
+void sx1276_direct_applyProfile(Sx1276Direct* dev, const RadioProfile* profile);
+void sx1276_direct_setMode(Sx1276Direct* dev, uint8_t mode);
+void sx1276_direct_writeFifo(Sx1276Direct* dev, uint8_t* data, uint8_t len);
+bool sx1276_direct_preloadTx(Sx1276Direct* dev, const uint8_t* data, uint8_t len);
+bool sx1276_direct_armTxPreload(Sx1276Direct* dev);
+void sx1276_direct_readFifo(Sx1276Direct* dev, uint8_t* data, uint8_t len);
+bool sx1276_direct_fetchFrame(Sx1276Direct* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame);
+int16_t sx1276_direct_getRssi(Sx1276Direct* dev);
+int8_t sx1276_direct_getSnr(Sx1276Direct* dev);
+int16_t sx1276_direct_getRssiInst(Sx1276Direct* dev);
+uint8_t sx1276_direct_readRegister(Sx1276Direct* dev, uint8_t reg);
+void sx1276_direct_writeRegister(Sx1276Direct* dev, uint8_t reg, uint8_t value);
+void sx1276_direct_attachInterrupt(Sx1276Direct* dev, void (*handler)());
+bool sx1276_direct_isPacketReceived(Sx1276Direct* dev);
+bool sx1276_direct_isTransmitDone(Sx1276Direct* dev);
+bool sx1276_direct_isCadDone(Sx1276Direct* dev);
+bool sx1276_direct_isChannelActive(Sx1276Direct* dev);
+bool sx1276_direct_isReceiving(Sx1276Direct* dev);
+uint8_t sx1276_direct_getPacketLength(Sx1276Direct* dev);
+void sx1276_direct_clearIrqFlags(Sx1276Direct* dev);
+uint16_t sx1276_direct_getIrqFlags(Sx1276Direct* dev);
+bool sx1276_direct_hasPacketErrors(Sx1276Direct* dev);
 
 #endif // SX1276_DIRECT_H
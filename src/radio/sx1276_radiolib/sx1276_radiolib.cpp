@@ -28,33 +28,44 @@ extern SPIClass SPI;
 
 // Then include our headers (which may reference RadioLib types)
 #include "sx1276_radiolib.h"
+#include "../radio_shadow.h"
 #include "../../platforms/platform_interface.h"
 // Note: We use numeric constants (0x00, 0x01, 0x03, 0x05) in switch statements
 // to avoid conflicts with RadioLib's Module::MODE_* enum
 
-// RadioLib module instance
-static Module* radioModule = nullptr;
-static SX1276* radio = nullptr;
+// RadioLib calls its interrupt actions without arguments - one entry point
+// per instance slot finds the radio that raised DIO0
+static Sx1276RadioLib* isrInstances[SX1276_RADIOLIB_MAX_INSTANCES];
 
-// Interrupt handler
-static void (*interruptHandler)() = nullptr;
-
-// Buffer for pending transmission
-static uint8_t* pendingTxData = nullptr;
-static uint8_t pendingTxLen = 0;
-
-// Interrupt service routine
-static void sx1276_isr() {
-    if (interruptHandler != nullptr) {
-        interruptHandler();
+static void dispatchIsr(Sx1276RadioLib* dev) {
+    if (dev != nullptr && dev->interruptHandler != nullptr) {
+        dev->interruptHandler();
     }
 }
 
-bool sx1276_radiolib_init() {
-    // Get pin numbers from platform interface
-    int8_t pin_nss = platform_getRadioNssPin();
-    int8_t pin_reset = platform_getRadioResetPin();
-    int8_t pin_dio0 = platform_getRadioDio0Pin();
+static void sx1276_isr0() { dispatchIsr(isrInstances[0]); }
+static void sx1276_isr1() { dispatchIsr(isrInstances[1]); }
+
+static void (*const isrEntries[SX1276_RADIOLIB_MAX_INSTANCES])() = { sx1276_isr0, sx1276_isr1 };
+
+bool sx1276_radiolib_init(Sx1276RadioLib* dev, uint8_t index, const RadioPins* pins) {
+    radio_shadow_invalidate(&dev->shadow);
+    dev->pendingTxData = nullptr;
+    dev->pendingTxLen = 0;
+    if (index >= SX1276_RADIOLIB_MAX_INSTANCES) {
+        return false;
+    }
+    
+    // Called again to recover from a radio fault - drop the old instances
+    delete dev->radio;
+    dev->radio = nullptr;
+    delete dev->module;
+    dev->module = nullptr;
+    
+    // Pins of this radio (platform_getRadioPins())
+    int8_t pin_nss = pins->nss;
+    int8_t pin_reset = pins->reset;
+    int8_t pin_dio0 = pins->dio0;
     uint32_t spi_freq = platform_getSpiFrequency();
     
     // Validate required pins
@@ -73,21 +84,22 @@ bool sx1276_radiolib_init() {
     SPI.begin();
     
     // Create RadioLib module
-    radioModule = new Module(pin_nss, pin_dio0, pin_reset, -1, SPI, SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
+    dev->module = new Module(pin_nss, pin_dio0, pin_reset, -1, SPI, SPISettings(spi_freq, MSBFIRST, SPI_MODE0));
     
     // Create SX1276 instance
-    radio = new SX1276(radioModule);
+    dev->radio = new SX1276(dev->module);
     
     // Initialize radio
-    int state = radio->begin();
+    int state = dev->radio->begin();
     if (state != RADIOLIB_ERR_NONE) {
         return false;
     }
     
     // Set DIO0 interrupt mapping (TX_DONE and RX_DONE)
     // Use setPacketReceivedAction which handles interrupt setup internally
-    radio->setPacketReceivedAction(sx1276_isr);
-    radio->setPacketSentAction(sx1276_isr);
+    isrInstances[index] = dev;
+    dev->radio->setPacketReceivedAction(isrEntries[index]);
+    dev->radio->setPacketSentAction(isrEntries[index]);
     
     return true;
 }
@@ -100,176 +112,297 @@ uint32_t sx1276_radiolib_getMaxFrequency() {
     return SX1276_MAX_FREQUENCY_HZ;
 }
 
-void sx1276_radiolib_setFrequency(uint32_t freq_hz) {
-    if (radio != nullptr) {
-        radio->setFrequency((float)freq_hz / 1000000.0);
+// Send `param` only if it changed; a rejected value leaves it unknown so the
+// next call retries it
+static bool shadowChanged(Sx1276RadioLib* dev, RadioParam param, uint32_t value) {
+    return dev->radio != nullptr && radio_shadow_update(&dev->shadow, param, value);
+}
+
+static void checkApplied(Sx1276RadioLib* dev, RadioParam param, int16_t state) {
+    if (state != RADIOLIB_ERR_NONE) {
+        radio_shadow_forget(&dev->shadow, param);
+    }
+}
+
+void sx1276_radiolib_setFrequency(Sx1276RadioLib* dev, uint32_t freq_hz) {
+    if (shadowChanged(dev, RADIO_PARAM_FREQUENCY, freq_hz)) {
+        checkApplied(dev, RADIO_PARAM_FREQUENCY, dev->radio->setFrequency((float)freq_hz / 1000000.0));
     }
 }
 
-void sx1276_radiolib_setPower(uint8_t power) {
-    if (radio != nullptr) {
-        radio->setOutputPower(power);
+void sx1276_radiolib_setPower(Sx1276RadioLib* dev, uint8_t power) {
+    if (shadowChanged(dev, RADIO_PARAM_POWER, power)) {
+        checkApplied(dev, RADIO_PARAM_POWER, dev->radio->setOutputPower(power));
     }
 }
 
-void sx1276_radiolib_setPreambleLength(uint16_t length) {
-    if (radio != nullptr) {
-        radio->setPreambleLength(length);
+void sx1276_radiolib_setPreambleLength(Sx1276RadioLib* dev, uint16_t length) {
+    if (shadowChanged(dev, RADIO_PARAM_PREAMBLE, length)) {
+        checkApplied(dev, RADIO_PARAM_PREAMBLE, dev->radio->setPreambleLength(length));
     }
 }
 
-void sx1276_radiolib_setCrc(bool enable) {
-    if (radio != nullptr) {
-        radio->setCRC(enable ? 2 : 0); // 0 = disabled, 2 = enabled
+void sx1276_radiolib_setCrc(Sx1276RadioLib* dev, bool enable) {
+    if (shadowChanged(dev, RADIO_PARAM_CRC, enable)) {
+        checkApplied(dev, RADIO_PARAM_CRC, dev->radio->setCRC(enable ? 2 : 0)); // 0 = disabled, 2 = enabled
     }
 }
 
-void sx1276_radiolib_setSyncWord(uint8_t syncWord) {
-    if (radio != nullptr) {
-        radio->setSyncWord(syncWord);
+void sx1276_radiolib_setSyncWord(Sx1276RadioLib* dev, uint8_t syncWord) {
+    if (shadowChanged(dev, RADIO_PARAM_SYNC_WORD, syncWord)) {
+        checkApplied(dev, RADIO_PARAM_SYNC_WORD, dev->radio->setSyncWord(syncWord));
     }
 }
 
-void sx1276_radiolib_setHeaderMode(bool implicit) {
-    if (radio != nullptr) {
+void sx1276_radiolib_setHeaderMode(Sx1276RadioLib* dev, bool implicit) {
+    if (shadowChanged(dev, RADIO_PARAM_HEADER_MODE, implicit)) {
         if (implicit) {
-            radio->implicitHeader(0xFF); // Use max length for implicit header
+            checkApplied(dev, RADIO_PARAM_HEADER_MODE, dev->radio->implicitHeader(0xFF)); // Use max length for implicit header
         } else {
-            radio->explicitHeader();
+            checkApplied(dev, RADIO_PARAM_HEADER_MODE, dev->radio->explicitHeader());
         }
     }
 }
 
-void sx1276_radiolib_setBandwidth(uint8_t bw) {
-    if (radio != nullptr) {
-        // Convert bandwidth code to RadioLib bandwidth
-        // bw codes: 0=7.8kHz, 1=10.4kHz, 2=15.6kHz, 3=20.8kHz, 4=31.25kHz, 5=41.7kHz, 6=62.5kHz, 7=125kHz, 8=250kHz, 9=500kHz
-        float bandwidths[] = {7.8, 10.4, 15.6, 20.8, 31.25, 41.7, 62.5, 125.0, 250.0, 500.0};
-        if (bw < sizeof(bandwidths)/sizeof(bandwidths[0])) {
-            radio->setBandwidth(bandwidths[bw]);
-        }
+// Convert bandwidth code to RadioLib bandwidth in kHz (0 for an invalid code)
+// bw codes: 0=7.8kHz, 1=10.4kHz, 2=15.6kHz, 3=20.8kHz, 4=31.25kHz, 5=41.7kHz, 6=62.5kHz, 7=125kHz, 8=250kHz, 9=500kHz
+static float bandwidthKHz(uint8_t bw) {
+    static const float bandwidths[] = {7.8, 10.4, 15.6, 20.8, 31.25, 41.7, 62.5, 125.0, 250.0, 500.0};
+    return bw < sizeof(bandwidths)/sizeof(bandwidths[0]) ? bandwidths[bw] : 0.0f;
+}
+
+void sx1276_radiolib_setBandwidth(Sx1276RadioLib* dev, uint8_t bw) {
+    float khz = bandwidthKHz(bw);
+    if (khz > 0.0f && shadowChanged(dev, RADIO_PARAM_BANDWIDTH, bw)) {
+        checkApplied(dev, RADIO_PARAM_BANDWIDTH, dev->radio->setBandwidth(khz));
     }
 }
 
-void sx1276_radiolib_setSpreadingFactor(uint8_t sf) {
-    if (radio != nullptr) {
-        radio->setSpreadingFactor(sf);
+void sx1276_radiolib_setSpreadingFactor(Sx1276RadioLib* dev, uint8_t sf) {
+    if (shadowChanged(dev, RADIO_PARAM_SPREADING_FACTOR, sf)) {
+        checkApplied(dev, RADIO_PARAM_SPREADING_FACTOR, dev->radio->setSpreadingFactor(sf));
     }
 }
 
-void sx1276_radiolib_setCodingRate(uint8_t cr) {
-    if (radio != nullptr) {
-        radio->setCodingRate(cr);
+void sx1276_radiolib_setCodingRate(Sx1276RadioLib* dev, uint8_t cr) {
+    if (shadowChanged(dev, RADIO_PARAM_CODING_RATE, cr)) {
+        checkApplied(dev, RADIO_PARAM_CODING_RATE, dev->radio->setCodingRate(cr));
     }
 }
 
-void sx1276_radiolib_setInvertIQ(bool invert) {
-    if (radio != nullptr) {
-        radio->invertIQ(invert);
+void sx1276_radiolib_setInvertIQ(Sx1276RadioLib* dev, bool invert) {
+    if (shadowChanged(dev, RADIO_PARAM_INVERT_IQ, invert)) {
+        checkApplied(dev, RADIO_PARAM_INVERT_IQ, dev->radio->invertIQ(invert));
     }
 }
 
-void sx1276_radiolib_setMode(uint8_t mode) {
-    if (radio == nullptr) return;
+// RadioLib takes frequency and bandwidth as floating point MHz/kHz and builds
+// the SPI commands itself (its cached packet parameters must stay in sync), so
+// a profile holds the converted arguments; everything else passes through
+typedef struct {
+    float frequencyMHz;
+    float bandwidthKHz;
+} RadioLibProfileImage;
+
+static_assert(sizeof(RadioLibProfileImage) <= sizeof(RadioProfile::image), "RadioLib profile image too large");
+
+void sx1276_radiolib_compileProfile(const RadioSettings* settings, RadioProfile* profile) {
+    RadioLibProfileImage* image = (RadioLibProfileImage*)profile->image;
+    image->frequencyMHz = (float)settings->frequencyHz / 1000000.0f;
+    image->bandwidthKHz = bandwidthKHz(settings->bandwidth);
+    profile->settings = *settings;
+    profile->compiled = true;
+}
+
+void sx1276_radiolib_applyProfile(Sx1276RadioLib* dev, const RadioProfile* profile) {
+    if (dev->radio == nullptr) return;
+    unsigned long startUs = micros();
+    const RadioLibProfileImage* image = (const RadioLibProfileImage*)profile->image;
+    const RadioSettings* settings = &profile->settings;
+    
+    if (shadowChanged(dev, RADIO_PARAM_FREQUENCY, settings->frequencyHz)) {
+        checkApplied(dev, RADIO_PARAM_FREQUENCY, dev->radio->setFrequency(image->frequencyMHz));
+    }
+    if (image->bandwidthKHz > 0.0f && shadowChanged(dev, RADIO_PARAM_BANDWIDTH, settings->bandwidth)) {
+        checkApplied(dev, RADIO_PARAM_BANDWIDTH, dev->radio->setBandwidth(image->bandwidthKHz));
+    }
+    sx1276_radiolib_setSpreadingFactor(dev, settings->spreadingFactor);
+    sx1276_radiolib_setCodingRate(dev, settings->codingRate);
+    sx1276_radiolib_setSyncWord(dev, settings->syncWord);
+    sx1276_radiolib_setPreambleLength(dev, settings->preambleLength);
+    sx1276_radiolib_setHeaderMode(dev, settings->implicitHeader);
+    sx1276_radiolib_setInvertIQ(dev, settings->invertIQ);
+    sx1276_radiolib_setCrc(dev, settings->crcEnabled);
+    
+    radio_profile_recordSwitch(micros() - startUs);
+}
+
+void sx1276_radiolib_setMode(Sx1276RadioLib* dev, uint8_t mode) {
+    if (dev->radio == nullptr) return;
     
     // Use numeric constants to avoid conflicts with RadioLib's MODE_* definitions
     switch (mode) {
         case 0x00: // MODE_SLEEP
-            radio->sleep();
+            dev->radio->sleep();
             break;
         case 0x01: // MODE_STDBY
-            radio->standby();
+            dev->radio->standby();
             break;
         case 0x03: // MODE_TX
             // Start transmission with pending data
-            if (pendingTxData != nullptr && pendingTxLen > 0) {
-                radio->startTransmit(pendingTxData, pendingTxLen);
-                pendingTxData = nullptr;
-                pendingTxLen = 0;
+            if (dev->pendingTxData != nullptr && dev->pendingTxLen > 0) {
+                dev->radio->startTransmit(dev->pendingTxData, dev->pendingTxLen);
+                dev->pendingTxData = nullptr;
+                dev->pendingTxLen = 0;
             }
             break;
         case 0x05: // MODE_RX_CONTINUOUS
-            radio->startReceive();
+            dev->radio->startReceive();
+            break;
+        case 0x07: // MODE_CAD
+            // RadioLib picks CAD parameters for the current SF and routes CAD IRQs to the DIO pin
+            dev->radio->startChannelScan();
             break;
     }
 }
 
-void sx1276_radiolib_writeFifo(uint8_t* data, uint8_t len) {
-    if (radio != nullptr && data != nullptr) {
+void sx1276_radiolib_writeFifo(Sx1276RadioLib* dev, uint8_t* data, uint8_t len) {
+    if (dev->radio != nullptr && data != nullptr) {
         // Store data for transmission (will be sent when setMode(MODE_TX) is called)
         // Note: This assumes data buffer remains valid until transmission starts
-        pendingTxData = data;
-        pendingTxLen = len;
+        dev->pendingTxData = data;
+        dev->pendingTxLen = len;
+    }
+}
+
+void sx1276_radiolib_readFifo(Sx1276RadioLib* dev, uint8_t* data, uint8_t len) {
+    if (dev->radio != nullptr && data != nullptr) {
+        dev->radio->readData(data, len);
     }
 }
 
-void sx1276_radiolib_readFifo(uint8_t* data, uint8_t len) {
-    if (radio != nullptr && data != nullptr) {
-        radio->readData(data, len);
+bool sx1276_radiolib_fetchFrame(Sx1276RadioLib* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame) {
+    if (dev->radio == nullptr) return false;
+    
+    uint16_t irqFlags = dev->radio->getIRQFlags();
+    if ((irqFlags & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_RX_DONE) == 0) {
+        return false;
     }
+    uint8_t rxLength = (uint8_t)dev->radio->getPacketLength();
+    frame->rxLength = rxLength;
+    frame->length = (rxLength <= maxLen) ? rxLength : 0;
+    frame->rssi = (int16_t)dev->radio->getRSSI();
+    frame->snr = (int8_t)dev->radio->getSNR();
+    frame->crcError = (irqFlags & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_PAYLOAD_CRC_ERROR) != 0;
+    
+    // readData() reads the FIFO and clears the IRQs
+    if (frame->length > 0) {
+        dev->radio->readData(data, frame->length);
+    } else {
+        dev->radio->clearIrqFlags(RADIOLIB_SX127X_FLAGS_ALL);
+    }
+    return true;
 }
 
-int16_t sx1276_radiolib_getRssi() {
-    if (radio != nullptr) {
-        return radio->getRSSI();
+int16_t sx1276_radiolib_getRssi(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getRSSI();
     }
     return -127;
 }
 
-int8_t sx1276_radiolib_getSnr() {
-    if (radio != nullptr) {
-        return radio->getSNR();
+int8_t sx1276_radiolib_getSnr(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getSNR();
     }
     return 0;
 }
 
-uint8_t sx1276_radiolib_readRegister(uint8_t reg) {
-    if (radioModule != nullptr) {
-        return radioModule->SPIreadRegister(reg);
+int16_t sx1276_radiolib_getRssiInst(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getRSSI(false, true); // Current RSSI, without restarting RX
+    }
+    return -127;
+}
+
+uint8_t sx1276_radiolib_readRegister(Sx1276RadioLib* dev, uint8_t reg) {
+    if (dev->module != nullptr) {
+        return dev->module->SPIreadRegister(reg);
     }
     return 0;
 }
 
-void sx1276_radiolib_writeRegister(uint8_t reg, uint8_t value) {
-    if (radioModule != nullptr) {
-        radioModule->SPIwriteRegister(reg, value);
+void sx1276_radiolib_writeRegister(Sx1276RadioLib* dev, uint8_t reg, uint8_t value) {
+    // A raw write may change anything the shadow describes
+    radio_shadow_invalidate(&dev->shadow);
+    if (dev->module != nullptr) {
+        dev->module->SPIwriteRegister(reg, value);
     }
 }
 
-void sx1276_radiolib_attachInterrupt(void (*handler)()) {
-    interruptHandler = handler;
+void sx1276_radiolib_attachInterrupt(Sx1276RadioLib* dev, void (*handler)()) {
+    dev->interruptHandler = handler;
+}
+
+bool sx1276_radiolib_isPacketReceived(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->available();
+    }
+    return false;
+}
+
+bool sx1276_radiolib_isTransmitDone(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIRQFlags() & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_TX_DONE) != 0;
+    }
+    return false;
+}
+
+bool sx1276_radiolib_isCadDone(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIRQFlags() & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_CAD_DONE) != 0;
+    }
+    return false;
+}
+
+bool sx1276_radiolib_isChannelActive(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return (dev->radio->getIRQFlags() & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_CAD_DETECTED) != 0;
+    }
+    return false;
 }
 
-bool sx1276_radiolib_isPacketReceived() {
-    if (radio != nullptr) {
-        return radio->available();
+bool sx1276_radiolib_isReceiving(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        // RegModemStat: bit 1 = preamble locked, bit 3 = header valid
+        return (dev->radio->getModemStatus() & 0x0A) != 0;
     }
     return false;
 }
 
-uint8_t sx1276_radiolib_getPacketLength() {
-    if (radio != nullptr) {
-        return radio->getPacketLength();
+uint8_t sx1276_radiolib_getPacketLength(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getPacketLength();
     }
     return 0;
 }
 
-void sx1276_radiolib_clearIrqFlags() {
-    if (radio != nullptr) {
-        radio->clearIrqFlags(RADIOLIB_SX127X_FLAGS_ALL);
+void sx1276_radiolib_clearIrqFlags(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        dev->radio->clearIrqFlags(RADIOLIB_SX127X_FLAGS_ALL);
     }
 }
 
-uint16_t sx1276_radiolib_getIrqFlags() {
-    if (radio != nullptr) {
-        return radio->getIRQFlags();
+uint16_t sx1276_radiolib_getIrqFlags(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        return dev->radio->getIRQFlags();
     }
     return 0;
 }
 
-bool sx1276_radiolib_hasPacketErrors() {
-    if (radio != nullptr) {
-        uint16_t flags = radio->getIRQFlags();
+bool sx1276_radiolib_hasPacketErrors(Sx1276RadioLib* dev) {
+    if (dev->radio != nullptr) {
+        uint16_t flags = dev->radio->getIRQFlags();
         // Check for payload CRC error (SX127x doesn't have separate header CRC error flag)
         return (flags & RADIOLIB_SX127X_CLEAR_IRQ_FLAG_PAYLOAD_CRC_ERROR) != 0;
     }
@@ -3,6 +3,10 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../radio_profile.h"
+#include "../radio_shadow.h"
+#include "../radio_frame.h"
+#include "../../platforms/platform_interface.h"
 
 // SX1276 Register Definitions (for compatibility)
 #define REG_FIFO                 0x00
@@ -49,32 +53,63 @@
 #define SX1276_MIN_FREQUENCY_HZ  137000000UL
 #define SX1276_MAX_FREQUENCY_HZ 1020000000UL
 
-// Function Prototypes (matches sx1276_direct interface)
-bool sx1276_radiolib_init();
+// Radios one build can drive (each needs its own interrupt entry point)
+#define SX1276_RADIOLIB_MAX_INSTANCES 2
+
+class Module;
+class SX1276;
+
+// One SX1276 driven through RadioLib. Every function takes the radio it acts
+// on, so a platform can run one instance per fitted radio, each on its own
+// pins; the caller owns the storage (zero-initialized) and calls init first.
+typedef struct {
+    Module* module;
+    SX1276* radio;
+    void (*interruptHandler)();
+    
+    // Last applied modem configuration - each RadioLib setter is a separate
+    // SPI command sequence, so unchanged parameters are not sent again
+    RadioShadow shadow;
+    
+    // Frame for the next setMode(MODE_TX) (writeFifo() keeps the pointer)
+    uint8_t* pendingTxData;
+    uint8_t pendingTxLen;
+} Sx1276RadioLib;
+
+// Function Prototypes (matches sx1276_direct interface, plus the instance)
+bool sx1276_radiolib_init(Sx1276RadioLib* dev, uint8_t index, const RadioPins* pins);
 uint32_t sx1276_radiolib_getMinFrequency();
 uint32_t sx1276_radiolib_getMaxFrequency();
-void sx1276_radiolib_setFrequency(uint32_t freq_hz);
-void sx1276_radiolib_setPower(uint8_t power);
-void sx1276_radiolib_setPreambleLength(uint16_t length);
-void sx1276_radiolib_setCrc(bool enable);
-void sx1276_radiolib_setSyncWord(uint8_t syncWord);
-void sx1276_radiolib_setHeaderMode(bool implicit);
-void sx1276_radiolib_setBandwidth(uint8_t bw);
-void sx1276_radiolib_setSpreadingFactor(uint8_t sf);
-void sx1276_radiolib_setCodingRate(uint8_t cr);
-void sx1276_radiolib_setInvertIQ(bool invert);
-void sx1276_radiolib_setMode(uint8_t mode);
-void sx1276_radiolib_writeFifo(uint8_t* data, uint8_t len);
-void sx1276_radiolib_readFifo(uint8_t* data, uint8_t len);
-int16_t sx1276_radiolib_getRssi();
-int8_t sx1276_radiolib_getSnr();
-uint8_t sx1276_radiolib_readRegister(uint8_t reg);
-void sx1276_radiolib_writeRegister(uint8_t reg, uint8_t value);
-void sx1276_radiolib_attachInterrupt(void (*handler)());
-bool sx1276_radiolib_isPacketReceived();
-uint8_t sx1276_radiolib_getPacketLength();
-void sx1276_radiolib_clearIrqFlags();
-uint16_t sx1276_radiolib_getIrqFlags();
-bool sx1276_radiolib_hasPacketErrors();
+void sx1276_radiolib_setFrequency(Sx1276RadioLib* dev, uint32_t freq_hz);
+void sx1276_radiolib_setPower(Sx1276RadioLib* dev, uint8_t power);
+void sx1276_radiolib_setPreambleLength(Sx1276RadioLib* dev, uint16_t length);
+void sx1276_radiolib_setCrc(Sx1276RadioLib* dev, bool enable);
+void sx1276_radiolib_setSyncWord(Sx1276RadioLib* dev, uint8_t syncWord);
+void sx1276_radiolib_setHeaderMode(Sx1276RadioLib* dev, bool implicit);
+void sx1276_radiolib_setBandwidth(Sx1276RadioLib* dev, uint8_t bw);
+void sx1276_radiolib_setSpreadingFactor(Sx1276RadioLib* dev, uint8_t sf);
+void sx1276_radiolib_setCodingRate(Sx1276RadioLib* dev, uint8_t cr);
+void sx1276_radiolib_setInvertIQ(Sx1276RadioLib* dev, bool invert);
+void sx1276_radiolib_compileProfile(const RadioSettings* settings, RadioProfile* profile);
+void sx1276_radiolib_applyProfile(Sx1276RadioLib* dev, const RadioProfile* profile);
+void sx1276_radiolib_setMode(Sx1276RadioLib* dev, uint8_t mode);
+void sx1276_radiolib_writeFifo(Sx1276RadioLib* dev, uint8_t* data, uint8_t len);
+void sx1276_radiolib_readFifo(Sx1276RadioLib* dev, uint8_t* data, uint8_t len);
+bool sx1276_radiolib_fetchFrame(Sx1276RadioLib* dev, uint8_t* data, uint8_t maxLen, RadioFrame* frame);
+int16_t sx1276_radiolib_getRssi(Sx1276RadioLib* dev);
+int8_t sx1276_radiolib_getSnr(Sx1276RadioLib* dev);
+int16_t sx1276_radiolib_getRssiInst(Sx1276RadioLib* dev);
+uint8_t sx1276_radiolib_readRegister(Sx1276RadioLib* dev, uint8_t reg);
+void sx1276_radiolib_writeRegister(Sx1276RadioLib* dev, uint8_t reg, uint8_t value);
+void sx1276_radiolib_attachInterrupt(Sx1276RadioLib* dev, void (*handler)());
+bool sx1276_radiolib_isPacketReceived(Sx1276RadioLib* dev);
+bool sx1276_radiolib_isTransmitDone(Sx1276RadioLib* dev);
+bool sx1276_radiolib_isCadDone(Sx1276RadioLib* dev);
+bool sx1276_radiolib_isChannelActive(Sx1276RadioLib* dev);
+bool sx1276_radiolib_isReceiving(Sx1276RadioLib* dev);
+uint8_t sx1276_radiolib_getPacketLength(Sx1276RadioLib* dev);
+void sx1276_radiolib_clearIrqFlags(Sx1276RadioLib* dev);
+uint16_t sx1276_radiolib_getIrqFlags(Sx1276RadioLib* dev);
+bool sx1276_radiolib_hasPacketErrors(Sx1276RadioLib* dev);
 
 #endif // SX1276_RADIOLIB_H
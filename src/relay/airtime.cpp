@@ -0,0 +1,61 @@
+#include "airtime.h"
+
+// LoRa bandwidth in Hz indexed by bandwidth code
+static const uint32_t BANDWIDTH_HZ[] = {7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000};
+#define BANDWIDTH_CODE_COUNT (sizeof(BANDWIDTH_HZ) / sizeof(BANDWIDTH_HZ[0]))
+
+// Symbol time above which low data rate optimization is mandated
+#define LDRO_SYMBOL_TIME_US 16000
+
+uint32_t airtime_bandwidthHz(uint8_t bwCode) {
+    if (bwCode >= BANDWIDTH_CODE_COUNT) {
+        return 0;
+    }
+    return BANDWIDTH_HZ[bwCode];
+}
+
+uint32_t airtime_symbolTimeUs(const ProtocolConfig* config) {
+    if (config == nullptr) {
+        return 0;
+    }
+    uint32_t bwHz = airtime_bandwidthHz(config->bandwidth);
+    if (bwHz == 0 || config->spreadingFactor < 5 || config->spreadingFactor > 12) {
+        return 0;
+    }
+    // 2^12 * 1e6 = 4.096e9 still fits in 32 bits
+    return ((uint32_t)1 << config->spreadingFactor) * 1000000UL / bwHz;
+}
+
+bool airtime_lowDataRateOptimize(const ProtocolConfig* config) {
+    return airtime_symbolTimeUs(config) >= LDRO_SYMBOL_TIME_US;
+}
+
+uint16_t airtime_payloadSymbols(const ProtocolConfig* config, uint8_t len) {
+    if (config == nullptr) {
+        return 0;
+    }
+    int16_t sf = config->spreadingFactor;
+    int16_t de = airtime_lowDataRateOptimize(config) ? 1 : 0;
+    int16_t num = 8 * (int16_t)len - 4 * sf + 28 + (config->crcEnabled ? 16 : 0) - (config->implicitHeader ? 20 : 0);
+    int16_t den = 4 * (sf - 2 * de);
+    
+    uint16_t symbols = 8;
+    if (num > 0 && den > 0) {
+        symbols += (uint16_t)((num + den - 1) / den) * config->codingRate;
+    }
+    return symbols;
+}
+
+uint32_t airtime_packetUs(const ProtocolConfig* config, uint8_t len) {
+    uint32_t symbolUs = airtime_symbolTimeUs(config);
+    if (symbolUs == 0) {
+        return 0;
+    }
+    // Work in quarter symbols to keep the 4.25 symbol preamble overhead exact
+    uint32_t quarterSymbols = 4 * ((uint32_t)config->preambleLength + airtime_payloadSymbols(config, len)) + 17;
+    return (quarterSymbols / 4) * symbolUs + (quarterSymbols % 4) * symbolUs / 4;
+}
+
+uint32_t airtime_packetMs(const ProtocolConfig* config, uint8_t len) {
+    return (airtime_packetUs(config, len) + 999) / 1000;
+}
@@ -0,0 +1,43 @@
+#ifndef AIRTIME_H
+#define AIRTIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+
+/**
+ * LoRa Time-on-Air Calculator
+ * 
+ * Semtech time-on-air formula (SX1276 datasheet 4.1.1.7 / AN1200.13) for
+ * any ProtocolConfig, using integer math only so it is cheap on the
+ * ATmega32u4:
+ * 
+ *   Tsym      = 2^SF / BW
+ *   Npayload  = 8 + max(ceil((8*PL - 4*SF + 28 + 16*CRC - 20*IH) / (4*(SF - 2*DE))) * CR, 0)
+ *   ToA       = (Npreamble + 4.25 + Npayload) * Tsym
+ * 
+ * where DE (low data rate optimize) is set when Tsym >= 16 ms and CR is
+ * the coding rate denominator (5-8). The TX timeout, TX scheduling and
+ * duty-cycle logic all use these numbers, and CMD_GET_AIRTIME exposes
+ * them over USB so capacity planning matches the firmware.
+ */
+
+// Bandwidth in Hz for a bandwidth code (0=7.8kHz ... 9=500kHz), 0 if invalid
+uint32_t airtime_bandwidthHz(uint8_t bwCode);
+
+// Duration of one LoRa symbol in microseconds (0 if config is invalid)
+uint32_t airtime_symbolTimeUs(const ProtocolConfig* config);
+
+// True if low data rate optimization applies (symbol time >= 16 ms)
+bool airtime_lowDataRateOptimize(const ProtocolConfig* config);
+
+// Number of payload symbols (including the 8 symbol minimum) for `len` bytes
+uint16_t airtime_payloadSymbols(const ProtocolConfig* config, uint8_t len);
+
+// Time-on-air of a `len` byte frame in microseconds (0 if config is invalid)
+uint32_t airtime_packetUs(const ProtocolConfig* config, uint8_t len);
+
+// Time-on-air of a `len` byte frame in milliseconds, rounded up
+uint32_t airtime_packetMs(const ProtocolConfig* config, uint8_t len);
+
+#endif // AIRTIME_H
@@ -0,0 +1,73 @@
+#include "airtime_budget.h"
+#include "../config.h"
+#include <Arduino.h>
+
+static AirtimeBudget budgets[PROTOCOL_COUNT];
+
+// Bucket size: percent of the window, in ms
+static uint32_t bucketCapacityMs(const AirtimeBudget* budget) {
+    return (uint32_t)budget->windowS * 10UL * budget->percent;
+}
+
+static void refill(AirtimeBudget* budget, uint32_t nowMs) {
+    uint32_t elapsed = nowMs - budget->lastRefillMs;
+    // Accrue whole 1% steps only, carrying the remainder in lastRefillMs
+    uint32_t steps = elapsed / 100;
+    if (steps == 0) {
+        return;
+    }
+    budget->lastRefillMs += steps * 100;
+    uint32_t capacity = bucketCapacityMs(budget);
+    uint32_t gained = steps * budget->percent;
+    budget->tokensMs = (capacity - budget->tokensMs <= gained) ? capacity : budget->tokensMs + gained;
+}
+
+void airtime_budget_init() {
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        airtime_budget_configure((ProtocolId)i, AIRTIME_BUDGET_PERCENT_DEFAULT,
+                                 AIRTIME_BUDGET_WINDOW_S_DEFAULT, BUDGET_POLICY_DEFER);
+    }
+}
+
+bool airtime_budget_configure(ProtocolId protocol, uint8_t percent, uint16_t windowS, BudgetPolicy policy) {
+    if (protocol >= PROTOCOL_COUNT || percent == 0 || percent > 100 ||
+        windowS == 0 || windowS > AIRTIME_BUDGET_WINDOW_S_MAX) {
+        return false;
+    }
+    AirtimeBudget* budget = &budgets[protocol];
+    budget->percent = percent;
+    budget->windowS = windowS;
+    budget->policy = policy;
+    budget->tokensMs = bucketCapacityMs(budget);
+    budget->lastRefillMs = millis();
+    return true;
+}
+
+const AirtimeBudget* airtime_budget_get(ProtocolId protocol) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return nullptr;
+    }
+    return &budgets[protocol];
+}
+
+bool airtime_budget_canSend(ProtocolId protocol, uint32_t airtimeMs, uint32_t nowMs) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return false;
+    }
+    AirtimeBudget* budget = &budgets[protocol];
+    if (budget->percent >= 100) {
+        return true;
+    }
+    refill(budget, nowMs);
+    // A frame longer than the whole bucket is allowed once the bucket is full,
+    // otherwise it could never be sent
+    return budget->tokensMs >= airtimeMs || budget->tokensMs >= bucketCapacityMs(budget);
+}
+
+void airtime_budget_consume(ProtocolId protocol, uint32_t airtimeMs) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return;
+    }
+    AirtimeBudget* budget = &budgets[protocol];
+    budget->tokensMs = (budget->tokensMs > airtimeMs) ? budget->tokensMs - airtimeMs : 0;
+}
@@ -0,0 +1,44 @@
+#ifndef AIRTIME_BUDGET_H
+#define AIRTIME_BUDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+
+/**
+ * Airtime Budget (duty-cycle limiter)
+ * 
+ * One token bucket per target protocol, denominated in milliseconds of
+ * airtime. The bucket holds at most `percent`% of the window and refills at
+ * `percent`% of real time, so sustained relaying cannot exceed the duty
+ * cycle while short bursts up to the bucket size still go out immediately.
+ * 
+ * Frames that do not fit the remaining budget are deferred (left queued
+ * until enough airtime has accrued) or dropped, depending on the policy.
+ */
+
+typedef enum {
+    BUDGET_POLICY_DEFER = 0,    // Keep the frame queued until budget is available
+    BUDGET_POLICY_DROP = 1      // Discard the frame
+} BudgetPolicy;
+
+typedef struct {
+    uint8_t percent;            // Allowed duty cycle 1-100 (100 = unlimited)
+    uint16_t windowS;           // Window the percentage applies to
+    BudgetPolicy policy;
+    uint32_t tokensMs;          // Airtime currently available
+    uint32_t lastRefillMs;
+} AirtimeBudget;
+
+void airtime_budget_init();
+
+// Configure the budget of one protocol (resets its bucket to full)
+bool airtime_budget_configure(ProtocolId protocol, uint8_t percent, uint16_t windowS, BudgetPolicy policy);
+const AirtimeBudget* airtime_budget_get(ProtocolId protocol);
+
+// True if a frame of `airtimeMs` fits the protocol's budget right now
+bool airtime_budget_canSend(ProtocolId protocol, uint32_t airtimeMs, uint32_t nowMs);
+// Charge a transmitted frame against the budget
+void airtime_budget_consume(ProtocolId protocol, uint32_t airtimeMs);
+
+#endif // AIRTIME_BUDGET_H
@@ -0,0 +1,103 @@
+#include "dup_cache.h"
+#include "../config.h"
+#include <Arduino.h>
+
+typedef struct {
+    uint32_t key;           // 0 = empty slot
+    uint32_t seenMs;
+} DupCacheEntry;
+
+static DupCacheEntry entries[DUP_CACHE_SIZE];
+static uint32_t ttlMs = (uint32_t)DUP_CACHE_TTL_S_DEFAULT * 1000;
+static DupCacheStats stats;
+
+static bool isLive(const DupCacheEntry* entry, uint32_t nowMs) {
+    return entry->key != 0 && nowMs - entry->seenMs < ttlMs;
+}
+
+void dup_cache_init() {
+    for (uint8_t i = 0; i < DUP_CACHE_SIZE; i++) {
+        entries[i].key = 0;
+    }
+    dup_cache_resetStats();
+}
+
+uint32_t dup_cache_hash(uint32_t hash, const uint8_t* data, uint8_t len) {
+    for (uint8_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+void dup_cache_insert(uint32_t key, uint32_t nowMs) {
+    // Key 0 marks empty slots
+    if (key == 0) {
+        key = 1;
+    }
+    
+    // Reuse an empty or expired slot, otherwise evict the oldest entry
+    DupCacheEntry* victim = &entries[0];
+    for (uint8_t i = 0; i < DUP_CACHE_SIZE; i++) {
+        DupCacheEntry* entry = &entries[i];
+        if (entry->key == key || !isLive(entry, nowMs)) {
+            victim = entry;
+            break;
+        }
+        if ((int32_t)(entry->seenMs - victim->seenMs) < 0) {
+            victim = entry;
+        }
+    }
+    if (victim->key != key && isLive(victim, nowMs)) {
+        stats.evictions++;
+    }
+    victim->key = key;
+    victim->seenMs = nowMs;
+}
+
+bool dup_cache_checkAndInsert(uint32_t key, uint32_t nowMs) {
+    if (key == 0) {
+        key = 1;
+    }
+    for (uint8_t i = 0; i < DUP_CACHE_SIZE; i++) {
+        if (entries[i].key == key && isLive(&entries[i], nowMs)) {
+            stats.hits++;
+            return true;
+        }
+    }
+    stats.misses++;
+    dup_cache_insert(key, nowMs);
+    return false;
+}
+
+uint8_t dup_cache_count() {
+    uint32_t nowMs = millis();
+    uint8_t live = 0;
+    for (uint8_t i = 0; i < DUP_CACHE_SIZE; i++) {
+        if (isLive(&entries[i], nowMs)) {
+            live++;
+        }
+    }
+    return live;
+}
+
+void dup_cache_setTtlS(uint16_t ttlS) {
+    if (ttlS > DUP_CACHE_TTL_S_MAX) {
+        ttlS = DUP_CACHE_TTL_S_MAX;
+    }
+    ttlMs = (uint32_t)ttlS * 1000;
+}
+
+uint16_t dup_cache_getTtlS() {
+    return (uint16_t)(ttlMs / 1000);
+}
+
+const DupCacheStats* dup_cache_getStats() {
+    return &stats;
+}
+
+void dup_cache_resetStats() {
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
@@ -0,0 +1,43 @@
+#ifndef DUP_CACHE_H
+#define DUP_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Duplicate Cache
+ * 
+ * Remembers recently relayed packets so further copies of the same logical
+ * packet (flood repeats, rebroadcasts by other neighbours, and the target
+ * mesh echoing our own relay back) are dropped before any conversion work.
+ * 
+ * Each protocol derives a 32-bit key from the raw frame (see
+ * ProtocolInterfaceImpl::getDedupKey). Entries expire after the configured
+ * TTL; when the table is full the oldest entry is evicted.
+ */
+
+// Cache statistics
+typedef struct {
+    uint32_t hits;          // Frames recognised as duplicates
+    uint32_t misses;        // New frames added to the cache
+    uint32_t evictions;     // Live entries overwritten because the cache was full
+} DupCacheStats;
+
+void dup_cache_init();
+
+// True if `key` was seen within the TTL; otherwise records it and returns false
+bool dup_cache_checkAndInsert(uint32_t key, uint32_t nowMs);
+// Record a key without counting a lookup (used for frames we transmit)
+void dup_cache_insert(uint32_t key, uint32_t nowMs);
+
+// FNV-1a over `len` bytes, continuing from `hash` (start with DUP_CACHE_HASH_SEED)
+#define DUP_CACHE_HASH_SEED 2166136261UL
+uint32_t dup_cache_hash(uint32_t hash, const uint8_t* data, uint8_t len);
+
+uint8_t dup_cache_count();
+void dup_cache_setTtlS(uint16_t ttlS);    // 0 disables duplicate suppression
+uint16_t dup_cache_getTtlS();
+const DupCacheStats* dup_cache_getStats();
+void dup_cache_resetStats();
+
+#endif // DUP_CACHE_H
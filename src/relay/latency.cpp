@@ -0,0 +1,112 @@
+#include "latency.h"
+
+#if LATENCY_BUCKETS > 0
+static uint16_t histograms[PROTOCOL_COUNT][LATENCY_STAGE_COUNT][LATENCY_BUCKETS];
+#endif
+
+void latency_init() {
+    latency_reset();
+}
+
+void latency_record(ProtocolId source, LatencyStage stage, uint32_t intervalUs) {
+#if LATENCY_BUCKETS > 0
+    if (source >= PROTOCOL_COUNT || stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+    
+    // Bucket = floor(log2(us)), clamped to the last bucket
+    uint8_t bucket = 0;
+    while (intervalUs > 1 && bucket < LATENCY_BUCKETS - 1) {
+        intervalUs >>= 1;
+        bucket++;
+    }
+    
+    uint16_t* count = &histograms[source][stage][bucket];
+    if (*count < 0xFFFF) {
+        (*count)++;
+    }
+#else
+    (void)source;
+    (void)stage;
+    (void)intervalUs;
+#endif
+}
+
+void latency_traceStart(LatencyTrace* trace, ProtocolId source,
+                        uint32_t rxUs, uint32_t parsedUs, uint32_t convertedUs) {
+#if LATENCY_BUCKETS > 0
+    trace->rxUs = rxUs;
+    trace->parsedUs = parsedUs;
+    trace->convertedUs = convertedUs;
+    trace->txStartUs = convertedUs;
+    trace->source = source;
+    trace->active = true;
+#else
+    (void)trace;
+    (void)source;
+    (void)rxUs;
+    (void)parsedUs;
+    (void)convertedUs;
+#endif
+}
+
+void latency_traceClear(LatencyTrace* trace) {
+#if LATENCY_BUCKETS > 0
+    trace->active = false;
+#else
+    (void)trace;
+#endif
+}
+
+void latency_traceTxStart(LatencyTrace* trace, uint32_t nowUs) {
+#if LATENCY_BUCKETS > 0
+    trace->txStartUs = nowUs;
+#else
+    (void)trace;
+    (void)nowUs;
+#endif
+}
+
+void latency_traceTxDone(LatencyTrace* trace, uint32_t nowUs) {
+#if LATENCY_BUCKETS > 0
+    if (!trace->active) {
+        return;
+    }
+    // Unsigned differences stay correct across the micros() wrap
+    latency_record(trace->source, LATENCY_STAGE_PARSE, trace->parsedUs - trace->rxUs);
+    latency_record(trace->source, LATENCY_STAGE_CONVERT, trace->convertedUs - trace->parsedUs);
+    latency_record(trace->source, LATENCY_STAGE_QUEUE, trace->txStartUs - trace->convertedUs);
+    latency_record(trace->source, LATENCY_STAGE_AIR, nowUs - trace->txStartUs);
+    latency_record(trace->source, LATENCY_STAGE_TOTAL, nowUs - trace->rxUs);
+    trace->active = false;
+#else
+    (void)trace;
+    (void)nowUs;
+#endif
+}
+
+uint16_t latency_getBucket(ProtocolId source, LatencyStage stage, uint8_t bucket) {
+#if LATENCY_BUCKETS > 0
+    if (source >= PROTOCOL_COUNT || stage >= LATENCY_STAGE_COUNT || bucket >= LATENCY_BUCKETS) {
+        return 0;
+    }
+    return histograms[source][stage][bucket];
+#else
+    (void)source;
+    (void)stage;
+    (void)bucket;
+    return 0;
+#endif
+}
+
+void latency_reset() {
+#if LATENCY_BUCKETS > 0
+    for (uint8_t p = 0; p < PROTOCOL_COUNT; p++) {
+        for (uint8_t s = 0; s < LATENCY_STAGE_COUNT; s++) {
+            for (uint8_t b = 0; b < LATENCY_BUCKETS; b++) {
+                histograms[p][s][b] = 0;
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,65 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../config.h"
+#include "../protocols/protocol_manager.h"
+
+/**
+ * Relay Latency Histograms
+ * 
+ * Every relayed frame is stamped (micros()) when it is drained from the radio
+ * (RX_DONE), when parsing into canonical form is done, when conversion to the
+ * target format is done, when its TX starts and when TX_DONE arrives. The
+ * intervals feed one histogram per stage and per direction (indexed by the
+ * protocol the frame was received on).
+ * 
+ * Buckets are log2 of microseconds: bucket b counts intervals in
+ * [2^b, 2^(b+1)) us, bucket 0 also takes 0 us and the last bucket takes
+ * everything above. Counters saturate at 65535.
+ * 
+ * With LATENCY_BUCKETS 0 the histograms and the per-frame stamps compile
+ * out and every call is a no-op.
+ */
+
+typedef enum {
+    LATENCY_STAGE_PARSE = 0,    // RX_DONE -> parsed (RX queue wait + parse)
+    LATENCY_STAGE_CONVERT,      // Parsed -> converted (relay logging + conversion)
+    LATENCY_STAGE_QUEUE,        // Converted -> TX start (hold, reconfiguration, LBT)
+    LATENCY_STAGE_AIR,          // TX start -> TX_DONE
+    LATENCY_STAGE_TOTAL,        // RX_DONE -> TX_DONE
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
+// Stamps carried by an outbound frame from reception to TX_DONE
+typedef struct {
+#if LATENCY_BUCKETS > 0
+    uint32_t rxUs;          // RX_DONE interrupt
+    uint32_t parsedUs;      // Converted to canonical form
+    uint32_t convertedUs;   // Converted to the target format
+    uint32_t txStartUs;     // Written to the FIFO and TX started (last attempt)
+    ProtocolId source;      // Direction: protocol the frame was received on
+    bool active;            // Relayed frame being traced (not a test frame)
+#endif
+} LatencyTrace;
+
+void latency_init();
+
+// Per-frame tracing: start once the frame is queued, stamp TX start on every
+// attempt, and finish on TX_DONE to record all stages
+void latency_traceStart(LatencyTrace* trace, ProtocolId source,
+                        uint32_t rxUs, uint32_t parsedUs, uint32_t convertedUs);
+void latency_traceClear(LatencyTrace* trace);
+void latency_traceTxStart(LatencyTrace* trace, uint32_t nowUs);
+void latency_traceTxDone(LatencyTrace* trace, uint32_t nowUs);
+
+// Record one interval for frames received on `source`
+void latency_record(ProtocolId source, LatencyStage stage, uint32_t intervalUs);
+
+// Histogram access (0 for out-of-range arguments or when tracing is compiled out)
+uint16_t latency_getBucket(ProtocolId source, LatencyStage stage, uint8_t bucket);
+
+void latency_reset();
+
+#endif // LATENCY_H
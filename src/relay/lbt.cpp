@@ -0,0 +1,150 @@
+#include "lbt.h"
+#include "airtime.h"
+#include "../config.h"
+#include "../radio/radio_interface.h"
+#include <Arduino.h>
+
+static bool enabled = LBT_ENABLED_DEFAULT;
+static uint8_t cwMin = LBT_CW_MIN_DEFAULT;
+static uint8_t cwMax = LBT_CW_MAX_DEFAULT;
+static uint8_t maxAttempts = LBT_MAX_ATTEMPTS_DEFAULT;
+static LbtStats stats;
+
+// Acquisition state for the frame currently being sent
+typedef enum {
+    PHASE_IDLE,     // Nothing in progress (or result already reported)
+    PHASE_CAD,      // CAD running on the target channel
+    PHASE_BACKOFF   // Waiting out a random backoff before the next CAD
+} LbtPhase;
+
+static LbtPhase phase = PHASE_IDLE;
+static Radio* radio = nullptr;
+static uint32_t symbolUs = 0;
+static uint32_t slotUs = 0;
+static uint16_t window = 0;
+static uint8_t attempts = 0;
+static unsigned long phaseStartUs = 0;
+static uint32_t phaseDurationUs = 0;
+
+static void startCad() {
+    radio_clearIrqFlags(radio);
+    radio_setMode(radio, MODE_CAD);
+    phase = PHASE_CAD;
+    phaseStartUs = micros();
+    // CAD takes ~2 symbols; allow 4 plus margin before giving up on CAD_DONE
+    phaseDurationUs = symbolUs * 4 + 2000;
+}
+
+// Finish the running CAD: true if it detected activity.
+// A CAD that never completes is treated as clear so a radio without
+// working CAD still relays (just without LBT protection)
+static bool finishCad(bool done) {
+    bool busy = done && radio_isChannelActive(radio);
+    radio_setMode(radio, MODE_STDBY);
+    radio_clearIrqFlags(radio);
+    
+    stats.cadChecks++;
+    if (busy) {
+        stats.cadBusy++;
+    }
+    return busy;
+}
+
+void lbt_init() {
+    phase = PHASE_IDLE;
+    lbt_resetStats();
+}
+
+void lbt_begin(Radio* target, const ProtocolConfig* config) {
+    radio = target;
+    attempts = 0;
+    window = cwMin;
+    if (!enabled || config == nullptr) {
+        phase = PHASE_IDLE;
+        return;
+    }
+    symbolUs = airtime_symbolTimeUs(config);
+    slotUs = symbolUs * LBT_SLOT_SYMBOLS + LBT_SLOT_OVERHEAD_US;
+    startCad();
+}
+
+LbtStatus lbt_poll() {
+    unsigned long elapsedUs = micros() - phaseStartUs;
+    
+    switch (phase) {
+        case PHASE_CAD: {
+            bool done = radio_isCadDone(radio);
+            if (!done && elapsedUs < phaseDurationUs) {
+                return LBT_PENDING;
+            }
+            if (!finishCad(done)) {
+                phase = PHASE_IDLE;
+                return LBT_CLEAR;
+            }
+            if (++attempts >= maxAttempts) {
+                phase = PHASE_IDLE;
+                stats.aborts++;
+                return LBT_GAVE_UP;
+            }
+            
+            // Random backoff of 1..window slots, then widen the window
+            uint16_t slots = (uint16_t)random(1, (long)window + 1);
+            phase = PHASE_BACKOFF;
+            phaseStartUs = micros();
+            phaseDurationUs = slots * slotUs;
+            stats.backoffs++;
+            stats.backoffMs += (phaseDurationUs + 999) / 1000;
+            window = (window * 2 > cwMax) ? cwMax : window * 2;
+            return LBT_PENDING;
+        }
+        
+        case PHASE_BACKOFF:
+            if (elapsedUs >= phaseDurationUs) {
+                startCad();
+            }
+            return LBT_PENDING;
+        
+        default:
+            // LBT disabled (or already resolved) - nothing to wait for
+            return LBT_CLEAR;
+    }
+}
+
+bool lbt_configure(bool enable, uint8_t newCwMin, uint8_t newCwMax, uint8_t newMaxAttempts) {
+    if (newCwMin == 0 || newCwMin > newCwMax || newMaxAttempts == 0) {
+        return false;
+    }
+    enabled = enable;
+    cwMin = newCwMin;
+    cwMax = newCwMax;
+    maxAttempts = newMaxAttempts;
+    return true;
+}
+
+bool lbt_isEnabled() {
+    return enabled;
+}
+
+uint8_t lbt_getCwMin() {
+    return cwMin;
+}
+
+uint8_t lbt_getCwMax() {
+    return cwMax;
+}
+
+uint8_t lbt_getMaxAttempts() {
+    return maxAttempts;
+}
+
+const LbtStats* lbt_getStats() {
+    return &stats;
+}
+
+void lbt_resetStats() {
+    stats.cadChecks = 0;
+    stats.cadBusy = 0;
+    stats.backoffs = 0;
+    stats.backoffMs = 0;
+    stats.aborts = 0;
+}
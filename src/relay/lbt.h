@@ -0,0 +1,59 @@
+#ifndef LBT_H
+#define LBT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+#include "../radio/radio_interface.h"
+
+/**
+ * Listen-Before-Talk
+ * 
+ * Runs a Channel Activity Detection on the target channel before a relay TX.
+ * If LoRa activity is detected the TX backs off a random number of slot times
+ * drawn from the contention window, which doubles (up to the maximum) after
+ * every busy CAD. After the configured number of busy CADs the TX is aborted.
+ * 
+ * Slot time is derived from the target protocol's modulation
+ * (LBT_SLOT_SYMBOLS symbols + LBT_SLOT_OVERHEAD_US), so backoff scales with
+ * how long a frame on that channel occupies the air.
+ * 
+ * Acquisition is a polled state machine (CAD running / backing off) so the
+ * main loop keeps servicing USB and the LED while it waits.
+ */
+
+// Result of lbt_poll()
+typedef enum {
+    LBT_PENDING,    // CAD or backoff still running - poll again
+    LBT_CLEAR,      // Channel clear (or LBT disabled) - transmit now
+    LBT_GAVE_UP     // Channel stayed busy for max attempts - abort the TX
+} LbtStatus;
+
+// LBT statistics
+typedef struct {
+    uint32_t cadChecks;     // CADs performed
+    uint32_t cadBusy;       // CADs that detected activity
+    uint32_t backoffs;      // Backoff waits taken
+    uint32_t backoffMs;     // Total time spent backing off
+    uint32_t aborts;        // Transmissions abandoned after max attempts
+} LbtStats;
+
+void lbt_init();
+
+// Start acquiring the channel for one frame on `radio`. The radio must already
+// be configured for the target protocol and in standby; it is left in standby.
+void lbt_begin(Radio* radio, const ProtocolConfig* config);
+// Advance the acquisition; call until it returns something other than LBT_PENDING
+LbtStatus lbt_poll();
+
+// Configure LBT (contention window in slots, 1 <= cwMin <= cwMax)
+bool lbt_configure(bool enabled, uint8_t cwMin, uint8_t cwMax, uint8_t maxAttempts);
+bool lbt_isEnabled();
+uint8_t lbt_getCwMin();
+uint8_t lbt_getCwMax();
+uint8_t lbt_getMaxAttempts();
+
+const LbtStats* lbt_getStats();
+void lbt_resetStats();
+
+#endif // LBT_H
@@ -0,0 +1,128 @@
+#include "noise_floor.h"
+#include "../config.h"
+#include "../radio/radio_interface.h"
+
+// RSSI values below anything either radio reports; also the threshold used
+// before the floor has settled
+#define RSSI_NO_SIGNAL -127
+
+static NoiseFloorStats stats[PROTOCOL_COUNT];
+// EWMA state with 8 more fractional bits than floorQ4 (dBm * 4096), so the
+// slow 1/256 busy step still moves the floor for rises below 16 dB
+static int32_t floorQ12[PROTOCOL_COUNT];
+static uint32_t channelHz[PROTOCOL_COUNT];      // Channel the statistics belong to
+static uint8_t channelBw[PROTOCOL_COUNT];
+static uint32_t lastSampleMs[PROTOCOL_COUNT];
+
+static void restartChannel(ProtocolId protocol, const ProtocolConfig* config) {
+    channelHz[protocol] = config->frequencyHz;
+    channelBw[protocol] = config->bandwidth;
+    stats[protocol].floorQ4 = RSSI_NO_SIGNAL * 16;
+    floorQ12[protocol] = (int32_t)RSSI_NO_SIGNAL * 4096;
+    stats[protocol].busy = 0;
+    stats[protocol].samples = 0;
+}
+
+void noise_floor_init() {
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        channelHz[i] = 0;
+        channelBw[i] = 0;
+        lastSampleMs[i] = 0;
+        stats[i].floorQ4 = RSSI_NO_SIGNAL * 16;
+        floorQ12[i] = (int32_t)RSSI_NO_SIGNAL * 4096;
+        stats[i].busy = 0;
+        stats[i].samples = 0;
+    }
+    noise_floor_resetStats();
+}
+
+void noise_floor_poll(Radio* radio, ProtocolId protocol, uint32_t nowMs) {
+    if (protocol >= PROTOCOL_COUNT || nowMs - lastSampleMs[protocol] < NOISE_SAMPLE_INTERVAL_MS) {
+        return;
+    }
+    lastSampleMs[protocol] = nowMs;
+    
+    const ProtocolConfig* config = protocol_manager_getConfig(protocol);
+    if (config == nullptr) {
+        return;
+    }
+    if (config->frequencyHz != channelHz[protocol] || config->bandwidth != channelBw[protocol]) {
+        restartChannel(protocol, config);
+    }
+    
+    NoiseFloorStats* s = &stats[protocol];
+    bool receiving = radio_isReceiving(radio);
+    int32_t sampleQ12 = (int32_t)radio_getRssiInst(radio) * 4096;
+    int32_t* floor = &floorQ12[protocol];
+    if (s->samples == 0) {
+        *floor = sampleQ12;
+    }
+    
+    // Quiet samples track the floor (quickly downwards); busy ones only drag
+    // it up slowly, so interference that stays raises the floor instead of
+    // reading as a permanently busy channel
+    int32_t diff = sampleQ12 - *floor;
+    bool busy = receiving || diff >= (int32_t)NOISE_BUSY_MARGIN_DB * 4096;
+    if (busy) {
+        *floor += diff / 256;
+    } else if (diff < 0) {
+        *floor += diff / 4;
+    } else {
+        *floor += diff / 16;
+    }
+    s->floorQ4 = (int16_t)(*floor / 256);
+    
+    // Busy share EWMA (alpha = 1/128, ~2.5 s at 20 ms per sample)
+    int32_t target = busy ? 65535 : 0;
+    s->busy = (uint16_t)(s->busy + (target - s->busy) / 128);
+    
+    if (s->samples < 0xFFFFFFFFUL) {
+        s->samples++;
+    }
+}
+
+int16_t noise_floor_getThreshold(ProtocolId protocol) {
+    if (protocol >= PROTOCOL_COUNT || stats[protocol].samples < NOISE_MIN_SAMPLES) {
+        return RSSI_NO_SIGNAL;
+    }
+    const ProtocolConfig* config = protocol_manager_getConfig(protocol);
+    if (config == nullptr) {
+        return RSSI_NO_SIGNAL;
+    }
+    
+    // Demodulation limit below the floor: 7.5 dB at SF7 plus 2.5 dB per SF step
+    uint8_t sf = config->spreadingFactor;
+    if (sf < 6) {
+        sf = 6;
+    } else if (sf > 12) {
+        sf = 12;
+    }
+    int32_t limitQ4 = (10 + 5 * (sf - 6)) * 8; // Half dB steps to 1/16 dB
+    int32_t thresholdQ4 = stats[protocol].floorQ4 - limitQ4 - NOISE_REJECT_MARGIN_DB * 16;
+    int16_t threshold = (int16_t)(thresholdQ4 / 16);
+    return threshold > RSSI_NO_SIGNAL ? threshold : RSSI_NO_SIGNAL;
+}
+
+bool noise_floor_isNoise(ProtocolId protocol, int16_t rssi) {
+    if (rssi > noise_floor_getThreshold(protocol)) {
+        return false;
+    }
+    if (protocol < PROTOCOL_COUNT) {
+        stats[protocol].rejected++;
+    }
+    return true;
+}
+
+const NoiseFloorStats* noise_floor_getStats(ProtocolId protocol) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return nullptr;
+    }
+    return &stats[protocol];
+}
+
+// Clears the rejection counts; the floor itself keeps tracking
+void noise_floor_resetStats() {
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        stats[i].rejected = 0;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef NOISE_FLOOR_H
+#define NOISE_FLOOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+#include "../radio/radio_interface.h"
+
+/**
+ * Noise Floor Monitor
+ * 
+ * While a radio listens on a protocol's channel, its instantaneous RSSI is
+ * sampled every NOISE_SAMPLE_INTERVAL_MS. Samples more than
+ * NOISE_BUSY_MARGIN_DB above the floor (or taken while a frame is arriving)
+ * count as busy; the others feed an EWMA noise floor, which busy samples only
+ * nudge upwards slowly. The busy share is an EWMA too, so lasting
+ * interference (a raised floor) and congestion (a high busy share) can be
+ * told apart.
+ * 
+ * LoRa demodulates below the noise floor, but only down to a limit set by
+ * the spreading factor (-7.5 dB at SF7 to -20 dB at SF12). A frame whose RSSI
+ * is further below the floor than that is noise that happened to pass, so the
+ * RX path rejects it. Until the floor has settled the old fixed -127 dBm
+ * threshold applies.
+ * 
+ * All math is fixed point: dBm in 1/16 dB, the busy share in 1/65536.
+ * State restarts when the protocol's frequency or bandwidth changes.
+ */
+
+// Per-protocol channel statistics
+typedef struct {
+    int16_t floorQ4;        // EWMA noise floor, dBm * 16
+    uint16_t busy;          // EWMA busy share, 65535 = always busy
+    uint32_t samples;       // RSSI samples taken on the current channel
+    uint32_t rejected;      // Frames rejected as below the demodulation limit
+} NoiseFloorStats;
+
+void noise_floor_init();
+
+// Sample `radio`, which must be listening on `protocol`
+// (rate limited to NOISE_SAMPLE_INTERVAL_MS per protocol)
+void noise_floor_poll(Radio* radio, ProtocolId protocol, uint32_t nowMs);
+
+// RSSI (dBm) at or below which a frame received on `protocol` is rejected
+int16_t noise_floor_getThreshold(ProtocolId protocol);
+// True (and counted) if a frame with `rssi` on `protocol` is noise
+bool noise_floor_isNoise(ProtocolId protocol, int16_t rssi);
+
+const NoiseFloorStats* noise_floor_getStats(ProtocolId protocol);
+void noise_floor_resetStats();
+
+#endif // NOISE_FLOOR_H
@@ -0,0 +1,150 @@
+#include "rate_limit.h"
+#include "../config.h"
+
+#define TOKEN_SCALE 1000UL
+
+static RateLimitSource sources[RATE_LIMIT_SOURCES];
+static uint16_t ratePerMin = RATE_LIMIT_PER_MIN_DEFAULT;
+static uint8_t burst = RATE_LIMIT_BURST_DEFAULT;
+static RateLimitStats stats;
+
+static uint32_t capacity() {
+    return (uint32_t)burst * TOKEN_SCALE;
+}
+
+static void refill(RateLimitSource* source, uint32_t nowMs) {
+    uint32_t elapsedMs = nowMs - source->lastSeenMs;
+    source->lastSeenMs = nowMs;
+    
+    // Time for an empty bucket to fill - past that the bucket is full, and
+    // below it elapsedMs * ratePerMin stays under burst * 60000 (no overflow)
+    uint32_t fillMs = (uint32_t)burst * 60000UL / ratePerMin;
+    if (elapsedMs >= fillMs) {
+        source->tokens = capacity();
+        return;
+    }
+    // ratePerMin frames per 60000 ms, x TOKEN_SCALE
+    source->tokens += elapsedMs * ratePerMin / (60000UL / TOKEN_SCALE);
+    if (source->tokens > capacity()) {
+        source->tokens = capacity();
+    }
+}
+
+void rate_limit_init() {
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        sources[i].inUse = false;
+    }
+    rate_limit_resetStats();
+}
+
+bool rate_limit_allow(ProtocolId protocol, uint32_t key, uint32_t nowMs) {
+    if (ratePerMin == 0) {
+        return true;
+    }
+    
+    // Find the source, else a free slot, else the least recently heard one
+    RateLimitSource* source = nullptr;
+    RateLimitSource* victim = &sources[0];
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        RateLimitSource* entry = &sources[i];
+        if (entry->inUse && entry->key == key && entry->protocol == protocol) {
+            source = entry;
+            break;
+        }
+        if (!victim->inUse) {
+            continue;
+        }
+        if (!entry->inUse || (int32_t)(entry->lastSeenMs - victim->lastSeenMs) < 0) {
+            victim = entry;
+        }
+    }
+    
+    if (source != nullptr) {
+        refill(source, nowMs);
+    } else {
+        if (victim->inUse) {
+            stats.evictions++;
+        }
+        source = victim;
+        source->key = key;
+        source->protocol = protocol;
+        source->tokens = capacity();
+        source->lastSeenMs = nowMs;
+        source->drops = 0;
+        source->inUse = true;
+    }
+    
+    if (source->tokens < TOKEN_SCALE) {
+        source->drops++;
+        stats.throttled++;
+        return false;
+    }
+    source->tokens -= TOKEN_SCALE;
+    stats.allowed++;
+    return true;
+}
+
+bool rate_limit_configure(uint16_t newRatePerMin, uint8_t newBurst) {
+    if (newRatePerMin > RATE_LIMIT_PER_MIN_MAX || (newRatePerMin > 0 && newBurst == 0)) {
+        return false;
+    }
+    ratePerMin = newRatePerMin;
+    burst = newBurst;
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        sources[i].tokens = capacity();
+    }
+    return true;
+}
+
+uint16_t rate_limit_getRatePerMin() {
+    return ratePerMin;
+}
+
+uint8_t rate_limit_getBurst() {
+    return burst;
+}
+
+uint8_t rate_limit_count() {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        if (sources[i].inUse) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint8_t rate_limit_getThrottled(const RateLimitSource** out, uint8_t max) {
+    // Insertion sort into `out` by drop count, keeping the top `max`
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        const RateLimitSource* entry = &sources[i];
+        if (!entry->inUse || entry->drops == 0) {
+            continue;
+        }
+        uint8_t pos = count < max ? count++ : max;
+        while (pos > 0 && out[pos - 1]->drops < entry->drops) {
+            if (pos < max) {
+                out[pos] = out[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < max) {
+            out[pos] = entry;
+        }
+    }
+    return count;
+}
+
+const RateLimitStats* rate_limit_getStats() {
+    return &stats;
+}
+
+void rate_limit_resetStats() {
+    stats.allowed = 0;
+    stats.throttled = 0;
+    stats.evictions = 0;
+    for (uint8_t i = 0; i < RATE_LIMIT_SOURCES; i++) {
+        sources[i].drops = 0;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef RATE_LIMIT_H
+#define RATE_LIMIT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+
+/**
+ * Per-Source Rate Limiter
+ * 
+ * One token bucket per originating node, so a single chatty node cannot take
+ * most of the relay airtime. Each protocol names the sender from the raw
+ * frame (see ProtocolInterfaceImpl::getSourceKey): the Meshtastic `from`
+ * NodeNum, or the MeshCore source hash. Frames that do not identify their
+ * sender are not limited.
+ * 
+ * Buckets refill at `ratePerMin` frames per minute up to `burst` frames and
+ * live in a fixed table; a new source takes a free slot or evicts the least
+ * recently heard one, starting with a full bucket. Frames from a source with
+ * an empty bucket are dropped and counted against that source.
+ */
+
+// One tracked source
+typedef struct {
+    uint32_t key;           // Sender as named by the protocol
+    ProtocolId protocol;
+    uint32_t tokens;        // Available frames x 1000
+    uint32_t lastSeenMs;    // Last refill (and LRU order)
+    uint32_t drops;         // Frames dropped for this source
+    bool inUse;
+} RateLimitSource;
+
+// Limiter statistics
+typedef struct {
+    uint32_t allowed;       // Frames passed
+    uint32_t throttled;     // Frames dropped across all sources
+    uint32_t evictions;     // Sources pushed out of the table
+} RateLimitStats;
+
+void rate_limit_init();
+
+// Take a token for one frame from `key` on `protocol`; false = drop the frame
+bool rate_limit_allow(ProtocolId protocol, uint32_t key, uint32_t nowMs);
+
+// ratePerMin 0 disables the limiter. Resets all buckets to full.
+bool rate_limit_configure(uint16_t ratePerMin, uint8_t burst);
+uint16_t rate_limit_getRatePerMin();
+uint8_t rate_limit_getBurst();
+
+uint8_t rate_limit_count();
+// Tracked sources with drops, most dropped first; returns how many were written
+uint8_t rate_limit_getThrottled(const RateLimitSource** out, uint8_t max);
+
+const RateLimitStats* rate_limit_getStats();
+void rate_limit_resetStats();
+
+#endif // RATE_LIMIT_H
@@ -0,0 +1,146 @@
+#include "rx_dwell.h"
+#include "../config.h"
+
+// Floor added to every protocol's activity so idle meshes still get sampled (~6%)
+#define ACTIVITY_FLOOR 16
+
+static RxDwellStats stats[PROTOCOL_COUNT];
+static uint16_t minDwellMs = RX_DWELL_MIN_MS_DEFAULT;
+static uint16_t maxDwellMs = RX_DWELL_MAX_MS_DEFAULT;
+
+// Current dwell
+static ProtocolId current = PROTOCOL_COUNT;
+static uint32_t startMs = 0;
+static uint32_t awayMs = 0;
+static uint32_t caughtAirtimeMs = 0;
+
+static uint32_t listenedMs(uint32_t nowMs) {
+    uint32_t elapsed = nowMs - startMs;
+    return (awayMs >= elapsed) ? 0 : elapsed - awayMs;
+}
+
+static uint16_t computeDwellMs(ProtocolId protocol) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        total += stats[i].activity + ACTIVITY_FLOOR;
+    }
+    uint32_t span = maxDwellMs - minDwellMs;
+    uint32_t dwell = minDwellMs + span * (stats[protocol].activity + ACTIVITY_FLOOR) / total;
+    
+    // Long enough for a typical frame to complete, within the max bound
+    if (dwell < stats[protocol].avgFrameMs) {
+        dwell = stats[protocol].avgFrameMs;
+    }
+    if (dwell > maxDwellMs) {
+        dwell = maxDwellMs;
+    }
+    return (uint16_t)dwell;
+}
+
+void rx_dwell_init(ProtocolId protocol, uint32_t nowMs) {
+    rx_dwell_resetStats();
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        stats[i].activity = 0;
+        stats[i].avgFrameMs = 0;
+    }
+    current = PROTOCOL_COUNT;
+    rx_dwell_start(protocol, nowMs);
+}
+
+void rx_dwell_start(ProtocolId protocol, uint32_t nowMs) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return;
+    }
+    
+    // Close the current dwell and fold its traffic into the EWMA (alpha = 1/4)
+    if (current < PROTOCOL_COUNT) {
+        RxDwellStats* prev = &stats[current];
+        uint32_t listened = listenedMs(nowMs);
+        prev->listenMs += listened;
+        if (listened > 0) {
+            uint32_t sample = (caughtAirtimeMs * 256) / listened;
+            if (sample > 256) {
+                sample = 256;
+            }
+            prev->activity = (uint16_t)(prev->activity - prev->activity / 4 + sample / 4);
+        }
+    }
+    
+    current = protocol;
+    startMs = nowMs;
+    awayMs = 0;
+    caughtAirtimeMs = 0;
+    stats[protocol].switches++;
+    stats[protocol].dwellMs = computeDwellMs(protocol);
+}
+
+bool rx_dwell_isDue(uint32_t nowMs) {
+    if (current >= PROTOCOL_COUNT) {
+        return false;
+    }
+    return listenedMs(nowMs) >= stats[current].dwellMs;
+}
+
+void rx_dwell_recordFrame(ProtocolId protocol, uint32_t airtimeMs) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return;
+    }
+    RxDwellStats* s = &stats[protocol];
+    s->frames++;
+    uint32_t frameMs = (airtimeMs > 0xFFFF) ? 0xFFFF : airtimeMs;
+    s->avgFrameMs = (uint16_t)(s->avgFrameMs - s->avgFrameMs / 4 + frameMs / 4);
+    if (protocol == current) {
+        caughtAirtimeMs += airtimeMs;
+    }
+}
+
+void rx_dwell_recordAway(uint32_t ms) {
+    awayMs += ms;
+}
+
+bool rx_dwell_setBounds(uint16_t minMs, uint16_t maxMs) {
+    if (minMs < RX_DWELL_MS_LIMIT_MIN || maxMs > RX_DWELL_MS_LIMIT_MAX || minMs > maxMs) {
+        return false;
+    }
+    minDwellMs = minMs;
+    maxDwellMs = maxMs;
+    if (current < PROTOCOL_COUNT) {
+        stats[current].dwellMs = computeDwellMs(current);
+    }
+    return true;
+}
+
+uint16_t rx_dwell_getMinMs() {
+    return minDwellMs;
+}
+
+uint16_t rx_dwell_getMaxMs() {
+    return maxDwellMs;
+}
+
+const RxDwellStats* rx_dwell_getStats(ProtocolId protocol) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return nullptr;
+    }
+    return &stats[protocol];
+}
+
+uint32_t rx_dwell_getListenMs(ProtocolId protocol, uint32_t nowMs) {
+    if (protocol >= PROTOCOL_COUNT) {
+        return 0;
+    }
+    uint32_t listenMs = stats[protocol].listenMs;
+    if (protocol == current) {
+        listenMs += listenedMs(nowMs);
+    }
+    return listenMs;
+}
+
+// Counters only - the traffic estimate keeps steering the dwell
+void rx_dwell_resetStats() {
+    for (uint8_t i = 0; i < PROTOCOL_COUNT; i++) {
+        stats[i].listenMs = 0;
+        stats[i].frames = 0;
+        stats[i].switches = 0;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef RX_DWELL_H
+#define RX_DWELL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../protocols/protocol_manager.h"
+
+/**
+ * Adaptive RX Dwell Scheduler
+ * 
+ * With a single radio the proxy can only listen to one protocol at a time.
+ * In auto mode the listen protocol rotates, and each protocol's dwell is
+ * scaled between the min and max bounds by its share of recent traffic:
+ * an EWMA of the fraction of listen time occupied by frames caught on it.
+ * Every protocol keeps a floor share so an idle mesh is still sampled, and a
+ * dwell is never shorter than the protocol's typical frame airtime.
+ * 
+ * Listen time and frames caught are tracked per protocol in manual mode too,
+ * so listen-time share and frames per second of dwell are always reported.
+ * Time the radio spends transmitting relays is not counted as listening.
+ */
+
+// Per-protocol listening statistics
+typedef struct {
+    uint32_t listenMs;      // Total time spent listening
+    uint32_t frames;        // Frames caught while listening
+    uint32_t switches;      // Dwells started on this protocol
+    uint16_t dwellMs;       // Length of the most recent dwell
+    uint16_t activity;      // Traffic EWMA: busy fraction of listen time, Q8 (256 = 100%)
+    uint16_t avgFrameMs;    // EWMA of caught frame airtime
+} RxDwellStats;
+
+void rx_dwell_init(ProtocolId protocol, uint32_t nowMs);
+
+// Close the current dwell and start listening on `protocol`
+void rx_dwell_start(ProtocolId protocol, uint32_t nowMs);
+// True once the current dwell's listen time has elapsed
+bool rx_dwell_isDue(uint32_t nowMs);
+
+// Account a frame caught on `protocol` (with its time-on-air)
+void rx_dwell_recordFrame(ProtocolId protocol, uint32_t airtimeMs);
+// Account time the radio was away from the listen protocol (relay TX)
+void rx_dwell_recordAway(uint32_t ms);
+
+bool rx_dwell_setBounds(uint16_t minMs, uint16_t maxMs);
+uint16_t rx_dwell_getMinMs();
+uint16_t rx_dwell_getMaxMs();
+
+const RxDwellStats* rx_dwell_getStats(ProtocolId protocol);
+// Total listen time including the dwell in progress
+uint32_t rx_dwell_getListenMs(ProtocolId protocol, uint32_t nowMs);
+void rx_dwell_resetStats();
+
+#endif // RX_DWELL_H
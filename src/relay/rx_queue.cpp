@@ -0,0 +1,61 @@
+#include "rx_queue.h"
+#include "../config.h"
+
+static RxFrame slots[RX_QUEUE_DEPTH];
+static uint8_t head = 0;    // Oldest frame
+static uint8_t count = 0;
+static RxQueueStats stats;
+
+void rx_queue_init() {
+    head = 0;
+    count = 0;
+    rx_queue_resetStats();
+}
+
+RxFrame* rx_queue_reserve() {
+    if (count >= RX_QUEUE_DEPTH) {
+        stats.overflows++;
+        return nullptr;
+    }
+    return &slots[(head + count) % RX_QUEUE_DEPTH];
+}
+
+void rx_queue_commit() {
+    if (count >= RX_QUEUE_DEPTH) {
+        return;
+    }
+    count++;
+    stats.enqueued++;
+    if (count > stats.highWater) {
+        stats.highWater = count;
+    }
+}
+
+RxFrame* rx_queue_peek() {
+    if (count == 0) {
+        return nullptr;
+    }
+    return &slots[head];
+}
+
+void rx_queue_pop() {
+    if (count == 0) {
+        return;
+    }
+    head = (head + 1) % RX_QUEUE_DEPTH;
+    count--;
+}
+
+uint8_t rx_queue_count() {
+    return count;
+}
+
+const RxQueueStats* rx_queue_getStats() {
+    return &stats;
+}
+
+void rx_queue_resetStats() {
+    stats.enqueued = 0;
+    stats.overflows = 0;
+    stats.highWater = count;
+}
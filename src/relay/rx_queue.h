@@ -0,0 +1,56 @@
+#ifndef RX_QUEUE_H
+#define RX_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../config.h"
+#include "../protocols/protocol_manager.h"
+
+/**
+ * RX Frame Queue
+ * 
+ * Fixed-capacity ring of received frames. The radio is drained into a slot
+ * as soon as RX_DONE fires and re-armed immediately; relay processing then
+ * pulls frames from the queue at its own pace, so frames arriving while a
+ * relay TX is in progress are no longer lost.
+ * 
+ * Usage: rx_queue_reserve() -> fill slot -> rx_queue_commit() on the
+ * producer side, rx_queue_peek() -> process -> rx_queue_pop() on the
+ * consumer side. A peeked frame stays valid until it is popped.
+ */
+
+// One received frame plus its reception metadata
+typedef struct {
+    uint8_t data[RELAY_FRAME_MAX];
+    uint8_t length;
+    int16_t rssi;
+    int8_t snr;
+    ProtocolId protocol;
+    uint32_t timestampMs;   // millis() at RX_DONE
+    uint32_t rxUs;          // micros() taken in the RX_DONE interrupt
+} RxFrame;
+
+// Queue statistics
+typedef struct {
+    uint32_t enqueued;      // Frames committed to the queue
+    uint32_t overflows;     // Frames dropped because the queue was full
+    uint8_t highWater;      // Maximum depth observed
+} RxQueueStats;
+
+void rx_queue_init();
+
+// Producer: get the next free slot (nullptr and overflow counted if full)
+RxFrame* rx_queue_reserve();
+// Producer: publish the slot returned by rx_queue_reserve()
+void rx_queue_commit();
+
+// Consumer: oldest frame, or nullptr if empty
+RxFrame* rx_queue_peek();
+// Consumer: release the oldest frame
+void rx_queue_pop();
+
+uint8_t rx_queue_count();
+const RxQueueStats* rx_queue_getStats();
+void rx_queue_resetStats();
+
+#endif // RX_QUEUE_H
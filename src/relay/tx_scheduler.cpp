@@ -0,0 +1,267 @@
+#include "tx_scheduler.h"
+#include "airtime.h"
+#include "../config.h"
+
+// One slot beyond the queue depth: a frame that sheds another when the queue
+// is full is converted there, so the victim is untouched until the commit
+#define TX_SLOTS (TX_QUEUE_DEPTH + 1)
+
+static TxFrame slots[TX_SLOTS];
+static uint8_t pendingCount = 0;
+static TxFrame* pendingVictim = nullptr;  // Shed by the next commit
+static uint16_t commitSeq = 0;
+static uint16_t maxHoldMs = TX_HOLD_MS_DEFAULT;
+static TxSchedulerStats stats;
+
+void tx_scheduler_init() {
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        slots[i].inUse = false;
+    }
+    pendingCount = 0;
+    pendingVictim = nullptr;
+    tx_scheduler_resetStats();
+}
+
+// Class TTL for a frame
+static uint32_t ttlMs(CanonicalPriority priority) {
+    switch (priority) {
+        case CANONICAL_PRIORITY_TEXT:      return TX_TTL_TEXT_MS;
+        case CANONICAL_PRIORITY_CONTROL:   return TX_TTL_CONTROL_MS;
+        case CANONICAL_PRIORITY_TELEMETRY: return TX_TTL_TELEMETRY_MS;
+        default:                           return TX_TTL_BULK_MS;
+    }
+}
+
+// Pending and not waiting out a retry backoff
+static bool eligible(const TxFrame* frame, uint32_t nowMs) {
+    return frame->inUse && (int32_t)(nowMs - frame->notBeforeMs) >= 0;
+}
+
+// True if `a` should be sent before `b`: higher class first, then older
+static bool sendsBefore(const TxFrame* a, const TxFrame* b) {
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    return (int32_t)(a->enqueueMs - b->enqueueMs) < 0;
+}
+
+TxFrame* tx_scheduler_reserve(CanonicalPriority priority) {
+    pendingVictim = nullptr;
+    TxFrame* slot = nullptr;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        if (!slots[i].inUse) {
+            slot = &slots[i];
+            break;
+        }
+    }
+    if (pendingCount < TX_QUEUE_DEPTH) {
+        return slot;
+    }
+    
+    // Overload: the frame that would be sent last makes room if it ranks below
+    // the new one - shed only once the new frame is committed
+    TxFrame* victim = nullptr;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        if (slots[i].inUse && !slots[i].inFlight && slots[i].priority > priority &&
+            (victim == nullptr || sendsBefore(victim, &slots[i]))) {
+            victim = &slots[i];
+        }
+    }
+    if (victim != nullptr && slot != nullptr) {
+        pendingVictim = victim;
+        return slot;
+    }
+    
+    stats.queueDrops++;
+    stats.classDrops[priority]++;
+    return nullptr;
+}
+
+void tx_scheduler_commit(TxFrame* frame, ProtocolId protocol, CanonicalPriority priority,
+                         uint8_t length, uint32_t nowMs) {
+    if (frame == nullptr || frame->inUse) {
+        return;
+    }
+    TxFrame* victim = pendingVictim;
+    pendingVictim = nullptr;
+    if (victim != nullptr && victim->inUse && !victim->inFlight) {
+        tx_scheduler_drop(victim);
+    }
+    if (pendingCount >= TX_QUEUE_DEPTH) {
+        // The victim was sent or picked meanwhile - no room after all
+        stats.queueDrops++;
+        stats.classDrops[priority]++;
+        return;
+    }
+    frame->protocol = protocol;
+    frame->length = length;
+    frame->enqueueMs = nowMs;
+    frame->airtimeMs = airtime_packetMs(protocol_manager_getConfig(protocol), length);
+    frame->priority = priority;
+    frame->notBeforeMs = nowMs;
+    frame->retries = 0;
+    frame->deferred = false;
+    frame->inFlight = false;
+    frame->inUse = true;
+    frame->seq = ++commitSeq;
+    pendingCount++;
+    if (pendingCount > stats.peakCount) {
+        stats.peakCount = pendingCount;
+    }
+    stats.enqueued++;
+    stats.classEnqueued[priority]++;
+}
+
+ProtocolId tx_scheduler_dueProtocol(uint32_t nowMs, uint8_t skipMask) {
+    // The oldest frame decides whether anything is due; the protocol holding
+    // the highest-class frame goes first
+    TxFrame* oldest = nullptr;
+    TxFrame* first = nullptr;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        if (!eligible(&slots[i], nowMs) || (skipMask & (1 << slots[i].protocol))) {
+            continue;
+        }
+        if (oldest == nullptr || (int32_t)(slots[i].enqueueMs - oldest->enqueueMs) < 0) {
+            oldest = &slots[i];
+        }
+        if (first == nullptr || sendsBefore(&slots[i], first)) {
+            first = &slots[i];
+        }
+    }
+    if (oldest == nullptr) {
+        return PROTOCOL_COUNT;
+    }
+    
+    // Due once held long enough, or immediately if no room is left to batch into
+    if (nowMs - oldest->enqueueMs >= maxHoldMs || pendingCount >= TX_QUEUE_DEPTH) {
+        return first->protocol;
+    }
+    return PROTOCOL_COUNT;
+}
+
+TxFrame* tx_scheduler_peek(ProtocolId protocol, uint32_t nowMs) {
+    TxFrame* next = nullptr;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        if (eligible(&slots[i], nowMs) && slots[i].protocol == protocol &&
+            (next == nullptr || sendsBefore(&slots[i], next))) {
+            next = &slots[i];
+        }
+    }
+    return next;
+}
+
+TxFrame* tx_scheduler_peekNext(uint32_t nowMs) {
+    TxFrame* next = nullptr;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        if (eligible(&slots[i], nowMs) && (next == nullptr || sendsBefore(&slots[i], next))) {
+            next = &slots[i];
+        }
+    }
+    return next;
+}
+
+// Free a slot without touching the sent/dropped counters
+static void freeSlot(TxFrame* frame) {
+    frame->inUse = false;
+    frame->inFlight = false;
+    pendingCount--;
+}
+
+void tx_scheduler_release(TxFrame* frame, uint32_t nowMs) {
+    if (frame == nullptr || !frame->inUse) {
+        return;
+    }
+    uint32_t ageMs = nowMs - frame->enqueueMs;
+    stats.sent++;
+    stats.ageSumMs += ageMs;
+    if (ageMs > stats.ageMaxMs) {
+        stats.ageMaxMs = ageMs;
+    }
+    freeSlot(frame);
+}
+
+void tx_scheduler_drop(TxFrame* frame) {
+    if (frame == nullptr || !frame->inUse) {
+        return;
+    }
+    stats.queueDrops++;
+    stats.classDrops[frame->priority]++;
+    freeSlot(frame);
+}
+
+bool tx_scheduler_retry(TxFrame* frame, uint32_t nowMs) {
+    if (frame == nullptr || !frame->inUse) {
+        return false;
+    }
+    if (frame->retries >= TX_RETRY_MAX) {
+        tx_scheduler_drop(frame);
+        return false;
+    }
+    // Exponential backoff: TX_RETRY_DELAY_MS, then 2x, 4x, ...
+    frame->notBeforeMs = nowMs + ((uint32_t)TX_RETRY_DELAY_MS << frame->retries);
+    frame->retries++;
+    frame->inFlight = false;
+    stats.retries++;
+    return true;
+}
+
+uint8_t tx_scheduler_expire(uint32_t nowMs) {
+    uint8_t purged = 0;
+    for (uint8_t i = 0; i < TX_SLOTS; i++) {
+        TxFrame* frame = &slots[i];
+        if (frame->inUse && !frame->inFlight && nowMs - frame->enqueueMs >= ttlMs(frame->priority)) {
+            stats.expired++;
+            stats.classDrops[frame->priority]++;
+            freeSlot(frame);
+            purged++;
+        }
+    }
+    return purged;
+}
+
+void tx_scheduler_recordBatch(uint8_t frames, uint32_t airtimeMs) {
+    if (frames == 0) {
+        return;
+    }
+    stats.batches++;
+    stats.batchedFrames += frames;
+    stats.airtimeMs += airtimeMs;
+    if (frames > stats.maxBatch) {
+        stats.maxBatch = frames;
+    }
+}
+
+uint8_t tx_scheduler_count() {
+    return pendingCount;
+}
+
+void tx_scheduler_setMaxHoldMs(uint16_t holdMs) {
+    maxHoldMs = holdMs > TX_HOLD_MS_MAX ? TX_HOLD_MS_MAX : holdMs;
+}
+
+uint16_t tx_scheduler_getMaxHoldMs() {
+    return maxHoldMs;
+}
+
+const TxSchedulerStats* tx_scheduler_getStats() {
+    return &stats;
+}
+
+void tx_scheduler_resetStats() {
+    stats.enqueued = 0;
+    stats.queueDrops = 0;
+    stats.batches = 0;
+    stats.batchedFrames = 0;
+    stats.maxBatch = 0;
+    stats.airtimeMs = 0;
+    stats.retries = 0;
+    stats.expired = 0;
+    stats.sent = 0;
+    stats.ageSumMs = 0;
+    stats.ageMaxMs = 0;
+    stats.peakCount = pendingCount;
+    for (uint8_t c = 0; c < CANONICAL_PRIORITY_COUNT; c++) {
+        stats.classEnqueued[c] = 0;
+        stats.classDrops[c] = 0;
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef TX_SCHEDULER_H
+#define TX_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../config.h"
+#include "../protocols/protocol_manager.h"
+#include "../protocols/canonical_packet.h"
+#include "latency.h"
+
+/**
+ * TX Scheduler
+ * 
+ * Holds converted outbound frames per target protocol and releases them in
+ * groups. Switching the radio between protocols costs a full reconfiguration,
+ * so draining every pending frame for one protocol in a single visit turns a
+ * burst of N relays into one switch out and one switch back instead of 2N.
+ * 
+ * A group becomes due when its oldest frame has been held for the configured
+ * maximum hold time, or when the queue is full. Each frame carries its
+ * time-on-air so the drain can cap how long one group keeps the radio away
+ * from the listening protocol (TX_BATCH_AIRTIME_MAX_MS).
+ * 
+ * Frames carry a priority class (CanonicalPriority). Dequeue is strict
+ * priority: the due group is the protocol holding the highest-class frame,
+ * and within a group higher classes go first (oldest first within a class).
+ * When the queue is full a new frame evicts the newest frame of the lowest
+ * class below its own; if there is none the new frame is dropped.
+ * 
+ * The queue doubles as a store-and-forward buffer: a frame that could not be
+ * sent is kept with a retry count and a not-before time, and any frame older
+ * than its class TTL (TX_TTL_*_MS) is purged by tx_scheduler_expire().
+ */
+
+// One pending outbound frame
+typedef struct {
+    uint8_t data[RELAY_FRAME_MAX];
+    uint8_t length;
+    ProtocolId protocol;
+    uint32_t enqueueMs;     // millis() when the frame was queued
+    uint32_t airtimeMs;     // Time-on-air on the target protocol
+    uint32_t notBeforeMs;   // Retry backoff: not eligible before this millis()
+    uint8_t retries;        // Failed attempts so far
+    CanonicalPriority priority;
+    bool deferred;          // Already held back once by the airtime budget
+    bool inFlight;          // Picked by the TX engine - never evicted
+    bool inUse;
+    uint16_t seq;           // Commit sequence number - tells a reused slot apart
+    LatencyTrace trace;     // Relay stage stamps (set by the producer)
+} TxFrame;
+
+// Scheduler statistics
+typedef struct {
+    uint32_t enqueued;      // Frames accepted for transmission
+    uint32_t queueDrops;    // Frames dropped (queue full, evicted or abandoned)
+    uint32_t batches;       // Protocol visits (groups drained)
+    uint32_t batchedFrames; // Frames sent across all batches
+    uint8_t maxBatch;       // Largest group drained in one visit
+    uint32_t airtimeMs;     // Total time-on-air of drained frames
+    uint32_t retries;       // Frames put back for a later attempt
+    uint32_t expired;       // Frames purged after outliving their TTL
+    uint32_t sent;          // Frames released after transmission
+    uint32_t ageSumMs;      // Total queue age of sent frames (avg = ageSumMs / sent)
+    uint32_t ageMaxMs;      // Oldest frame at transmission
+    uint8_t peakCount;      // Highest occupancy seen
+    uint32_t classEnqueued[CANONICAL_PRIORITY_COUNT];
+    uint32_t classDrops[CANONICAL_PRIORITY_COUNT];
+} TxSchedulerStats;
+
+void tx_scheduler_init();
+
+// Producer: get a slot to convert a `priority` frame into. When full, a lower
+// class frame is picked to make room; nullptr (drop counted) if there is none.
+// A reservation that is never committed (conversion failed) costs nothing.
+TxFrame* tx_scheduler_reserve(CanonicalPriority priority);
+// Producer: publish a reserved slot for `protocol` (evicting the frame picked
+// by the reservation, if any)
+void tx_scheduler_commit(TxFrame* frame, ProtocolId protocol, CanonicalPriority priority,
+                         uint8_t length, uint32_t nowMs);
+
+// Protocol whose group should be drained now (PROTOCOL_COUNT if none is due).
+// Protocols with their bit set in `skipMask` are passed over.
+ProtocolId tx_scheduler_dueProtocol(uint32_t nowMs, uint8_t skipMask);
+// Next frame to send for `protocol` (highest class, then oldest), or nullptr.
+// Frames still in retry backoff at `nowMs` are skipped.
+TxFrame* tx_scheduler_peek(ProtocolId protocol, uint32_t nowMs);
+// Frame the TX engine will send first once a group is due (highest class,
+// then oldest, any protocol), or nullptr. Used to preload the radio.
+TxFrame* tx_scheduler_peekNext(uint32_t nowMs);
+// Release a frame after it was sent (records its queue age)
+void tx_scheduler_release(TxFrame* frame, uint32_t nowMs);
+// Put a frame that could not be sent back for a later attempt with backoff.
+// Returns false (frame dropped) once it has used up TX_RETRY_MAX retries.
+bool tx_scheduler_retry(TxFrame* frame, uint32_t nowMs);
+// Purge frames older than their class TTL; returns how many were purged
+uint8_t tx_scheduler_expire(uint32_t nowMs);
+// Release a frame that is abandoned unsent (counted as a drop for its class)
+void tx_scheduler_drop(TxFrame* frame);
+// Record the size and total airtime of a drained group
+void tx_scheduler_recordBatch(uint8_t frames, uint32_t airtimeMs);
+
+uint8_t tx_scheduler_count();
+void tx_scheduler_setMaxHoldMs(uint16_t holdMs);
+uint16_t tx_scheduler_getMaxHoldMs();
+
+const TxSchedulerStats* tx_scheduler_getStats();
+void tx_scheduler_resetStats();
+
+#endif // TX_SCHEDULER_H
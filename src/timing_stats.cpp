@@ -0,0 +1,19 @@
+#include "timing_stats.h"
+
+void timing_stats_record(TimingStats* timing, uint32_t elapsedUs, uint8_t shift) {
+    uint32_t count = ++timing->count;
+    if (count == 1) {
+        timing->avgUs = elapsedUs;
+    } else {
+        timing->avgUs = timing->avgUs - (timing->avgUs >> shift) + (elapsedUs >> shift);
+    }
+    if (elapsedUs > timing->maxUs) {
+        timing->maxUs = elapsedUs;
+    }
+}
+
+void timing_stats_reset(TimingStats* timing) {
+    timing->count = 0;
+    timing->avgUs = 0;
+    timing->maxUs = 0;
+}
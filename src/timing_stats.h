@@ -0,0 +1,26 @@
+#ifndef TIMING_STATS_H
+#define TIMING_STATS_H
+
+#include <stdint.h>
+
+/**
+ * Duration Statistics
+ * 
+ * Count, moving average and maximum of a measured duration (reconfiguration,
+ * TX start, frame readout, main loop pass, radio turnaround). The average
+ * starts at the first sample and then moves 1/2^shift of the way to each new
+ * one.
+ */
+
+#define TIMING_AVG_SHIFT_DEFAULT 3  // Moving average over ~8 samples
+
+typedef struct {
+    uint32_t count;
+    uint32_t avgUs;         // Moving average (1/2^shift)
+    uint32_t maxUs;
+} TimingStats;
+
+void timing_stats_record(TimingStats* timing, uint32_t elapsedUs, uint8_t shift = TIMING_AVG_SHIFT_DEFAULT);
+void timing_stats_reset(TimingStats* timing);
+
+#endif // TIMING_STATS_H
@@ -1,9 +1,21 @@
 #include "usb_comm.h"
 #include "config.h"
+#include "timing_stats.h"
 #include "protocols/protocol_state.h"
 #include "protocols/protocol_manager.h"
 #include "protocols/protocol_interface.h"
 #include "radio/radio_interface.h"
+#include "radio/radio_shadow.h"
+#include "relay/airtime.h"
+#include "relay/airtime_budget.h"
+#include "relay/dup_cache.h"
+#include "relay/latency.h"
+#include "relay/lbt.h"
+#include "relay/noise_floor.h"
+#include "relay/rate_limit.h"
+#include "relay/rx_dwell.h"
+#include "relay/rx_queue.h"
+#include "relay/tx_scheduler.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -11,18 +23,29 @@
 extern ProtocolId rx_protocol;      // Currently listening protocol
 extern ProtocolId tx_protocols[];  // Protocols to transmit to
 extern uint8_t tx_protocol_count;   // Number of transmit protocols
-extern uint16_t protocolSwitchIntervalMs; // Configurable switch interval
 extern bool autoSwitchEnabled; // Auto-switching enabled flag
 // desiredProtocolMode always equals rx_protocol since auto-switch is disabled
 // Kept for web interface compatibility (0=MeshCore, 1=Meshtastic)
 extern uint8_t desiredProtocolMode;
 extern ProtocolRuntimeState protocolStates[];  // Protocol runtime state objects
 extern bool radioInitialized; // Track if radio initialized successfully
+extern uint32_t radioReconfigurations; // Protocol reconfigurations of the radio
+extern TimingStats reconfigTiming[PROTOCOL_COUNT][PROTOCOL_COUNT];  // Reconfiguration time [from][to]
+extern uint32_t receptionsSaved;       // Receptions that held off a switch/TX and completed
+extern uint32_t receptionsAborted;     // Receptions cut off after the guard timeout
+extern TimingStats loopTiming;         // Main loop passes
+extern TimingStats txStartTiming[2];   // Channel clear to SetTx [uploaded, preloaded]
+extern uint32_t txPreloads;            // Frames preloaded while listening
+extern uint32_t txPreloadsUnused;      // Preloads that could not be armed
+extern TimingStats rxReadoutTiming;    // Frame readout from a radio
+extern TimingStats rxReadyTiming;      // RX_DONE to frame in RAM
+extern uint32_t rxCrcErrors;           // Frames dropped for a CRC/header error
+extern uint32_t rxOversize;            // Frames dropped as too long for the protocol / a queue slot
 
 // Forward declarations
 void sendTestMessage(ProtocolId protocol);
 void setProtocol(ProtocolState protocol);
-void configureProtocol(ProtocolId protocol);
+void reconfigureRx();
 void set_rx_protocol(ProtocolId protocol);
 void set_tx_protocols(uint8_t bitmask);
 
@@ -30,70 +53,70 @@ USBComm usbComm;
 
 void USBComm::init() {
     // Serial is initialized in main.cpp setup()
+    rxHeaderDone = false;
+    rxCount = 0;
+    txHead = 0;
+    txTail = 0;
+    txCount = 0;
 }
 
 void USBComm::process() {
-    uint8_t cmd;
-    uint8_t data[64];
-    uint8_t len;
+    // Push out responses that were waiting for buffer space
+    flushTx();
     
     // Read and process up to 3 commands per loop iteration
     for (int i = 0; i < 3; i++) {
-        if (!readCommand(&cmd, data, &len)) {
-            break; // No more commands available
+        if (!readCommand()) {
+            break; // No complete command available yet
         }
-        handleCommand(cmd, data, len);
+        handleCommand(rxCmd, rxData, rxLen);
     }
 }
 
-bool USBComm::readCommand(uint8_t* cmd, uint8_t* data, uint8_t* len) {
-    // Non-blocking read: check if header is available
-    if (Serial.available() < 2) {
-        return false; // Not enough data for header
-    }
-    
-    // Peek at the first byte to check if it's a valid command
-    uint8_t peekCmd = Serial.peek();
-    if (peekCmd < 0x01 || peekCmd > 0x0A) {
-        // Invalid command ID - discard this byte and try to resync
-        Serial.read(); // Discard invalid byte
-        return false; // Return false to try again on next call
+// Consume whatever bytes have arrived; true once a whole command is in
+// rxCmd/rxData/rxLen. Never waits - a partial command resumes on the next call.
+bool USBComm::readCommand() {
+    if (!rxHeaderDone) {
+        if (Serial.available() < 2) {
+            return false; // Not enough data for header
+        }
+        
+        // Peek at the first byte to check if it's a valid command
+        uint8_t peekCmd = Serial.peek();
+        if (peekCmd < CMD_FIRST || peekCmd > CMD_LAST) {
+            // Invalid command ID - discard this byte and try to resync
+            Serial.read(); // Discard invalid byte
+            return false; // Return false to try again on next call
+        }
+        
+        rxCmd = Serial.read();
+        rxLen = Serial.read();
+        
+        // Validate length
+        if (rxLen > 64) {
+            // Invalid length - discard both bytes and return false
+            return false;
+        }
+        
+        rxHeaderDone = true;
+        rxCount = 0;
+        rxStartMs = millis();
     }
     
-    *cmd = Serial.read();
-    *len = Serial.read();
-    
-    // Validate command ID (should be 0x01-0x0A) - double check after reading
-    if (*cmd < 0x01 || *cmd > 0x0A) {
-        // Invalid command ID - we've already consumed both bytes, return false to resync
-        return false;
+    // Take as much of the payload as has arrived
+    while (rxCount < rxLen && Serial.available() > 0) {
+        rxData[rxCount++] = Serial.read();
     }
     
-    // Validate length
-    if (*len > 64) {
-        // Invalid length - discard both bytes and return false
-        return false;
-    }
-    
-    // Read payload if present
-    if (*len > 0) {
-        // Wait for payload data with timeout
-        uint8_t bytesRead = 0;
-        uint32_t startTime = millis();
-        while (bytesRead < *len && (millis() - startTime) < 100) {
-            if (Serial.available() > 0) {
-                data[bytesRead++] = Serial.read();
-            } else {
-                delay(1); // Small delay to allow more data to arrive
-            }
-        }
-        
-        if (bytesRead < *len) {
+    if (rxCount < rxLen) {
+        if (millis() - rxStartMs >= USB_CMD_TIMEOUT_MS) {
             // Timeout - incomplete command, discard what we read
-            return false;
+            rxHeaderDone = false;
         }
+        return false;
     }
     
+    rxHeaderDone = false;
     return true;
 }
 
@@ -124,7 +147,7 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                 if (protocol < PROTOCOL_COUNT) {
                     desiredProtocolMode = protocol;
                     // If auto-switch is disabled, switch immediately
-                    if (!autoSwitchEnabled || protocolSwitchIntervalMs == 0) {
+                    if (!autoSwitchEnabled) {
                         setProtocol((ProtocolState)protocol);
                     }
                     ProtocolInterfaceImpl* iface = protocol_interface_get((ProtocolId)protocol);
@@ -135,10 +158,8 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                     }
                 } else if (protocol == 2) {
                     desiredProtocolMode = 2;
-                    // Enable auto-switch if interval is set
-                    if (protocolSwitchIntervalMs > 0) {
-                        autoSwitchEnabled = true;
-                    }
+                    // Rotate listen protocols with adaptive dwell
+                    autoSwitchEnabled = true;
                     sendDebugLog("Mode: Auto");
                 } else {
                     sendDebugLog("ERR: Bad proto");
@@ -154,8 +175,42 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                     protocolStates[id].stats.txCount = 0;
                     protocolStates[id].stats.parseErrors = 0;
                     protocolStates[id].stats.conversionErrors = 0;
+                    protocolStates[id].stats.txDeferred = 0;
+                    protocolStates[id].stats.txBudgetDrops = 0;
+                    protocolStates[id].stats.txAirtimeMs = 0;
+                    protocolStates[id].stats.hopLimitDrops = 0;
+                }
+            }
+            rx_queue_resetStats();
+            tx_scheduler_resetStats();
+            dup_cache_resetStats();
+            lbt_resetStats();
+            rx_dwell_resetStats();
+            latency_reset();
+            rate_limit_resetStats();
+            noise_floor_resetStats();
+            radioReconfigurations = 0;
+            for (uint8_t from = 0; from < PROTOCOL_COUNT; from++) {
+                for (uint8_t to = 0; to < PROTOCOL_COUNT; to++) {
+                    timing_stats_reset(&reconfigTiming[from][to]);
                 }
             }
+            radio_shadow_resetStats();
+            radio_profile_resetStats();
+            radio_busy_resetStats();
+            radio_turnaround_resetStats();
+            receptionsSaved = 0;
+            receptionsAborted = 0;
+            timing_stats_reset(&loopTiming);
+            for (uint8_t path = 0; path < 2; path++) {
+                timing_stats_reset(&txStartTiming[path]);
+            }
+            txPreloads = 0;
+            txPreloadsUnused = 0;
+            timing_stats_reset(&rxReadoutTiming);
+            timing_stats_reset(&rxReadyTiming);
+            rxCrcErrors = 0;
+            rxOversize = 0;
             sendDebugLog("Stats reset");
             break;
             
@@ -166,12 +221,10 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                 if (protocol < PROTOCOL_COUNT) {
                     sendTestMessage((ProtocolId)protocol);
                 } else if (protocol == 2) {
-                    // Send test messages to all transmit protocols
+                    // Queue test messages for all transmit protocols - the TX
+                    // engine sends them one after another
                     for (uint8_t i = 0; i < tx_protocol_count; i++) {
                         sendTestMessage(tx_protocols[i]);
-                        if (i < tx_protocol_count - 1) {
-                            delay(200); // Small delay between transmissions
-                        }
                     }
                 }
             }
@@ -183,16 +236,17 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                 uint16_t newInterval = data[0] | (data[1] << 8);
                 // Validate range (0 = disabled/off)
                 if (newInterval == 0) {
-                    protocolSwitchIntervalMs = 0;
                     autoSwitchEnabled = false;
                     // When disabling auto-switch, use current rx_protocol (not desiredProtocolMode which might be 2)
                     // The rx_protocol should already be set correctly via CMD_SET_RX_PROTOCOL
                     // Just ensure it's configured properly
-                    configureProtocol(rx_protocol);
+                    reconfigureRx();
                     sendDebugLog("Manual mode");
                 } else if (newInterval >= PROTOCOL_SWITCH_INTERVAL_MS_MIN && 
                            newInterval <= PROTOCOL_SWITCH_INTERVAL_MS_MAX) {
-                    protocolSwitchIntervalMs = newInterval;
+                    // Legacy fixed interval: auto mode with min dwell == max dwell
+                    // (CMD_SET_DWELL sets independent bounds for adaptive dwell)
+                    rx_dwell_setBounds(newInterval, newInterval);
                     autoSwitchEnabled = true;
                     // Update desiredProtocolMode to 2 (auto-switch) when enabling
                     desiredProtocolMode = 2;
@@ -221,8 +275,9 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                     ProtocolRuntimeState* state = &protocolStates[targetProtocol];
                     
                     // Validate frequency using radio interface capabilities
-                    uint32_t minFreq = radio_getMinFrequency();
-                    uint32_t maxFreq = radio_getMaxFrequency();
+                    // (every radio fitted is the same chip)
+                    uint32_t minFreq = radio_getMinFrequency(radio_get(0));
+                    uint32_t maxFreq = radio_getMaxFrequency(radio_get(0));
                     if (newFreq >= minFreq && newFreq <= maxFreq) {
                         state->config.frequencyHz = newFreq;
                         protocol_manager_setFrequency(targetProtocol, newFreq);
@@ -250,7 +305,7 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
                     }
                     // Reconfigure if currently listening to this protocol
                     if (rx_protocol == targetProtocol) {
-                        configureProtocol(targetProtocol);
+                        reconfigureRx();
                     }
                 } else {
                     sendDebugLog("ERR: Invalid proto");
@@ -304,6 +359,154 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
             }
             break;
             
+        case CMD_SET_TX_HOLD:
+            if (len == 2) {
+                // 2 bytes: low byte, high byte (little-endian)
+                uint16_t holdMs = data[0] | (data[1] << 8);
+                if (holdMs <= TX_HOLD_MS_MAX) {
+                    tx_scheduler_setMaxHoldMs(holdMs);
+                    char msg[40];
+                    snprintf(msg, sizeof(msg), "TX hold set to %d ms", holdMs);
+                    sendDebugLog(msg);
+                } else {
+                    char msg[50];
+                    snprintf(msg, sizeof(msg), "Invalid TX hold: %d (max %d ms)", holdMs, TX_HOLD_MS_MAX);
+                    sendDebugLog(msg);
+                }
+            }
+            break;
+            
+        case CMD_GET_AIRTIME:
+            if (len == 2) {
+                // 1 byte protocol ID + 1 byte frame length
+                if (data[0] < PROTOCOL_COUNT) {
+                    sendAirtime(data[0], data[1]);
+                } else {
+                    sendDebugLog("ERR: Invalid proto");
+                }
+            }
+            break;
+            
+        case CMD_SET_AIRTIME_BUDGET:
+            if (len == 5) {
+                // 1 byte protocol ID + 1 byte percent + 2 bytes window seconds (LE) + 1 byte policy
+                uint16_t windowS = data[2] | (data[3] << 8);
+                if (data[4] <= BUDGET_POLICY_DROP &&
+                    airtime_budget_configure((ProtocolId)data[0], data[1], windowS, (BudgetPolicy)data[4])) {
+                    char msg[50];
+                    snprintf(msg, sizeof(msg), "Budget P%d: %d%% of %us, %s",
+                             data[0], data[1], windowS, data[4] == BUDGET_POLICY_DROP ? "drop" : "defer");
+                    sendDebugLog(msg);
+                } else {
+                    sendDebugLog("ERR: Invalid budget");
+                }
+            }
+            break;
+            
+        case CMD_GET_PROTOCOL_STATS:
+            if (len == 1) {
+                // 1 byte protocol ID
+                if (data[0] < PROTOCOL_COUNT) {
+                    sendProtocolStats(data[0]);
+                } else {
+                    sendDebugLog("ERR: Invalid proto");
+                }
+            }
+            break;
+            
+        case CMD_SET_DUP_TTL:
+            if (len == 2) {
+                // 2 bytes: low byte, high byte (little-endian)
+                uint16_t ttlS = data[0] | (data[1] << 8);
+                if (ttlS <= DUP_CACHE_TTL_S_MAX) {
+                    dup_cache_setTtlS(ttlS);
+                    char msg[40];
+                    snprintf(msg, sizeof(msg), "Dup cache TTL set to %u s", ttlS);
+                    sendDebugLog(msg);
+                } else {
+                    char msg[50];
+                    snprintf(msg, sizeof(msg), "Invalid dup TTL: %u (max %d s)", ttlS, DUP_CACHE_TTL_S_MAX);
+                    sendDebugLog(msg);
+                }
+            }
+            break;
+            
+        case CMD_GET_RELAY_STATS:
+            if (len == 1) {
+                sendRelayStats(data[0]);
+            }
+            break;
+            
+        case CMD_GET_LATENCY:
+            if (len == 2) {
+                // 1 byte direction (source protocol ID) + 1 byte stage
+                if (data[0] < PROTOCOL_COUNT && data[1] < LATENCY_STAGE_COUNT) {
+                    sendLatency(data[0], data[1]);
+                } else {
+                    sendDebugLog("ERR: Invalid latency query");
+                }
+            }
+            break;
+            
+        case CMD_SPI_BENCHMARK:
+            if (len == 0) {
+                sendSpiBenchmark();
+            }
+            break;
+            
+        case CMD_SET_RATE_LIMIT:
+            if (len == 3) {
+                // 2 bytes frames per minute (little-endian) + 1 byte burst
+                uint16_t ratePerMin = data[0] | (data[1] << 8);
+                if (rate_limit_configure(ratePerMin, data[2])) {
+                    char msg[50];
+                    if (ratePerMin == 0) {
+                        snprintf(msg, sizeof(msg), "Rate limit off");
+                    } else {
+                        snprintf(msg, sizeof(msg), "Rate limit: %u/min, burst %d", ratePerMin, data[2]);
+                    }
+                    sendDebugLog(msg);
+                } else {
+                    char msg[60];
+                    snprintf(msg, sizeof(msg), "Invalid rate limit: %u/min burst %d (max %d/min)",
+                             ratePerMin, data[2], RATE_LIMIT_PER_MIN_MAX);
+                    sendDebugLog(msg);
+                }
+            }
+            break;
+            
+        case CMD_SET_DWELL:
+            if (len == 4) {
+                // 2 bytes min dwell + 2 bytes max dwell (ms, little-endian)
+                uint16_t minMs = data[0] | (data[1] << 8);
+                uint16_t maxMs = data[2] | (data[3] << 8);
+                if (rx_dwell_setBounds(minMs, maxMs)) {
+                    char msg[50];
+                    snprintf(msg, sizeof(msg), "Dwell set to %u-%u ms", minMs, maxMs);
+                    sendDebugLog(msg);
+                } else {
+                    char msg[60];
+                    snprintf(msg, sizeof(msg), "Invalid dwell: %u-%u (range %d-%d ms)",
+                             minMs, maxMs, RX_DWELL_MS_LIMIT_MIN, RX_DWELL_MS_LIMIT_MAX);
+                    sendDebugLog(msg);
+                }
+            }
+            break;
+            
+        case CMD_SET_LBT:
+            if (len == 4) {
+                // 1 byte enable + 1 byte CW min + 1 byte CW max + 1 byte max attempts
+                if (lbt_configure(data[0] != 0, data[1], data[2], data[3])) {
+                    char msg[50];
+                    snprintf(msg, sizeof(msg), "LBT %s: CW %d-%d slots, %d tries",
+                             data[0] ? "on" : "off", data[1], data[2], data[3]);
+                    sendDebugLog(msg);
+                } else {
+                    sendDebugLog("ERR: Invalid LBT params");
+                }
+            }
+            break;
+            
         default:
             // Unknown command - silently ignore
             break;
@@ -311,45 +514,68 @@ void USBComm::handleCommand(uint8_t cmd, uint8_t* data, uint8_t len) {
 }
 
 void USBComm::sendResponse(uint8_t respId, uint8_t* data, uint8_t len) {
-    // Always send critical responses (INFO, STATS, ERROR) - don't check buffer
-    // For other responses, check buffer space to avoid blocking
-    bool isCritical = (respId == RESP_INFO_REPLY || respId == RESP_STATS || respId == RESP_ERROR);
-    
-    if (!isCritical) {
-        // Check available space for non-critical responses
-        if (Serial.availableForWrite() < (2 + len)) {
-            return; // Not enough space - skip this response
-        }
-    }
+    // Critical responses (INFO, STATS, ERROR, query replies) may use the whole
+    // TX ring; everything else leaves room for one critical response and is
+    // dropped rather than queued behind a slow host
+    bool isCritical = (respId == RESP_INFO_REPLY || respId == RESP_STATS || respId == RESP_ERROR ||
+                       respId == RESP_AIRTIME || respId == RESP_PROTOCOL_STATS || respId == RESP_RELAY_STATS ||
+                       respId == RESP_LATENCY || respId == RESP_SPI_BENCHMARK);
+    uint16_t frameLen = 2 + len;
     
-    // For critical responses, ensure we have space (wait if necessary)
-    if (isCritical) {
-        // Wait up to 50ms for buffer space to become available
-        // Don't wait too long - we need to process USB commands
-        uint32_t startTime = millis();
-        while (Serial.availableForWrite() < (2 + len) && (millis() - startTime) < 50) {
-            delay(1);
+    // Fast path: nothing queued ahead of us and the serial buffer has room
+    if (txCount == 0 && Serial.availableForWrite() >= frameLen) {
+        Serial.write(respId);
+        Serial.write(len);
+        if (len > 0 && data != nullptr) {
+            Serial.write(data, len);
+        }
+        // On nRF52 and other platforms, Serial.write() buffers data - flush()
+        // hands it to the USB stack without waiting for the host
+        if (isCritical) {
+            Serial.flush();
         }
-        // If still no space after waiting, try to send anyway (might block briefly)
-        // But don't wait forever - send what we can
+        return;
     }
     
-    // Write header
-    Serial.write(respId);
-    Serial.write(len);
+    uint16_t reserve = isCritical ? 0 : USB_RESPONSE_MAX_SIZE;
+    if (txCount + frameLen + reserve > USB_TX_BUFFER_SIZE) {
+        return; // No room - skip this response
+    }
     
-    // Write payload if present
-    if (len > 0 && data != nullptr) {
-        Serial.write(data, len);
+    txBuffer[txHead] = respId;
+    txHead = (txHead + 1) % USB_TX_BUFFER_SIZE;
+    txBuffer[txHead] = len;
+    txHead = (txHead + 1) % USB_TX_BUFFER_SIZE;
+    for (uint8_t i = 0; i < len; i++) {
+        txBuffer[txHead] = data != nullptr ? data[i] : 0;
+        txHead = (txHead + 1) % USB_TX_BUFFER_SIZE;
+    }
+    txCount += frameLen;
+    flushTx();
+}
+
+// Move queued response bytes into the serial TX buffer, as many as fit right now
+void USBComm::flushTx() {
+    if (txCount == 0) {
+        return;
     }
     
-    // For critical responses, ensure data is sent immediately
-    // On nRF52 and other platforms, Serial.write() buffers data - flush() is needed to send it
-    if (isCritical) {
-        // Flush critical responses - but don't block forever
-        // Some platforms might hang on flush() if USB is disconnected
-        Serial.flush(); // Flush critical responses - brief blocking is acceptable
-        // Note: If flush() blocks, at least the data is written and will be sent when USB is ready
+    int room = Serial.availableForWrite();
+    bool wrote = false;
+    while (txCount > 0 && room > 0) {
+        // Largest contiguous run up to the end of the ring
+        uint16_t run = (txTail + txCount > USB_TX_BUFFER_SIZE) ? USB_TX_BUFFER_SIZE - txTail : txCount;
+        if (run > (uint16_t)room) {
+            run = (uint16_t)room;
+        }
+        Serial.write(&txBuffer[txTail], run);
+        txTail = (txTail + run) % USB_TX_BUFFER_SIZE;
+        txCount -= run;
+        room -= run;
+        wrote = true;
+    }
+    if (wrote) {
+        Serial.flush();
     }
 }
 
@@ -394,8 +620,9 @@ void USBComm::sendInfo() {
     *p++ = (uint8_t)((secondFreq >> 24) & 0xFF);
     
     // Switch interval (2 bytes, little-endian)
-    *p++ = (uint8_t)(protocolSwitchIntervalMs & 0xFF);
-    *p++ = (uint8_t)((protocolSwitchIntervalMs >> 8) & 0xFF);
+    uint16_t switchIntervalMs = autoSwitchEnabled ? rx_dwell_getMaxMs() : 0;
+    *p++ = (uint8_t)(switchIntervalMs & 0xFF);
+    *p++ = (uint8_t)((switchIntervalMs >> 8) & 0xFF);
     
     // Current protocol and bandwidths
     *p++ = (uint8_t)rx_protocol;
@@ -418,7 +645,7 @@ void USBComm::sendInfo() {
 
 void USBComm::sendStats() {
     // Single point for all statistics reporting - reuses stack buffer
-    uint8_t stats[24];
+    uint8_t stats[51];
     uint8_t* p = stats;
     
     // Helper macro to pack uint32_t (little-endian)
@@ -456,13 +683,355 @@ void USBComm::sendStats() {
     PACK_U32(conversionErrors);
     PACK_U32(parseErrors);
     
+    // RX queue: overflow drops, current depth, high-water mark
+    const RxQueueStats* rxq = rx_queue_getStats();
+    PACK_U32(rxq->overflows);
+    *p++ = rx_queue_count();
+    *p++ = rxq->highWater;
+    
+    // TX scheduler: radio reconfigurations, batches drained, frames in them,
+    // largest batch, frames dropped on a full queue
+    const TxSchedulerStats* txs = tx_scheduler_getStats();
+    PACK_U32(radioReconfigurations);
+    PACK_U32(txs->batches);
+    PACK_U32(txs->batchedFrames);
+    *p++ = txs->maxBatch;
+    PACK_U32(txs->queueDrops);
+    PACK_U32(txs->airtimeMs);
+    
     #undef PACK_U32
     
-    sendResponse(RESP_STATS, stats, 24);
+    sendResponse(RESP_STATS, stats, (uint8_t)(p - stats));
+}
+
+void USBComm::sendAirtime(uint8_t protocol, uint8_t length) {
+    const ProtocolConfig* config = protocol_manager_getConfig((ProtocolId)protocol);
+    uint32_t symbolUs = airtime_symbolTimeUs(config);
+    uint32_t airtimeUs = airtime_packetUs(config, length);
+    uint16_t payloadSymbols = airtime_payloadSymbols(config, length);
+    
+    uint8_t reply[12];
+    uint8_t* p = reply;
+    *p++ = protocol;
+    *p++ = length;
+    for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(symbolUs >> (8 * i));
+    for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(airtimeUs >> (8 * i));
+    *p++ = (uint8_t)(payloadSymbols & 0xFF);
+    *p++ = (uint8_t)(payloadSymbols >> 8);
+    
+    sendResponse(RESP_AIRTIME, reply, sizeof(reply));
+}
+
+void USBComm::sendProtocolStats(uint8_t protocol) {
+    const ProtocolStats* stats = &protocolStates[protocol].stats;
+    const AirtimeBudget* budget = airtime_budget_get((ProtocolId)protocol);
+    const RxDwellStats* dwell = rx_dwell_getStats((ProtocolId)protocol);
+    const uint32_t counters[7] = {
+        stats->rxCount, stats->txCount, stats->parseErrors, stats->conversionErrors,
+        stats->txDeferred, stats->txBudgetDrops, stats->txAirtimeMs
+    };
+    
+    uint8_t reply[55];
+    uint8_t* p = reply;
+    *p++ = protocol;
+    for (uint8_t c = 0; c < 7; c++) {
+        for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+    }
+    *p++ = budget->percent;
+    *p++ = (uint8_t)(budget->windowS & 0xFF);
+    *p++ = (uint8_t)(budget->windowS >> 8);
+    *p++ = (uint8_t)budget->policy;
+    for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(budget->tokensMs >> (8 * i));
+    
+    // Listening: listen time, frames caught, dwells, last dwell length
+    const uint32_t listen[3] = {
+        rx_dwell_getListenMs((ProtocolId)protocol, millis()), dwell->frames, dwell->switches
+    };
+    for (uint8_t c = 0; c < 3; c++) {
+        for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(listen[c] >> (8 * i));
+    }
+    *p++ = (uint8_t)(dwell->dwellMs & 0xFF);
+    *p++ = (uint8_t)(dwell->dwellMs >> 8);
+    for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(stats->hopLimitDrops >> (8 * i));
+    
+    sendResponse(RESP_PROTOCOL_STATS, reply, sizeof(reply));
+}
+
+void USBComm::sendRelayStats(uint8_t section) {
+    uint8_t reply[64];
+    uint8_t* p = reply;
+    *p++ = section;
+    
+    switch (section) {
+        case RELAY_STATS_DUP_CACHE: {
+            const DupCacheStats* dup = dup_cache_getStats();
+            const uint32_t counters[3] = { dup->hits, dup->misses, dup->evictions };
+            for (uint8_t c = 0; c < 3; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            *p++ = dup_cache_count();
+            *p++ = DUP_CACHE_SIZE;
+            uint16_t ttlS = dup_cache_getTtlS();
+            *p++ = (uint8_t)(ttlS & 0xFF);
+            *p++ = (uint8_t)(ttlS >> 8);
+            break;
+        }
+        
+        case RELAY_STATS_DWELL: {
+            uint16_t minMs = rx_dwell_getMinMs();
+            uint16_t maxMs = rx_dwell_getMaxMs();
+            *p++ = autoSwitchEnabled ? 1 : 0;
+            *p++ = (uint8_t)rx_protocol;
+            *p++ = (uint8_t)(minMs & 0xFF);
+            *p++ = (uint8_t)(minMs >> 8);
+            *p++ = (uint8_t)(maxMs & 0xFF);
+            *p++ = (uint8_t)(maxMs >> 8);
+            break;
+        }
+        
+        case RELAY_STATS_LBT: {
+            const LbtStats* lbt = lbt_getStats();
+            const uint32_t counters[5] = {
+                lbt->cadChecks, lbt->cadBusy, lbt->backoffs, lbt->backoffMs, lbt->aborts
+            };
+            *p++ = lbt_isEnabled() ? 1 : 0;
+            *p++ = lbt_getCwMin();
+            *p++ = lbt_getCwMax();
+            *p++ = lbt_getMaxAttempts();
+            for (uint8_t c = 0; c < 5; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_RX_GUARD: {
+            const uint32_t counters[2] = { receptionsSaved, receptionsAborted };
+            uint8_t receiving = 0; // Bit n: radio n has a frame arriving
+            for (uint8_t radio = 0; radio < radio_count(); radio++) {
+                if (radio_isReceiving(radio_get(radio))) {
+                    receiving |= (uint8_t)(1 << radio);
+                }
+            }
+            *p++ = receiving;
+            for (uint8_t c = 0; c < 2; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_PRIORITY: {
+            const TxSchedulerStats* txs = tx_scheduler_getStats();
+            for (uint8_t c = 0; c < CANONICAL_PRIORITY_COUNT; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(txs->classEnqueued[c] >> (8 * i));
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(txs->classDrops[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_STORE: {
+            const TxSchedulerStats* txs = tx_scheduler_getStats();
+            uint32_t avgAgeMs = txs->sent > 0 ? txs->ageSumMs / txs->sent : 0;
+            const uint32_t counters[5] = { txs->retries, txs->expired, txs->sent, avgAgeMs, txs->ageMaxMs };
+            *p++ = tx_scheduler_count();
+            *p++ = TX_QUEUE_DEPTH;
+            *p++ = txs->peakCount;
+            for (uint8_t c = 0; c < 5; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_LOOP: {
+            const uint32_t counters[3] = { loopTiming.count, loopTiming.avgUs, loopTiming.maxUs };
+            for (uint8_t c = 0; c < 3; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_RECONFIG: {
+            // Parameter writes sent vs skipped by the shadow, profile switch
+            // time inside the driver, then one entry per protocol transition
+            const RadioShadowStats* shadowStats = radio_shadow_getStats();
+            const TimingStats* profileStats = radio_profile_getStats();
+            for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(shadowStats->applied >> (8 * i));
+            for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(shadowStats->skipped >> (8 * i));
+            for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(profileStats->count >> (8 * i));
+            for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(profileStats->avgUs >> (8 * i));
+            for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(profileStats->maxUs >> (8 * i));
+            *p++ = PROTOCOL_COUNT * (PROTOCOL_COUNT - 1);
+            for (uint8_t from = 0; from < PROTOCOL_COUNT; from++) {
+                for (uint8_t to = 0; to < PROTOCOL_COUNT; to++) {
+                    if (from == to) {
+                        continue;
+                    }
+                    const TimingStats* timing = &reconfigTiming[from][to];
+                    const uint32_t counters[3] = { timing->count, timing->avgUs, timing->maxUs };
+                    *p++ = from;
+                    *p++ = to;
+                    for (uint8_t c = 0; c < 3; c++) {
+                        for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+                    }
+                }
+            }
+            break;
+        }
+        
+        case RELAY_STATS_RADIO_BUSY: {
+            // Time the radio held BUSY high and the command timeouts it caused
+            const RadioBusyStats* bs = radio_busy_getStats();
+            const uint32_t counters[5] = { bs->waits, bs->waitUs, bs->maxWaitUs, bs->timeouts, bs->recoveries };
+            *p++ = radio_busy_hasFault() ? 1 : 0;
+            for (uint8_t c = 0; c < 5; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_TURNAROUND: {
+            // What switching between listening and transmitting costs, and
+            // the image calibrations a frequency change ran or could skip
+            const RadioTurnaroundStats* ts = radio_turnaround_getStats();
+            const uint32_t counters[8] = {
+                ts->imageCalibrations, ts->imageCalibrationsSkipped,
+                ts->rxToTx.count, ts->rxToTx.avgUs, ts->rxToTx.maxUs,
+                ts->txToRx.count, ts->txToRx.avgUs, ts->txToRx.maxUs
+            };
+            *p++ = ts->fastMode ? 1 : 0;
+            for (uint8_t c = 0; c < 8; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_TX_PRELOAD: {
+            // How often the next frame was already in the radio when the
+            // channel cleared, and what that saved on the way to SetTx
+            const uint32_t counters[8] = {
+                txPreloads, txPreloadsUnused,
+                txStartTiming[0].count, txStartTiming[0].avgUs, txStartTiming[0].maxUs,
+                txStartTiming[1].count, txStartTiming[1].avgUs, txStartTiming[1].maxUs
+            };
+            for (uint8_t c = 0; c < 8; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_RATE_LIMIT: {
+            const RateLimitStats* rls = rate_limit_getStats();
+            const uint32_t counters[3] = { rls->allowed, rls->throttled, rls->evictions };
+            uint16_t ratePerMin = rate_limit_getRatePerMin();
+            *p++ = (uint8_t)(ratePerMin & 0xFF);
+            *p++ = (uint8_t)(ratePerMin >> 8);
+            *p++ = rate_limit_getBurst();
+            *p++ = rate_limit_count();
+            *p++ = RATE_LIMIT_SOURCES;
+            for (uint8_t c = 0; c < 3; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            
+            // Chattiest sources first so operators can find them
+            const RateLimitSource* listed[RELAY_STATS_RATE_LIMIT_LISTED];
+            uint8_t count = rate_limit_getThrottled(listed, RELAY_STATS_RATE_LIMIT_LISTED);
+            *p++ = count;
+            for (uint8_t s = 0; s < count; s++) {
+                *p++ = (uint8_t)listed[s]->protocol;
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(listed[s]->key >> (8 * i));
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(listed[s]->drops >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_NOISE: {
+            // Channel quality between frames: a raised floor is interference,
+            // a high busy share is traffic
+            *p++ = PROTOCOL_COUNT;
+            for (uint8_t id = 0; id < PROTOCOL_COUNT; id++) {
+                const NoiseFloorStats* nfs = noise_floor_getStats((ProtocolId)id);
+                int16_t threshold = noise_floor_getThreshold((ProtocolId)id);
+                *p++ = id;
+                *p++ = (uint8_t)(nfs->floorQ4 & 0xFF);
+                *p++ = (uint8_t)((nfs->floorQ4 >> 8) & 0xFF);
+                *p++ = (uint8_t)(nfs->busy & 0xFF);
+                *p++ = (uint8_t)(nfs->busy >> 8);
+                *p++ = (uint8_t)(threshold & 0xFF);
+                *p++ = (uint8_t)((threshold >> 8) & 0xFF);
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(nfs->samples >> (8 * i));
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(nfs->rejected >> (8 * i));
+            }
+            break;
+        }
+        
+        case RELAY_STATS_RX_READOUT: {
+            // Time from the RX_DONE interrupt until the frame sits in the RX
+            // queue, and the share of it spent reading the radio; then the
+            // frames dropped for a CRC/header error or for their length
+            const uint32_t counters[7] = {
+                rxReadoutTiming.count, rxReadoutTiming.avgUs, rxReadoutTiming.maxUs,
+                rxReadyTiming.avgUs, rxReadyTiming.maxUs, rxCrcErrors, rxOversize
+            };
+            for (uint8_t c = 0; c < 7; c++) {
+                for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(counters[c] >> (8 * i));
+            }
+            break;
+        }
+        
+        default:
+            sendDebugLog("ERR: Invalid stats section");
+            return;
+    }
+    
+    sendResponse(RESP_RELAY_STATS, reply, (uint8_t)(p - reply));
+}
+
+void USBComm::sendLatency(uint8_t direction, uint8_t stage) {
+    uint8_t reply[3 + 2 * LATENCY_BUCKETS];
+    uint8_t* p = reply;
+    *p++ = direction;
+    *p++ = stage;
+    *p++ = LATENCY_BUCKETS;
+    for (uint8_t b = 0; b < LATENCY_BUCKETS; b++) {
+        uint16_t count = latency_getBucket((ProtocolId)direction, (LatencyStage)stage, b);
+        *p++ = (uint8_t)(count & 0xFF);
+        *p++ = (uint8_t)(count >> 8);
+    }
+    
+    sendResponse(RESP_LATENCY, reply, sizeof(reply));
+}
+
+void USBComm::sendSpiBenchmark() {
+    // Blocks for a few ms while the radio FIFO is read SPI_BENCH_RUNS times per path
+    // (the frame readout pass clears the radio's IRQs - a frame waiting in
+    // the first radio at that moment is dropped)
+    SpiBenchmark result;
+    memset(&result, 0, sizeof(result));
+    bool supported = radio_benchmarkFifoRead(radio_get(0), &result); // Measured on the first radio
+    
+    uint32_t timings[5] = {result.byteLoopUs, result.bulkUs, result.bulkCpuUs,
+                           result.rxGettersUs, result.rxFetchUs};
+    uint8_t reply[4 + 3 * 4 + 1 + 2 * 4];
+    uint8_t* p = reply;
+    *p++ = supported ? 1 : 0;
+    *p++ = (uint8_t)(result.bytes & 0xFF);
+    *p++ = (uint8_t)(result.bytes >> 8);
+    *p++ = SPI_BENCH_RUNS;
+    for (uint8_t t = 0; t < 3; t++) {
+        for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(timings[t] >> (8 * i));
+    }
+    // Frame readout fields after the original layout so older hosts still parse it
+    *p++ = result.rxBytes;
+    for (uint8_t t = 3; t < 5; t++) {
+        for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(timings[t] >> (8 * i));
+    }
+    
+    sendResponse(RESP_SPI_BENCHMARK, reply, sizeof(reply));
 }
 
-void USBComm::sendRxPacket(uint8_t protocol, int16_t rssi, int8_t snr, uint8_t* data, uint8_t len) {
-    if (len > 56) len = 56; // Limit to fit in buffer
+// [protocol][rssi:2][snr][len][data][rxUs:4] - rxUs is the device's micros()
+// at RX_DONE, after the data so older hosts still find the payload
+void USBComm::sendRxPacket(uint8_t protocol, int16_t rssi, int8_t snr, uint8_t* data, uint8_t len, uint32_t rxUs) {
+    if (len > 55) len = 55; // Limit to fit in buffer
     
     uint8_t buffer[64];
     buffer[0] = protocol; // 0 = MeshCore, 1 = Meshtastic
@@ -474,8 +1043,10 @@ void USBComm::sendRxPacket(uint8_t protocol, int16_t rssi, int8_t snr, uint8_t*
     if (len > 0 && data != nullptr) {
         memcpy(&buffer[5], data, len);
     }
+    uint8_t* p = &buffer[5 + len];
+    for (uint8_t i = 0; i < 4; i++) *p++ = (uint8_t)(rxUs >> (8 * i));
     
-    sendResponse(RESP_RX_PACKET, buffer, 5 + len);
+    sendResponse(RESP_RX_PACKET, buffer, 9 + len);
 }
 
 void USBComm::sendDebugLog(const char* message) {
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config.h"
 
 // Command IDs
 #define CMD_GET_INFO      0x01
@@ -15,6 +16,20 @@
 #define CMD_SET_PROTOCOL_PARAMS 0x08  // Generic: 1 byte protocol ID + 4 bytes freq + 1 byte bandwidth
 #define CMD_SET_RX_PROTOCOL 0x09      // Set listen protocol: 1 byte protocol ID
 #define CMD_SET_TX_PROTOCOLS 0x0A     // Set transmit protocols: 1 byte bitmask (bit 0=MeshCore, bit 1=Meshtastic)
+#define CMD_SET_TX_HOLD   0x0B        // Set TX batching max hold time: 2 bytes ms (little-endian, 0 = no hold)
+#define CMD_GET_AIRTIME   0x0C        // Airtime estimate: 1 byte protocol ID + 1 byte frame length
+#define CMD_SET_AIRTIME_BUDGET 0x0D   // Duty cycle: 1 byte protocol ID + 1 byte percent + 2 bytes window s (LE) + 1 byte policy (0=defer, 1=drop)
+#define CMD_GET_PROTOCOL_STATS 0x0E   // Per-protocol counters and budget: 1 byte protocol ID
+#define CMD_SET_DUP_TTL   0x0F        // Duplicate cache TTL: 2 bytes seconds (little-endian, 0 = disabled)
+#define CMD_GET_RELAY_STATS 0x10      // Relay subsystem counters: 1 byte section (RELAY_STATS_*)
+#define CMD_SET_LBT       0x11        // Listen-before-talk: 1 byte enable + 1 byte CW min + 1 byte CW max (slots) + 1 byte max attempts
+#define CMD_SET_DWELL     0x12        // Auto-mode dwell bounds: 2 bytes min ms + 2 bytes max ms (little-endian)
+#define CMD_GET_LATENCY   0x13        // Relay latency histogram: 1 byte direction (source protocol ID) + 1 byte stage
+#define CMD_SET_RATE_LIMIT 0x14       // Per-source limit: 2 bytes frames per minute (LE, 0 = off) + 1 byte burst frames
+#define CMD_SPI_BENCHMARK 0x15        // Time a full-length radio FIFO read: byte loop vs bulk SPI (no payload)
+
+#define CMD_FIRST         CMD_GET_INFO
+#define CMD_LAST          CMD_SPI_BENCHMARK
 
 // Response IDs
 #define RESP_INFO_REPLY   0x81
@@ -22,6 +37,47 @@
 #define RESP_RX_PACKET    0x83
 #define RESP_ERROR        0x84
 #define RESP_DEBUG_LOG    0x85
+#define RESP_AIRTIME      0x86        // protocol, length, symbol time us (u32), airtime us (u32), payload symbols (u16)
+#define RESP_PROTOCOL_STATS 0x87      // protocol, rx/tx/parseErr/convErr/deferred/budgetDrops/airtimeMs (u32 each),
+                                      // budget percent, window s (u16), policy, available ms (u32),
+                                      // listen ms, frames caught, dwells (u32 each), last dwell ms (u16),
+                                      // hop limit drops (u32)
+#define RESP_RELAY_STATS  0x88        // section, then section-specific counters (see below)
+#define RESP_LATENCY      0x89        // direction, stage, bucket count, then one u16 count per log2 us bucket
+#define RESP_SPI_BENCHMARK 0x8A       // supported, bytes per read (u16), runs,
+                                      // byte loop us, bulk us, bulk CPU us (u32 each, per read),
+                                      // then frame readout: frame bytes, getter sequence us,
+                                      // single fetch us (u32 each, per readout)
+
+// CMD_GET_RELAY_STATS sections - kept separate so each reply stays within 64 bytes
+#define RELAY_STATS_DUP_CACHE 0x00    // hits, misses, evictions (u32 each), live entries, capacity, TTL s (u16)
+#define RELAY_STATS_LBT   0x01        // enabled, CW min, CW max, max attempts,
+                                      // CAD checks, CAD busy, backoffs, backoff ms, aborts (u32 each)
+#define RELAY_STATS_DWELL 0x02        // auto mode, listen protocol, min dwell ms (u16), max dwell ms (u16)
+#define RELAY_STATS_RX_GUARD 0x03     // radios receiving now (bit n = radio n), receptions saved, receptions aborted (u32 each)
+#define RELAY_STATS_LOOP  0x04        // main loop passes, average us, max us (u32 each)
+#define RELAY_STATS_PRIORITY 0x05     // per priority class (text, control, telemetry, bulk):
+                                      // enqueued, dropped (u32 each)
+#define RELAY_STATS_STORE 0x06        // TX queue occupancy, capacity, peak,
+                                      // retries, expired, sent, avg age ms, max age ms (u32 each)
+#define RELAY_STATS_RATE_LIMIT 0x07   // frames per minute (u16), burst, tracked sources, capacity,
+                                      // allowed, throttled, evictions (u32 each), listed count, then the
+                                      // most throttled sources: protocol, source key (u32), drops (u32)
+#define RELAY_STATS_RATE_LIMIT_LISTED 5
+#define RELAY_STATS_RECONFIG 0x08     // parameter writes sent, skipped as unchanged, profile switches,
+                                      // profile switch avg us, max us (u32 each), entry count,
+                                      // then per protocol transition: from, to, count, avg us, max us (u32 each)
+#define RELAY_STATS_RADIO_BUSY 0x09   // faulted, BUSY waits, total wait us, max wait us,
+                                      // timeouts, recoveries (u32 each)
+#define RELAY_STATS_TX_PRELOAD 0x0A   // preloads, preloads not armed, then TX start (channel clear to SetTx)
+                                      // uploaded, preloaded: count, avg us, max us (u32 each)
+#define RELAY_STATS_NOISE 0x0B        // entry count, then per protocol: protocol, noise floor (i16, 1/16 dBm),
+                                      // busy share (u16, 65535 = 100%), reject threshold dBm (i16),
+                                      // samples, frames rejected (u32 each)
+#define RELAY_STATS_RX_READOUT 0x0C   // frames read out, readout avg us, max us,
+                                      // RX_DONE to frame in RAM avg us, max us (u32 each)
+#define RELAY_STATS_TURNAROUND 0x0D   // fast mode, image calibrations run, skipped, then
+                                      // RX->TX, TX->RX: count, avg us, max us (u32 each)
 
 class USBComm {
 public:
@@ -29,14 +85,34 @@ public:
     void process();
     void sendInfo();
     void sendStats();
-    void sendRxPacket(uint8_t protocol, int16_t rssi, int8_t snr, uint8_t* data, uint8_t len);
+    void sendAirtime(uint8_t protocol, uint8_t length);
+    void sendProtocolStats(uint8_t protocol);
+    void sendRelayStats(uint8_t section);
+    void sendLatency(uint8_t direction, uint8_t stage);
+    void sendSpiBenchmark();
+    void sendRxPacket(uint8_t protocol, int16_t rssi, int8_t snr, uint8_t* data, uint8_t len, uint32_t rxUs);
     void sendDebugLog(const char* message);
     void sendError(const char* errorMessage);
     
 private:
     void handleCommand(uint8_t cmd, uint8_t* data, uint8_t len);
     void sendResponse(uint8_t respId, uint8_t* data, uint8_t len);
-    bool readCommand(uint8_t* cmd, uint8_t* data, uint8_t* len);
+    bool readCommand();
+    void flushTx();
+    
+    // Command being received - its payload may arrive over several loops
+    uint8_t rxCmd;
+    uint8_t rxLen;
+    uint8_t rxCount;
+    bool rxHeaderDone;
+    uint32_t rxStartMs;
+    uint8_t rxData[64];
+    
+    // Responses waiting for room in the serial TX buffer (ring)
+    uint8_t txBuffer[USB_TX_BUFFER_SIZE];
+    uint16_t txHead;
+    uint16_t txTail;
+    uint16_t txCount;
 };
 
 extern USBComm usbComm;
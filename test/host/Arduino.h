@@ -0,0 +1,90 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the Arduino core: just what the radio drivers under test
+// use. NSS pin writes select a simulated radio (sx1276_sim.h, sx1262_sim.h),
+// BUSY pins read back the simulated SX1262's level.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "sx1276_sim.h"
+#include "sx1262_sim.h"
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+#define RISING  3
+#define FALLING 2
+
+inline void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value) {
+    sx1276_sim_nss((int8_t)pin, value != LOW);
+    sx1262_sim_nss((int8_t)pin, value != LOW);
+}
+
+inline int digitalRead(uint8_t pin) {
+    bool high = false;
+    sx1262_sim_readBusy((int8_t)pin, &high);
+    return high ? HIGH : LOW;
+}
+
+inline unsigned long* host_clockUs() {
+    static unsigned long clockUs = 0;
+    return &clockUs;
+}
+
+// Time only moves when the code under test waits
+inline unsigned long micros() {
+    return ++*host_clockUs();
+}
+
+inline unsigned long millis() {
+    return *host_clockUs() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    *host_clockUs() += ms * 1000;
+}
+
+inline void delayMicroseconds(unsigned int us) {
+    *host_clockUs() += us;
+}
+
+inline int digitalPinToInterrupt(uint8_t pin) {
+    return pin;
+}
+
+#define HOST_MAX_PINS 64
+
+// Handlers passed to attachInterrupt(), per pin
+inline void (**host_interruptHandlers())() {
+    static void (*handlers[HOST_MAX_PINS])();
+    return handlers;
+}
+
+inline void attachInterrupt(int interrupt, void (*handler)(), int mode) {
+    (void)mode;
+    if (interrupt >= 0 && interrupt < HOST_MAX_PINS) {
+        host_interruptHandlers()[interrupt] = handler;
+    }
+}
+
+// Runs the handler attached to `pin`, as the edge it waits for would
+inline void host_fireInterrupt(uint8_t pin) {
+    if (pin < HOST_MAX_PINS && host_interruptHandlers()[pin] != nullptr) {
+        host_interruptHandlers()[pin]();
+    }
+}
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+#endif // ARDUINO_H
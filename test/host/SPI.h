@@ -0,0 +1,40 @@
+#ifndef SPI_H
+#define SPI_H
+
+// Host stand-in for the Arduino SPI library: bytes go to the simulated radio
+// whose NSS is low (sx1276_sim.h, sx1262_sim.h)
+
+#include <stdint.h>
+#include "sx1276_sim.h"
+#include "sx1262_sim.h"
+
+#define MSBFIRST  1
+#define SPI_MODE0 0x00
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) {
+        (void)clock;
+        (void)bitOrder;
+        (void)dataMode;
+    }
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void beginTransaction(SPISettings settings) {
+        (void)settings;
+    }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data) {
+        if (sx1276_sim_bus()->selected != nullptr) {
+            return sx1276_sim_transfer(data);
+        }
+        return sx1262_sim_transfer(data);
+    }
+};
+
+inline SPIClass SPI;
+
+#endif // SPI_H
@@ -0,0 +1,6 @@
+#ifndef AVR_INTERRUPT_H
+#define AVR_INTERRUPT_H
+
+// Host stand-in - the drivers under test only need the header to exist
+
+#endif // AVR_INTERRUPT_H
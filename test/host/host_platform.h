@@ -0,0 +1,63 @@
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+// Host stand-in for the platform SPI functions the radio drivers call
+// (platforms/platform_interface.h). Defines them, so each test program
+// includes it from exactly one file. A background transfer runs on the next
+// platform_spiPoll(), the way a DMA job finishes some time after it started.
+
+#include <SPI.h>
+#include "platforms/platform_interface.h"
+
+typedef struct {
+    const uint8_t* tx;
+    uint8_t* rx;
+    uint16_t len;
+    void (*done)(void* context);
+    void* context;
+    bool running;
+} HostSpiJob;
+
+inline HostSpiJob* host_spiJob() {
+    static HostSpiJob job;
+    return &job;
+}
+
+uint32_t platform_getSpiFrequency() {
+    return 8000000;
+}
+
+void platform_spiTransfer(const uint8_t* tx, uint8_t* rx, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t in = SPI.transfer(tx != nullptr ? tx[i] : 0x00);
+        if (rx != nullptr) {
+            rx[i] = in;
+        }
+    }
+}
+
+bool platform_spiStart(const uint8_t* tx, uint8_t* rx, uint16_t len, void (*done)(void* context), void* context) {
+    HostSpiJob* job = host_spiJob();
+    if (job->running) {
+        return false;
+    }
+    job->tx = tx;
+    job->rx = rx;
+    job->len = len;
+    job->done = done;
+    job->context = context;
+    job->running = true;
+    return true;
+}
+
+bool platform_spiPoll() {
+    HostSpiJob* job = host_spiJob();
+    if (job->running) {
+        platform_spiTransfer(job->tx, job->rx, job->len);
+        job->running = false;  // done() may start the next transfer
+        job->done(job->context);
+    }
+    return job->running;
+}
+
+#endif // HOST_PLATFORM_H
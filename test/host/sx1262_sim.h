@@ -0,0 +1,112 @@
+#ifndef SX1262_SIM_H
+#define SX1262_SIM_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Simulated SX1262 radios for host tests
+ *
+ * Each simulated radio sits on its own NSS pin and drives its own BUSY pin.
+ * The stub SPI (SPI.h) sends every byte to the radio whose NSS is low; the
+ * first byte of an NSS window is logged as the command opcode, everything
+ * reads back as 0x00. A window with bytes in it is a command: BUSY rises when
+ * NSS does. It drops again at once, unless the test has set `holdBusy`, in
+ * which case it stays high until the test drops it (and fires the BUSY
+ * interrupt, see host_fireInterrupt() in Arduino.h).
+ */
+
+#define SX1262_SIM_MAX_RADIOS 2
+#define SX1262_SIM_LOG_MAX    64
+
+typedef struct {
+    int8_t pinNss;
+    int8_t pinBusy;
+    bool busy;                  // BUSY level
+    bool holdBusy;              // Commands keep BUSY high until released
+    uint8_t windowBytes;        // Bytes in the current NSS window
+    uint8_t opcodes[SX1262_SIM_LOG_MAX];
+    uint8_t commands;           // Commands seen (opcodes logged up to the max)
+} Sx1262Sim;
+
+typedef struct {
+    Sx1262Sim radios[SX1262_SIM_MAX_RADIOS];
+    Sx1262Sim* selected;        // Radio whose NSS is low
+} Sx1262SimBus;
+
+inline Sx1262SimBus* sx1262_sim_bus() {
+    static Sx1262SimBus bus;
+    return &bus;
+}
+
+// Forget all radios and put a fresh one on each NSS/BUSY pair (-1: none)
+inline void sx1262_sim_reset(int8_t nss0, int8_t busy0, int8_t nss1, int8_t busy1) {
+    Sx1262SimBus* bus = sx1262_sim_bus();
+    memset(bus, 0, sizeof(*bus));
+    bus->radios[0].pinNss = nss0;
+    bus->radios[0].pinBusy = busy0;
+    bus->radios[1].pinNss = nss1;
+    bus->radios[1].pinBusy = busy1;
+}
+
+inline Sx1262Sim* sx1262_sim_radio(int8_t pinNss) {
+    Sx1262SimBus* bus = sx1262_sim_bus();
+    for (uint8_t i = 0; i < SX1262_SIM_MAX_RADIOS; i++) {
+        if (bus->radios[i].pinNss == pinNss && pinNss >= 0) {
+            return &bus->radios[i];
+        }
+    }
+    return nullptr;
+}
+
+// Clears the log
+inline void sx1262_sim_clearLog(Sx1262Sim* radio) {
+    radio->commands = 0;
+}
+
+// Called by the stub digitalRead(): true (and the level) for a BUSY pin
+inline bool sx1262_sim_readBusy(int8_t pin, bool* high) {
+    Sx1262SimBus* bus = sx1262_sim_bus();
+    for (uint8_t i = 0; i < SX1262_SIM_MAX_RADIOS; i++) {
+        if (bus->radios[i].pinBusy == pin && pin >= 0) {
+            *high = bus->radios[i].busy;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Called by the stub digitalWrite()
+inline void sx1262_sim_nss(int8_t pin, bool high) {
+    Sx1262SimBus* bus = sx1262_sim_bus();
+    Sx1262Sim* radio = sx1262_sim_radio(pin);
+    if (radio == nullptr) {
+        return;
+    }
+    if (!high) {
+        bus->selected = radio;
+        radio->windowBytes = 0;
+    } else if (bus->selected == radio) {
+        bus->selected = nullptr;
+        if (radio->windowBytes > 0) {
+            radio->busy = radio->holdBusy;
+        }
+    }
+}
+
+// Called by the stub SPI.transfer()
+inline uint8_t sx1262_sim_transfer(uint8_t out) {
+    Sx1262Sim* radio = sx1262_sim_bus()->selected;
+    if (radio == nullptr) {
+        return 0xFF;
+    }
+    if (radio->windowBytes++ == 0) {
+        if (radio->commands < SX1262_SIM_LOG_MAX) {
+            radio->opcodes[radio->commands] = out;
+        }
+        radio->commands++;
+    }
+    return 0x00;
+}
+
+#endif // SX1262_SIM_H
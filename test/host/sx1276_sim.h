@@ -0,0 +1,128 @@
+#ifndef SX1276_SIM_H
+#define SX1276_SIM_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Simulated SX1276 radios for host tests
+ *
+ * Each simulated radio sits on its own NSS pin and has a register file and a
+ * 256-byte FIFO. The stub SPI (SPI.h) sends every byte to the radio whose NSS
+ * is low: the first byte of an NSS window is the address (bit 7 = write),
+ * the following ones read or write consecutive registers, except RegFifo
+ * (0x00), which moves through the FIFO at RegFifoAddrPtr. RegIrqFlags is
+ * write-1-to-clear, RegVersion reads 0x12.
+ */
+
+#define SX1276_SIM_MAX_RADIOS 2
+
+typedef struct {
+    int8_t pinNss;
+    uint8_t regs[0x80];
+    uint8_t fifo[256];
+    uint32_t writes;            // Register (not FIFO) writes seen
+} Sx1276Sim;
+
+typedef struct {
+    Sx1276Sim radios[SX1276_SIM_MAX_RADIOS];
+    Sx1276Sim* selected;        // Radio whose NSS is low
+    bool address;               // Next byte is the address
+    uint8_t reg;
+    bool write;
+} Sx1276SimBus;
+
+inline Sx1276SimBus* sx1276_sim_bus() {
+    static Sx1276SimBus bus;
+    return &bus;
+}
+
+// Forget all radios and put a fresh one on each pin (-1: none)
+inline void sx1276_sim_reset(int8_t nss0, int8_t nss1) {
+    Sx1276SimBus* bus = sx1276_sim_bus();
+    memset(bus, 0, sizeof(*bus));
+    bus->radios[0].pinNss = nss0;
+    bus->radios[1].pinNss = nss1;
+    for (uint8_t i = 0; i < SX1276_SIM_MAX_RADIOS; i++) {
+        bus->radios[i].regs[0x42] = 0x12;
+    }
+}
+
+inline Sx1276Sim* sx1276_sim_radio(int8_t pinNss) {
+    Sx1276SimBus* bus = sx1276_sim_bus();
+    for (uint8_t i = 0; i < SX1276_SIM_MAX_RADIOS; i++) {
+        if (bus->radios[i].pinNss == pinNss && pinNss >= 0) {
+            return &bus->radios[i];
+        }
+    }
+    return nullptr;
+}
+
+// A frame the simulated receiver has just finished (RX_DONE raised)
+inline void sx1276_sim_receive(Sx1276Sim* radio, const uint8_t* data, uint8_t len, uint8_t rssiValue) {
+    uint8_t base = radio->regs[0x0F];
+    for (uint8_t i = 0; i < len; i++) {
+        radio->fifo[(uint8_t)(base + i)] = data[i];
+    }
+    radio->regs[0x10] = base;
+    radio->regs[0x13] = len;
+    radio->regs[0x1A] = rssiValue;
+    radio->regs[0x25] = (uint8_t)(base + len);
+    radio->regs[0x12] |= 0x40;
+}
+
+// Called by the stub digitalWrite()
+inline void sx1276_sim_nss(int8_t pin, bool high) {
+    Sx1276SimBus* bus = sx1276_sim_bus();
+    Sx1276Sim* radio = sx1276_sim_radio(pin);
+    if (radio == nullptr) {
+        return;
+    }
+    if (!high) {
+        bus->selected = radio;
+        bus->address = true;
+    } else if (bus->selected == radio) {
+        bus->selected = nullptr;
+    }
+}
+
+// Called by the stub SPI.transfer()
+inline uint8_t sx1276_sim_transfer(uint8_t out) {
+    Sx1276SimBus* bus = sx1276_sim_bus();
+    Sx1276Sim* radio = bus->selected;
+    if (radio == nullptr) {
+        return 0xFF;
+    }
+    if (bus->address) {
+        bus->address = false;
+        bus->reg = out & 0x7F;
+        bus->write = (out & 0x80) != 0;
+        return 0x00;
+    }
+
+    uint8_t in = 0x00;
+    if (bus->reg == 0x00) {
+        uint8_t* ptr = &radio->regs[0x0D];
+        if (bus->write) {
+            radio->fifo[*ptr] = out;
+        } else {
+            in = radio->fifo[*ptr];
+        }
+        (*ptr)++;
+        return in;
+    }
+    if (bus->write) {
+        if (bus->reg == 0x12) {
+            radio->regs[0x12] &= (uint8_t)~out;
+        } else {
+            radio->regs[bus->reg] = out;
+        }
+        radio->writes++;
+    } else {
+        in = radio->regs[bus->reg];
+    }
+    bus->reg = (bus->reg + 1) & 0x7F;
+    return in;
+}
+
+#endif // SX1276_SIM_H
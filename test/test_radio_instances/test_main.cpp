@@ -0,0 +1,134 @@
+// Two SX1276 driver instances on one simulated SPI bus (pio test -e native):
+// every call must reach only the radio it was given, and each instance keeps
+// its own shadow, mode and preload state.
+
+#include <unity.h>
+#include "sx1276_sim.h"
+#include "host_platform.h"
+#include "radio/sx1276_direct/sx1276_direct.h"
+
+#define PIN_NSS_A 8
+#define PIN_NSS_B 12
+
+static Sx1276Direct radioA;
+static Sx1276Direct radioB;
+
+static const RadioPins pinsA = { PIN_NSS_A, 4, 7, -1, -1, -1 };
+static const RadioPins pinsB = { PIN_NSS_B, 5, 3, -1, -1, -1 };
+
+static uint32_t frf(const Sx1276Sim* radio) {
+    return ((uint32_t)radio->regs[REG_FRF_MSB] << 16) | ((uint32_t)radio->regs[REG_FRF_MID] << 8) | radio->regs[REG_FRF_LSB];
+}
+
+void setUp() {
+    sx1276_sim_reset(PIN_NSS_A, PIN_NSS_B);
+    memset(&radioA, 0, sizeof(radioA));
+    memset(&radioB, 0, sizeof(radioB));
+    TEST_ASSERT_TRUE(sx1276_direct_init(&radioA, &pinsA));
+    TEST_ASSERT_TRUE(sx1276_direct_init(&radioB, &pinsB));
+}
+
+void tearDown() {}
+
+static void test_init_fails_without_radio_on_pins() {
+    Sx1276Direct missing;
+    memset(&missing, 0, sizeof(missing));
+    const RadioPins pins = { 20, -1, 21, -1, -1, -1 };
+    TEST_ASSERT_FALSE(sx1276_direct_init(&missing, &pins));
+}
+
+static void test_frequency_reaches_only_its_radio() {
+    Sx1276Sim* a = sx1276_sim_radio(PIN_NSS_A);
+    Sx1276Sim* b = sx1276_sim_radio(PIN_NSS_B);
+    uint32_t frfB = frf(b);
+
+    sx1276_direct_setFrequency(&radioA, 869525000);
+    TEST_ASSERT_EQUAL_HEX32(0xD96199, frf(a));
+    TEST_ASSERT_EQUAL_HEX32(frfB, frf(b));
+}
+
+static void test_shadows_are_independent() {
+    Sx1276Sim* b = sx1276_sim_radio(PIN_NSS_B);
+    sx1276_direct_setFrequency(&radioA, 869525000);
+
+    // A shared shadow would skip this as unchanged
+    uint32_t writes = b->writes;
+    sx1276_direct_setFrequency(&radioB, 869525000);
+    TEST_ASSERT_EQUAL_HEX32(0xD96199, frf(b));
+    TEST_ASSERT_TRUE(b->writes > writes);
+
+    // Same value again on B - now skipped
+    writes = b->writes;
+    sx1276_direct_setFrequency(&radioB, 869525000);
+    TEST_ASSERT_EQUAL_UINT32(writes, b->writes);
+}
+
+static void test_profile_applies_to_one_radio() {
+    RadioSettings settings;
+    memset(&settings, 0, sizeof(settings));
+    settings.frequencyHz = 906875000;
+    settings.bandwidth = 8;
+    settings.spreadingFactor = 11;
+    settings.codingRate = 5;
+    settings.syncWord = 0x2B;
+    settings.preambleLength = 16;
+    settings.crcEnabled = true;
+    RadioProfile profile;
+    memset(&profile, 0, sizeof(profile));
+    sx1276_direct_compileProfile(&settings, &profile);
+
+    Sx1276Sim* a = sx1276_sim_radio(PIN_NSS_A);
+    Sx1276Sim* b = sx1276_sim_radio(PIN_NSS_B);
+    uint32_t writesA = a->writes;
+    sx1276_direct_applyProfile(&radioB, &profile);
+    TEST_ASSERT_EQUAL_UINT32(writesA, a->writes);
+    TEST_ASSERT_EQUAL_HEX8(0x2B, b->regs[REG_SYNC_WORD]);
+    TEST_ASSERT_EQUAL_HEX8(0xB4, b->regs[REG_MODEM_CONFIG_2]);
+}
+
+static void test_fetch_frame_per_radio() {
+    const uint8_t frameA[4] = { 0xA1, 0xA2, 0xA3, 0xA4 };
+    const uint8_t frameB[3] = { 0xB1, 0xB2, 0xB3 };
+    sx1276_sim_receive(sx1276_sim_radio(PIN_NSS_A), frameA, sizeof(frameA), 70);
+    sx1276_sim_receive(sx1276_sim_radio(PIN_NSS_B), frameB, sizeof(frameB), 40);
+
+    uint8_t data[16];
+    RadioFrame frame;
+    TEST_ASSERT_TRUE(sx1276_direct_fetchFrame(&radioB, data, sizeof(data), &frame));
+    TEST_ASSERT_EQUAL_UINT8(3, frame.length);
+    TEST_ASSERT_EQUAL_INT16(-124, frame.rssi);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(frameB, data, sizeof(frameB));
+
+    // B's readout cleared only B's RX_DONE
+    TEST_ASSERT_FALSE(sx1276_direct_isPacketReceived(&radioB));
+    TEST_ASSERT_TRUE(sx1276_direct_isPacketReceived(&radioA));
+    TEST_ASSERT_TRUE(sx1276_direct_fetchFrame(&radioA, data, sizeof(data), &frame));
+    TEST_ASSERT_EQUAL_UINT8(4, frame.length);
+    TEST_ASSERT_EQUAL_INT16(-94, frame.rssi);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(frameA, data, sizeof(frameA));
+}
+
+static void test_preload_per_radio() {
+    const uint8_t payload[5] = { 1, 2, 3, 4, 5 };
+    TEST_ASSERT_TRUE(sx1276_direct_preloadTx(&radioA, payload, sizeof(payload)));
+
+    // Nothing preloaded on B - it uploads the normal way
+    TEST_ASSERT_FALSE(sx1276_direct_armTxPreload(&radioB));
+
+    TEST_ASSERT_TRUE(sx1276_direct_armTxPreload(&radioA));
+    Sx1276Sim* a = sx1276_sim_radio(PIN_NSS_A);
+    TEST_ASSERT_EQUAL_HEX8(256 - sizeof(payload), a->regs[REG_FIFO_TX_BASE_ADDR]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, &a->fifo[256 - sizeof(payload)], sizeof(payload));
+    TEST_ASSERT_EQUAL_HEX8(0x00, sx1276_sim_radio(PIN_NSS_B)->regs[REG_FIFO_TX_BASE_ADDR]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_fails_without_radio_on_pins);
+    RUN_TEST(test_frequency_reaches_only_its_radio);
+    RUN_TEST(test_shadows_are_independent);
+    RUN_TEST(test_profile_applies_to_one_radio);
+    RUN_TEST(test_fetch_frame_per_radio);
+    RUN_TEST(test_preload_per_radio);
+    return UNITY_END();
+}
@@ -0,0 +1,201 @@
+// SX1262 command engine against simulated radios (pio test -e native):
+// batches run and report in order, the BUSY edge starts the next command,
+// a full queue refuses more, and a BUSY timeout fails everything queued and
+// faults the radio until it is reinitialized.
+
+#include <unity.h>
+#include <Arduino.h>
+#include "sx1262_sim.h"
+#include "host_platform.h"
+#include "radio/radio_busy.h"
+#include "radio/sx1262_direct/sx1262_direct.h"
+
+#define PIN_NSS_A  8
+#define PIN_BUSY_A 4
+#define PIN_NSS_B  12
+#define PIN_BUSY_B 5
+
+static Sx1262Direct radioA;
+static Sx1262Direct radioB;
+static const RadioPins pinsA = { PIN_NSS_A, -1, -1, 7, PIN_BUSY_A, -1 };
+static const RadioPins pinsB = { PIN_NSS_B, -1, -1, 3, PIN_BUSY_B, -1 };
+
+// Batches reported through onDone(), in order
+static uint8_t reported[8];
+static bool reportedOk[8];
+static uint8_t reportedCount;
+
+static void onDone(bool ok, void* context) {
+    reported[reportedCount] = *(const uint8_t*)context;
+    reportedOk[reportedCount] = ok;
+    reportedCount++;
+}
+
+static const uint8_t tags[5] = { 1, 2, 3, 4, 5 };
+static const uint8_t params[2] = { 0x00, 0x00 };
+
+static Sx1262Command makeCommand(uint8_t opcode, uint32_t timeoutUs) {
+    Sx1262Command cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.header[0] = opcode;
+    cmd.headerLen = 1;
+    cmd.txData = params;
+    cmd.dataLen = sizeof(params);
+    cmd.timeoutUs = timeoutUs;
+    return cmd;
+}
+
+static void pollUntilIdle(Sx1262Direct* dev) {
+    for (uint32_t i = 0; i < 100000 && !sx1262_direct_isIdle(dev); i++) {
+        sx1262_direct_poll(dev);
+    }
+    TEST_ASSERT_TRUE(sx1262_direct_isIdle(dev));
+}
+
+void setUp() {
+    sx1262_sim_reset(PIN_NSS_A, PIN_BUSY_A, PIN_NSS_B, PIN_BUSY_B);
+    memset(host_spiJob(), 0, sizeof(HostSpiJob));
+    memset(&radioA, 0, sizeof(radioA));
+    memset(&radioB, 0, sizeof(radioB));
+    radio_busy_clearFault();
+    TEST_ASSERT_TRUE(sx1262_direct_init(&radioA, 0, &pinsA));
+    TEST_ASSERT_TRUE(sx1262_direct_init(&radioB, 1, &pinsB));
+    sx1262_sim_clearLog(sx1262_sim_radio(PIN_NSS_A));
+    sx1262_sim_clearLog(sx1262_sim_radio(PIN_NSS_B));
+    reportedCount = 0;
+}
+
+void tearDown() {}
+
+static void test_batches_run_and_report_in_order() {
+    const Sx1262Command first[2] = { makeCommand(CMD_SET_STANDBY, 0), makeCommand(CMD_SET_REGULATOR_MODE, 0) };
+    const Sx1262Command second = makeCommand(CMD_CLEAR_IRQ_STATUS, 0);
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, first, 2, onDone, (void*)&tags[0]));
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &second, 1, onDone, (void*)&tags[1]));
+    pollUntilIdle(&radioA);
+
+    Sx1262Sim* a = sx1262_sim_radio(PIN_NSS_A);
+    const uint8_t opcodes[3] = { CMD_SET_STANDBY, CMD_SET_REGULATOR_MODE, CMD_CLEAR_IRQ_STATUS };
+    TEST_ASSERT_EQUAL_UINT8(3, a->commands);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(opcodes, a->opcodes, 3);
+    TEST_ASSERT_EQUAL_UINT8(2, reportedCount);
+    TEST_ASSERT_EQUAL_UINT8(1, reported[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, reported[1]);
+    TEST_ASSERT_TRUE(reportedOk[0]);
+    TEST_ASSERT_TRUE(reportedOk[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, sx1262_sim_radio(PIN_NSS_B)->commands);
+}
+
+static void test_busy_edge_starts_next_command() {
+    Sx1262Sim* a = sx1262_sim_radio(PIN_NSS_A);
+    a->holdBusy = true;
+    const Sx1262Command first = makeCommand(CMD_SET_STANDBY, 0);
+    const Sx1262Command second = makeCommand(CMD_SET_REGULATOR_MODE, 0);
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &first, 1, onDone, (void*)&tags[0]));
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &second, 1, onDone, (void*)&tags[1]));
+
+    // The second command waits for BUSY, however often the engine is polled
+    for (uint8_t i = 0; i < 20; i++) {
+        sx1262_direct_poll(&radioA);
+    }
+    TEST_ASSERT_EQUAL_UINT8(1, a->commands);
+    TEST_ASSERT_TRUE(a->busy);
+    TEST_ASSERT_EQUAL_UINT8(0, reportedCount);
+
+    // BUSY falling edge: the first batch is done and the next command goes out
+    a->holdBusy = false;
+    a->busy = false;
+    host_fireInterrupt(PIN_BUSY_A);
+    pollUntilIdle(&radioA);
+    TEST_ASSERT_EQUAL_UINT8(2, a->commands);
+    TEST_ASSERT_EQUAL_HEX8(CMD_SET_REGULATOR_MODE, a->opcodes[1]);
+    TEST_ASSERT_EQUAL_UINT8(2, reportedCount);
+    TEST_ASSERT_TRUE(reportedOk[0]);
+    TEST_ASSERT_TRUE(reportedOk[1]);
+    TEST_ASSERT_FALSE(radio_busy_hasFault());
+}
+
+static void test_full_queue_refuses_batches() {
+    sx1262_sim_radio(PIN_NSS_A)->holdBusy = true;
+    const Sx1262Command cmd = makeCommand(CMD_SET_STANDBY, 0);
+    for (uint8_t i = 0; i < SX1262_CMD_QUEUE_BATCHES; i++) {
+        TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &cmd, 1, onDone, (void*)&tags[i]));
+    }
+    TEST_ASSERT_FALSE(sx1262_direct_submit(&radioA, &cmd, 1, onDone, (void*)&tags[4]));
+    TEST_ASSERT_FALSE(sx1262_direct_submit(&radioA, &cmd, 0, onDone, (void*)&tags[4]));
+
+    // Once the radio lets go, everything accepted runs
+    Sx1262Sim* a = sx1262_sim_radio(PIN_NSS_A);
+    a->holdBusy = false;
+    a->busy = false;
+    pollUntilIdle(&radioA);
+    TEST_ASSERT_EQUAL_UINT8(SX1262_CMD_QUEUE_BATCHES, a->commands);
+    TEST_ASSERT_EQUAL_UINT8(SX1262_CMD_QUEUE_BATCHES, reportedCount);
+    for (uint8_t i = 0; i < SX1262_CMD_QUEUE_BATCHES; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i + 1, reported[i]);
+        TEST_ASSERT_TRUE(reportedOk[i]);
+    }
+}
+
+static void test_busy_timeout_fails_queue_and_faults() {
+    Sx1262Sim* a = sx1262_sim_radio(PIN_NSS_A);
+    a->holdBusy = true;
+    const Sx1262Command stuck = makeCommand(CMD_CALIBRATE, 100);
+    const Sx1262Command next = makeCommand(CMD_SET_STANDBY, 0);
+    uint32_t timeouts = radio_busy_getStats()->timeouts;
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &stuck, 1, onDone, (void*)&tags[0]));
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &next, 1, onDone, (void*)&tags[1]));
+    pollUntilIdle(&radioA);
+
+    // Both batches fail; the one behind the stuck command never went out
+    TEST_ASSERT_EQUAL_UINT8(1, a->commands);
+    TEST_ASSERT_EQUAL_UINT8(2, reportedCount);
+    TEST_ASSERT_FALSE(reportedOk[0]);
+    TEST_ASSERT_FALSE(reportedOk[1]);
+    TEST_ASSERT_TRUE(radio_busy_hasFault());
+    TEST_ASSERT_EQUAL_UINT32(timeouts + 1, radio_busy_getStats()->timeouts);
+
+    // Faulted: nothing more is accepted, even once BUSY drops
+    a->holdBusy = false;
+    a->busy = false;
+    TEST_ASSERT_FALSE(sx1262_direct_submit(&radioA, &next, 1, onDone, (void*)&tags[2]));
+
+    // The other radio on the bus carries on
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioB, &next, 1, onDone, (void*)&tags[3]));
+    pollUntilIdle(&radioB);
+    TEST_ASSERT_EQUAL_UINT8(1, sx1262_sim_radio(PIN_NSS_B)->commands);
+    TEST_ASSERT_TRUE(reportedOk[2]);
+}
+
+static void test_init_clears_fault() {
+    sx1262_sim_radio(PIN_NSS_A)->holdBusy = true;
+    const Sx1262Command stuck = makeCommand(CMD_CALIBRATE, 100);
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &stuck, 1, onDone, (void*)&tags[0]));
+    pollUntilIdle(&radioA);
+    TEST_ASSERT_FALSE(sx1262_direct_submit(&radioA, &stuck, 1, onDone, (void*)&tags[1]));
+
+    Sx1262Sim* a = sx1262_sim_radio(PIN_NSS_A);
+    a->holdBusy = false;
+    a->busy = false;
+    uint32_t recoveries = radio_busy_getStats()->recoveries;
+    TEST_ASSERT_TRUE(sx1262_direct_init(&radioA, 0, &pinsA));
+    radio_busy_clearFault();
+
+    const Sx1262Command cmd = makeCommand(CMD_SET_STANDBY, 0);
+    TEST_ASSERT_TRUE(sx1262_direct_submit(&radioA, &cmd, 1, onDone, (void*)&tags[2]));
+    pollUntilIdle(&radioA);
+    TEST_ASSERT_EQUAL_UINT8(2, reportedCount);
+    TEST_ASSERT_EQUAL_UINT8(3, reported[1]);
+    TEST_ASSERT_TRUE(reportedOk[1]);
+    TEST_ASSERT_EQUAL_UINT32(recoveries + 1, radio_busy_getStats()->recoveries);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_batches_run_and_report_in_order);
+    RUN_TEST(test_busy_edge_starts_next_command);
+    RUN_TEST(test_full_queue_refuses_batches);
+    RUN_TEST(test_busy_timeout_fails_queue_and_faults);
+    RUN_TEST(test_init_clears_fault);
+    return UNITY_END();
+}
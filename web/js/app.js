@@ -10,6 +10,7 @@ class App {
                 bandwidth: i === 0 ? 6 : 8, // Default bandwidths
                 rx: 0,
                 tx: 0,
+                listenMs: 0,
                 lastRxTime: null
             };
         }
@@ -727,7 +728,8 @@ class App {
                     
                     window.UI.updateLastPacket(packet.protocol, packet.rssi, packet.snr, packet.data);
                     const protocolName = window.ProtocolRegistry.getName(packet.protocol);
-                    window.UI.addLogEntry(`${protocolName} packet: RSSI=${packet.rssi}dBm SNR=${packet.snr}dB Len=${packet.data.length}`, 'info');
+                    const rxTime = packet.rxUs !== null ? ` t=${packet.rxUs}us` : '';
+                    window.UI.addLogEntry(`${protocolName} packet: RSSI=${packet.rssi}dBm SNR=${packet.snr}dB Len=${packet.data.length}${rxTime}`, 'info');
                 }
                 break;
                 
@@ -743,6 +745,134 @@ class App {
                 }
                 break;
                 
+            case window.Protocol.RESP_AIRTIME:
+                const airtime = window.Protocol.decodeAirtime(data);
+                if (airtime) {
+                    const protocolName = window.ProtocolRegistry.getName(airtime.protocol);
+                    window.UI.addLogEntry(`${protocolName} airtime: ${airtime.length} bytes = ${(airtime.airtimeUs / 1000).toFixed(1)} ms (symbol ${airtime.symbolTimeUs} us, ${airtime.payloadSymbols} payload symbols)`, 'info');
+                }
+                break;
+                
+            case window.Protocol.RESP_PROTOCOL_STATS:
+                const protoStats = window.Protocol.decodeProtocolStats(data);
+                if (protoStats) {
+                    const protocolName = window.ProtocolRegistry.getName(protoStats.protocol);
+                    const policy = protoStats.budgetPolicy === 1 ? 'drop' : 'defer';
+                    console.log(`[Stats] ${protocolName} RX: ${protoStats.rxCount} TX: ${protoStats.txCount}, ` +
+                        `airtime ${protoStats.txAirtimeMs} ms, deferred ${protoStats.txDeferred}, budget drops ${protoStats.txBudgetDrops}, ` +
+                        `hop limit drops ${protoStats.hopLimitDrops}, ` +
+                        `budget ${protoStats.budgetPercent}% of ${protoStats.budgetWindowS}s (${policy}), ${protoStats.budgetAvailableMs} ms available`);
+                    
+                    // Listen-time share across protocols (from the latest reply for each)
+                    if (this.state.protocols[protoStats.protocol]) {
+                        this.state.protocols[protoStats.protocol].listenMs = protoStats.listenMs;
+                    }
+                    let totalListenMs = 0;
+                    for (const id in this.state.protocols) {
+                        totalListenMs += this.state.protocols[id].listenMs || 0;
+                    }
+                    const share = totalListenMs > 0 ? (protoStats.listenMs * 100 / totalListenMs).toFixed(1) : '0.0';
+                    console.log(`[Stats] ${protocolName} listening: ${share}% of time, ` +
+                        `${protoStats.framesPerDwellSecond.toFixed(2)} frames/s of dwell, last dwell ${protoStats.lastDwellMs} ms`);
+                }
+                break;
+                
+            case window.Protocol.RESP_RELAY_STATS:
+                const relayStats = window.Protocol.decodeRelayStats(data);
+                if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_DUP_CACHE) {
+                    console.log(`[Stats] Dup cache: ${relayStats.hits} hits, ${relayStats.misses} misses, ` +
+                        `${relayStats.evictions} evictions, ${relayStats.entries}/${relayStats.capacity} entries, TTL ${relayStats.ttlS}s`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_DWELL) {
+                    console.log(`[Stats] Dwell: ${relayStats.autoMode ? 'auto' : 'manual'}, ` +
+                        `${relayStats.minDwellMs}-${relayStats.maxDwellMs} ms`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_RX_GUARD) {
+                    console.log(`[Stats] RX guard: ${relayStats.saved} receptions saved, ` +
+                        `${relayStats.aborted} cut off${relayStats.receiving ? ` (receiving now, radio mask 0x${relayStats.receivingMask.toString(16)})` : ''}`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_STORE) {
+                    console.log(`[Stats] TX store: ${relayStats.occupancy}/${relayStats.capacity} (peak ${relayStats.peak}), ` +
+                        `${relayStats.retries} retries, ${relayStats.expired} expired, ` +
+                        `age at TX avg ${relayStats.avgAgeMs} ms / max ${relayStats.maxAgeMs} ms`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_PRIORITY) {
+                    console.log('[Stats] Priority classes: ' + relayStats.classes
+                        .map(c => `${c.name} ${c.enqueued} queued/${c.dropped} dropped`).join(', '));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_RATE_LIMIT) {
+                    const limit = relayStats.ratePerMin > 0 ? `${relayStats.ratePerMin}/min, burst ${relayStats.burst}` : 'off';
+                    const chatty = relayStats.sources
+                        .map(s => `${window.ProtocolRegistry.getName(s.protocol)} ${s.key.toString(16).padStart(8, '0')} (${s.drops})`)
+                        .join(', ');
+                    console.log(`[Stats] Rate limit ${limit}: ${relayStats.allowed} passed, ${relayStats.throttled} throttled, ` +
+                        `${relayStats.tracked}/${relayStats.capacity} sources, ${relayStats.evictions} evictions` +
+                        (chatty ? `; most throttled: ${chatty}` : ''));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_RECONFIG) {
+                    const switches = relayStats.transitions
+                        .filter(t => t.count > 0)
+                        .map(t => `${window.ProtocolRegistry.getName(t.from)}->${window.ProtocolRegistry.getName(t.to)} ` +
+                            `${t.count}x avg ${t.avgUs} us / max ${t.maxUs} us`)
+                        .join(', ');
+                    console.log(`[Stats] Radio config: ${relayStats.applied} writes, ${relayStats.skipped} skipped as unchanged, ` +
+                        `${relayStats.profileSwitches} profile switches avg ${relayStats.profileAvgUs} us / max ${relayStats.profileMaxUs} us` +
+                        (switches ? `; ${switches}` : ''));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_RADIO_BUSY) {
+                    console.log(`[Stats] Radio BUSY: ${relayStats.waits} waits, avg ${relayStats.avgWaitUs.toFixed(1)} us, ` +
+                        `max ${relayStats.maxWaitUs} us, ${relayStats.timeouts} timeouts, ${relayStats.recoveries} recoveries` +
+                        (relayStats.faulted ? ' (faulted)' : ''));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_TX_PRELOAD) {
+                    console.log(`[Stats] TX preload: ${relayStats.preloads} preloaded, ${relayStats.unused} not armed; ` +
+                        `TX start uploaded ${relayStats.uploadedCount}x avg ${relayStats.uploadedAvgUs} us / max ${relayStats.uploadedMaxUs} us, ` +
+                        `preloaded ${relayStats.preloadedCount}x avg ${relayStats.preloadedAvgUs} us / max ${relayStats.preloadedMaxUs} us ` +
+                        `(saves ${relayStats.savedUs} us)`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_NOISE) {
+                    console.log('[Stats] Noise floor: ' + relayStats.channels
+                        .map(c => `${window.ProtocolRegistry.getName(c.protocol)} ${c.floorDbm.toFixed(1)} dBm, ` +
+                            `${(c.busyShare * 100).toFixed(1)}% busy, reject <= ${c.thresholdDbm} dBm ` +
+                            `(${c.rejected} rejected, ${c.samples} samples)`)
+                        .join('; '));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_RX_READOUT) {
+                    console.log(`[Stats] RX readout: ${relayStats.frames} frames, ` +
+                        `readout avg ${relayStats.readoutAvgUs} us / max ${relayStats.readoutMaxUs} us, ` +
+                        `RX_DONE to RAM avg ${relayStats.readyAvgUs} us / max ${relayStats.readyMaxUs} us` +
+                        (relayStats.crcErrors !== null ? `, ${relayStats.crcErrors} CRC errors` : '') +
+                        (relayStats.oversize !== null ? `, ${relayStats.oversize} too long` : ''));
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_TURNAROUND) {
+                    console.log(`[Stats] Turnaround (${relayStats.fastMode ? 'fast' : 'standard'}): ` +
+                        `RX->TX ${relayStats.rxToTxCount}x avg ${relayStats.rxToTxAvgUs} us / max ${relayStats.rxToTxMaxUs} us, ` +
+                        `TX->RX ${relayStats.txToRxCount}x avg ${relayStats.txToRxAvgUs} us / max ${relayStats.txToRxMaxUs} us, ` +
+                        `image calibrations ${relayStats.calibrations} run / ${relayStats.calibrationsSkipped} skipped`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_LOOP) {
+                    console.log(`[Stats] Main loop: ${relayStats.iterations} passes, ` +
+                        `avg ${relayStats.avgUs} us, max ${relayStats.maxUs} us`);
+                } else if (relayStats && relayStats.section === window.Protocol.RELAY_STATS_LBT) {
+                    console.log(`[Stats] LBT ${relayStats.enabled ? 'on' : 'off'}: ${relayStats.cadChecks} CADs, ` +
+                        `${(relayStats.busyRate * 100).toFixed(1)}% busy, avg backoff ${relayStats.avgBackoffMs.toFixed(1)} ms, ` +
+                        `${relayStats.aborts} aborted`);
+                }
+                break;
+                
+            case window.Protocol.RESP_LATENCY:
+                const latency = window.Protocol.decodeLatency(data);
+                if (latency) {
+                    const direction = window.ProtocolRegistry.getName(latency.direction);
+                    console.log(`[Stats] Latency from ${direction}, ${latency.stageName}: ${latency.samples} frames, ` +
+                        `p50 < ${latency.p50Us} us, p99 < ${latency.p99Us} us`);
+                }
+                break;
+                
+            case window.Protocol.RESP_SPI_BENCHMARK:
+                const bench = window.Protocol.decodeSpiBenchmark(data);
+                if (bench && !bench.supported) {
+                    console.log('[Stats] SPI benchmark not supported on this board');
+                } else if (bench) {
+                    console.log(`[Stats] SPI FIFO read, ${bench.bytes} bytes x${bench.runs}: ` +
+                        `byte loop ${bench.byteLoopUs} us (${bench.byteLoopBytesPerUs.toFixed(2)} B/us), ` +
+                        `bulk ${bench.bulkUs} us (${bench.bulkBytesPerUs.toFixed(2)} B/us, ${bench.speedup.toFixed(1)}x), ` +
+                        `CPU ${bench.bulkCpuUs} us in background`);
+                    if (bench.rxFetchUs !== null) {
+                        console.log(`[Stats] Frame readout, ${bench.rxBytes} bytes: getters ${bench.rxGettersUs} us, ` +
+                            `single fetch ${bench.rxFetchUs} us (${bench.rxSpeedup.toFixed(1)}x)`);
+                    }
+                }
+                break;
+                
             case window.Protocol.RESP_ERROR:
                 const errorMsg = window.Protocol.decodeError(data);
                 if (errorMsg && errorMsg.length > 0) {
@@ -12,6 +12,17 @@ const Protocol = {
     CMD_SET_PROTOCOL_PARAMS: 0x08,  // Generic: 1 byte protocol ID + 4 bytes freq + 1 byte bandwidth
     CMD_SET_RX_PROTOCOL: 0x09,       // Set listen protocol: 1 byte protocol ID
     CMD_SET_TX_PROTOCOLS: 0x0A,      // Set transmit protocols: 1 byte bitmask (bit 0=MeshCore, bit 1=Meshtastic)
+    CMD_SET_TX_HOLD: 0x0B,           // Set TX batching max hold time: 2 bytes ms (little-endian)
+    CMD_GET_AIRTIME: 0x0C,           // Airtime estimate: 1 byte protocol ID + 1 byte frame length
+    CMD_SET_AIRTIME_BUDGET: 0x0D,    // Duty cycle: protocol ID + percent + window s (2 bytes LE) + policy (0=defer, 1=drop)
+    CMD_GET_PROTOCOL_STATS: 0x0E,    // Per-protocol counters and budget: 1 byte protocol ID
+    CMD_SET_DUP_TTL: 0x0F,           // Duplicate cache TTL: 2 bytes seconds (little-endian, 0 = disabled)
+    CMD_GET_RELAY_STATS: 0x10,       // Relay subsystem counters: 1 byte section
+    CMD_SET_LBT: 0x11,               // Listen-before-talk: enable + CW min + CW max (slots) + max attempts
+    CMD_SET_DWELL: 0x12,             // Auto-mode dwell bounds: 2 bytes min ms + 2 bytes max ms (little-endian)
+    CMD_GET_LATENCY: 0x13,           // Relay latency histogram: 1 byte direction (source protocol ID) + 1 byte stage
+    CMD_SET_RATE_LIMIT: 0x14,        // Per-source limit: 2 bytes frames per minute (LE, 0 = off) + 1 byte burst
+    CMD_SPI_BENCHMARK: 0x15,         // Time a full-length radio FIFO read: byte loop vs bulk SPI (no payload)
 
     // Response IDs
     RESP_INFO_REPLY: 0x81,
@@ -19,6 +30,39 @@ const Protocol = {
     RESP_RX_PACKET: 0x83,
     RESP_ERROR: 0x84,
     RESP_DEBUG_LOG: 0x85,
+    RESP_AIRTIME: 0x86,
+    RESP_PROTOCOL_STATS: 0x87,
+    RESP_RELAY_STATS: 0x88,
+    RESP_LATENCY: 0x89,
+    RESP_SPI_BENCHMARK: 0x8A,
+    RESP_LAST: 0x8A,                 // Highest response ID the firmware sends
+
+    // CMD_GET_RELAY_STATS sections
+    RELAY_STATS_DUP_CACHE: 0x00,
+    RELAY_STATS_LBT: 0x01,
+    RELAY_STATS_DWELL: 0x02,
+    RELAY_STATS_RX_GUARD: 0x03,
+    RELAY_STATS_LOOP: 0x04,
+    RELAY_STATS_PRIORITY: 0x05,
+    RELAY_STATS_STORE: 0x06,
+    RELAY_STATS_RATE_LIMIT: 0x07,
+    RELAY_STATS_RECONFIG: 0x08,
+    RELAY_STATS_RADIO_BUSY: 0x09,
+    RELAY_STATS_TX_PRELOAD: 0x0A,
+    RELAY_STATS_NOISE: 0x0B,
+    RELAY_STATS_RX_READOUT: 0x0C,
+    RELAY_STATS_TURNAROUND: 0x0D,
+
+    // Relay priority classes, highest first (RELAY_STATS_PRIORITY order)
+    PRIORITY_CLASS_NAMES: ['text', 'control', 'telemetry', 'bulk'],
+
+    // Relay latency stages (CMD_GET_LATENCY stage byte)
+    LATENCY_STAGE_NAMES: ['parse', 'convert', 'queue', 'air', 'total'],
+
+    // Check whether a byte is a known response ID (used to resync the stream)
+    isResponseId(id) {
+        return id >= this.RESP_INFO_REPLY && id <= this.RESP_LAST;
+    },
 
     // Encode a command message
     encodeCommand(cmdId, data = new Uint8Array(0)) {
@@ -47,15 +91,360 @@ const Protocol = {
     },
 
     // Decode STATS response
+    // Fields after the first 24 bytes were appended by later firmware versions;
+    // missing fields decode as 0 so older firmware keeps working
     decodeStats(data) {
         if (data.length < 20) return null;
+        const u32 = (o) => data.length >= o + 4 ? (data[o] | (data[o + 1] << 8) | (data[o + 2] << 16) | (data[o + 3] << 24)) >>> 0 : 0;
+        const u8 = (o) => data.length > o ? data[o] : 0;
         
         return {
             meshcoreRx: data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24),
             meshtasticRx: data[4] | (data[5] << 8) | (data[6] << 16) | (data[7] << 24),
             meshcoreTx: data[8] | (data[9] << 8) | (data[10] << 16) | (data[11] << 24),
             meshtasticTx: data[12] | (data[13] << 8) | (data[14] << 16) | (data[15] << 24),
-            conversionErrors: data[16] | (data[17] << 8) | (data[18] << 16) | (data[19] << 24)
+            conversionErrors: data[16] | (data[17] << 8) | (data[18] << 16) | (data[19] << 24),
+            parseErrors: u32(20),
+            // RX queue
+            rxQueueOverflows: u32(24),
+            rxQueueDepth: u8(28),
+            rxQueueHighWater: u8(29),
+            // TX scheduler
+            radioReconfigurations: u32(30),
+            txBatches: u32(34),
+            txBatchedFrames: u32(38),
+            txMaxBatch: u8(42),
+            txQueueDrops: u32(43),
+            txAirtimeMs: u32(47)
+        };
+    },
+
+    // Decode AIRTIME response
+    decodeAirtime(data) {
+        if (data.length < 12) return null;
+        return {
+            protocol: data[0],
+            length: data[1],
+            symbolTimeUs: (data[2] | (data[3] << 8) | (data[4] << 16) | (data[5] << 24)) >>> 0,
+            airtimeUs: (data[6] | (data[7] << 8) | (data[8] << 16) | (data[9] << 24)) >>> 0,
+            payloadSymbols: data[10] | (data[11] << 8)
+        };
+    },
+
+    // Decode PROTOCOL_STATS response
+    decodeProtocolStats(data) {
+        if (data.length < 55) return null;
+        const u32 = (o) => (data[o] | (data[o + 1] << 8) | (data[o + 2] << 16) | (data[o + 3] << 24)) >>> 0;
+        const listenMs = u32(37);
+        const framesCaught = u32(41);
+        return {
+            protocol: data[0],
+            rxCount: u32(1),
+            txCount: u32(5),
+            parseErrors: u32(9),
+            conversionErrors: u32(13),
+            txDeferred: u32(17),
+            txBudgetDrops: u32(21),
+            txAirtimeMs: u32(25),
+            budgetPercent: data[29],
+            budgetWindowS: data[30] | (data[31] << 8),
+            budgetPolicy: data[32],      // 0 = defer, 1 = drop
+            budgetAvailableMs: u32(33),
+            listenMs: listenMs,
+            framesCaught: framesCaught,
+            dwells: u32(45),
+            lastDwellMs: data[49] | (data[50] << 8),
+            hopLimitDrops: u32(51),
+            framesPerDwellSecond: listenMs > 0 ? framesCaught * 1000 / listenMs : 0
+        };
+    },
+
+    // Decode RELAY_STATS response (layout depends on the section byte)
+    decodeRelayStats(data) {
+        if (data.length < 1) return null;
+        const u32 = (o) => (data[o] | (data[o + 1] << 8) | (data[o + 2] << 16) | (data[o + 3] << 24)) >>> 0;
+        const section = data[0];
+        switch (section) {
+            case this.RELAY_STATS_DUP_CACHE:
+                if (data.length < 17) return null;
+                return {
+                    section: section,
+                    hits: u32(1),
+                    misses: u32(5),
+                    evictions: u32(9),
+                    entries: data[13],
+                    capacity: data[14],
+                    ttlS: data[15] | (data[16] << 8)
+                };
+            case this.RELAY_STATS_DWELL:
+                if (data.length < 7) return null;
+                return {
+                    section: section,
+                    autoMode: data[1] !== 0,
+                    rxProtocol: data[2],
+                    minDwellMs: data[3] | (data[4] << 8),
+                    maxDwellMs: data[5] | (data[6] << 8)
+                };
+            case this.RELAY_STATS_RX_GUARD:
+                if (data.length < 9) return null;
+                return {
+                    section: section,
+                    receiving: data[1] !== 0,
+                    receivingMask: data[1],     // Bit n: radio n has a frame arriving
+                    saved: u32(2),
+                    aborted: u32(6)
+                };
+            case this.RELAY_STATS_LOOP:
+                if (data.length < 13) return null;
+                return {
+                    section: section,
+                    iterations: u32(1),
+                    avgUs: u32(5),
+                    maxUs: u32(9)
+                };
+            case this.RELAY_STATS_RECONFIG: {
+                if (data.length < 22) return null;
+                const entries = data[21];
+                if (data.length < 22 + entries * 14) return null;
+                const transitions = [];
+                for (let e = 0; e < entries; e++) {
+                    const o = 22 + e * 14;
+                    transitions.push({
+                        from: data[o],
+                        to: data[o + 1],
+                        count: u32(o + 2),
+                        avgUs: u32(o + 6),
+                        maxUs: u32(o + 10)
+                    });
+                }
+                return {
+                    section: section,
+                    applied: u32(1),
+                    skipped: u32(5),
+                    profileSwitches: u32(9),
+                    profileAvgUs: u32(13),
+                    profileMaxUs: u32(17),
+                    transitions: transitions
+                };
+            }
+            case this.RELAY_STATS_RADIO_BUSY: {
+                if (data.length < 22) return null;
+                const waits = u32(2);
+                const waitUs = u32(6);
+                return {
+                    section: section,
+                    faulted: data[1] !== 0,
+                    waits: waits,
+                    waitUs: waitUs,
+                    avgWaitUs: waits > 0 ? waitUs / waits : 0,
+                    maxWaitUs: u32(10),
+                    timeouts: u32(14),
+                    recoveries: u32(18)
+                };
+            }
+            case this.RELAY_STATS_TX_PRELOAD: {
+                if (data.length < 33) return null;
+                const uploadedAvgUs = u32(13);
+                const preloadedCount = u32(21);
+                const preloadedAvgUs = u32(25);
+                return {
+                    section: section,
+                    preloads: u32(1),
+                    unused: u32(5),
+                    uploadedCount: u32(9),
+                    uploadedAvgUs: uploadedAvgUs,
+                    uploadedMaxUs: u32(17),
+                    preloadedCount: preloadedCount,
+                    preloadedAvgUs: preloadedAvgUs,
+                    preloadedMaxUs: u32(29),
+                    // TX start time a preload saves on average
+                    savedUs: preloadedCount > 0 ? uploadedAvgUs - preloadedAvgUs : 0
+                };
+            }
+            case this.RELAY_STATS_NOISE: {
+                if (data.length < 2) return null;
+                const entries = data[1];
+                if (data.length < 2 + entries * 15) return null;
+                const i16 = (o) => (data[o] | (data[o + 1] << 8)) << 16 >> 16;
+                const channels = [];
+                for (let e = 0; e < entries; e++) {
+                    const o = 2 + e * 15;
+                    channels.push({
+                        protocol: data[o],
+                        floorDbm: i16(o + 1) / 16,
+                        busyShare: (data[o + 3] | (data[o + 4] << 8)) / 65535,
+                        thresholdDbm: i16(o + 5),
+                        samples: u32(o + 7),
+                        rejected: u32(o + 11)
+                    });
+                }
+                return {
+                    section: section,
+                    channels: channels
+                };
+            }
+            case this.RELAY_STATS_RX_READOUT:
+                if (data.length < 21) return null;
+                return {
+                    section: section,
+                    frames: u32(1),
+                    readoutAvgUs: u32(5),
+                    readoutMaxUs: u32(9),
+                    readyAvgUs: u32(13),
+                    readyMaxUs: u32(17),
+                    // Absent on older firmware
+                    crcErrors: data.length >= 25 ? u32(21) : null,
+                    oversize: data.length >= 29 ? u32(25) : null
+                };
+            case this.RELAY_STATS_TURNAROUND:
+                if (data.length < 34) return null;
+                return {
+                    section: section,
+                    fastMode: data[1] !== 0,
+                    calibrations: u32(2),
+                    calibrationsSkipped: u32(6),
+                    rxToTxCount: u32(10),
+                    rxToTxAvgUs: u32(14),
+                    rxToTxMaxUs: u32(18),
+                    txToRxCount: u32(22),
+                    txToRxAvgUs: u32(26),
+                    txToRxMaxUs: u32(30)
+                };
+            case this.RELAY_STATS_STORE:
+                if (data.length < 24) return null;
+                return {
+                    section: section,
+                    occupancy: data[1],
+                    capacity: data[2],
+                    peak: data[3],
+                    retries: u32(4),
+                    expired: u32(8),
+                    sent: u32(12),
+                    avgAgeMs: u32(16),
+                    maxAgeMs: u32(20)
+                };
+            case this.RELAY_STATS_RATE_LIMIT: {
+                if (data.length < 19) return null;
+                const listed = data[18];
+                if (data.length < 19 + listed * 9) return null;
+                const sources = [];
+                for (let s = 0; s < listed; s++) {
+                    const o = 19 + s * 9;
+                    sources.push({
+                        protocol: data[o],
+                        key: u32(o + 1),
+                        drops: u32(o + 5)
+                    });
+                }
+                return {
+                    section: section,
+                    ratePerMin: data[1] | (data[2] << 8),
+                    burst: data[3],
+                    tracked: data[4],
+                    capacity: data[5],
+                    allowed: u32(6),
+                    throttled: u32(10),
+                    evictions: u32(14),
+                    sources: sources
+                };
+            }
+            case this.RELAY_STATS_PRIORITY: {
+                const classes = this.PRIORITY_CLASS_NAMES;
+                if (data.length < 1 + classes.length * 8) return null;
+                return {
+                    section: section,
+                    classes: classes.map((name, c) => ({
+                        name: name,
+                        enqueued: u32(1 + c * 8),
+                        dropped: u32(5 + c * 8)
+                    }))
+                };
+            }
+            case this.RELAY_STATS_LBT: {
+                if (data.length < 25) return null;
+                const cadChecks = u32(5);
+                const cadBusy = u32(9);
+                const backoffs = u32(13);
+                const backoffMs = u32(17);
+                return {
+                    section: section,
+                    enabled: data[1] !== 0,
+                    cwMin: data[2],
+                    cwMax: data[3],
+                    maxAttempts: data[4],
+                    cadChecks: cadChecks,
+                    cadBusy: cadBusy,
+                    backoffs: backoffs,
+                    backoffMs: backoffMs,
+                    aborts: u32(21),
+                    busyRate: cadChecks > 0 ? cadBusy / cadChecks : 0,
+                    avgBackoffMs: backoffs > 0 ? backoffMs / backoffs : 0
+                };
+            }
+            default:
+                return { section: section };
+        }
+    },
+
+    // Decode LATENCY response: bucket b counts intervals in [2^b, 2^(b+1)) us
+    decodeLatency(data) {
+        if (data.length < 3) return null;
+        const bucketCount = data[2];
+        if (data.length < 3 + bucketCount * 2) return null;
+        const buckets = [];
+        let samples = 0;
+        for (let b = 0; b < bucketCount; b++) {
+            const count = data[3 + b * 2] | (data[4 + b * 2] << 8);
+            buckets.push(count);
+            samples += count;
+        }
+        // Percentile as the upper edge of the bucket it falls in
+        const percentileUs = (q) => {
+            let seen = 0;
+            for (let b = 0; b < bucketCount; b++) {
+                seen += buckets[b];
+                if (samples > 0 && seen >= samples * q) return Math.pow(2, b + 1);
+            }
+            return 0;
+        };
+        return {
+            direction: data[0],
+            stage: data[1],
+            stageName: this.LATENCY_STAGE_NAMES[data[1]] || `stage ${data[1]}`,
+            buckets: buckets,
+            samples: samples,
+            p50Us: percentileUs(0.5),
+            p99Us: percentileUs(0.99)
+        };
+    },
+
+    // Decode SPI_BENCHMARK response (timings are per FIFO read)
+    decodeSpiBenchmark(data) {
+        if (data.length < 16) return null;
+        const u32 = (o) => (data[o] | (data[o + 1] << 8) | (data[o + 2] << 16) | (data[o + 3] << 24)) >>> 0;
+        const bytes = data[1] | (data[2] << 8);
+        const byteLoopUs = u32(4);
+        const bulkUs = u32(8);
+        const bulkCpuUs = u32(12);
+        const rate = (us) => us > 0 ? bytes / us : 0;
+        // Frame readout comparison, absent on older firmware
+        const hasReadout = data.length >= 25;
+        const rxGettersUs = hasReadout ? u32(17) : null;
+        const rxFetchUs = hasReadout ? u32(21) : null;
+        return {
+            supported: data[0] !== 0,
+            bytes: bytes,
+            runs: data[3],
+            byteLoopUs: byteLoopUs,
+            bulkUs: bulkUs,
+            bulkCpuUs: bulkCpuUs,
+            byteLoopBytesPerUs: rate(byteLoopUs),
+            bulkBytesPerUs: rate(bulkUs),
+            speedup: bulkUs > 0 ? byteLoopUs / bulkUs : 0,
+            rxBytes: hasReadout ? data[16] : null,
+            rxGettersUs: rxGettersUs,
+            rxFetchUs: rxFetchUs,
+            rxSpeedup: rxFetchUs > 0 ? rxGettersUs / rxFetchUs : 0
         };
     },
 
@@ -76,11 +465,18 @@ const Protocol = {
         const packetData = new Uint8Array(len);
         packetData.set(data.subarray(5, 5 + len));
         
+        // Device micros() at RX_DONE follows the data (absent from older firmware)
+        const o = 5 + len;
+        const rxUs = data.length >= o + 4
+            ? (data[o] | (data[o + 1] << 8) | (data[o + 2] << 16) | (data[o + 3] << 24)) >>> 0
+            : null;
+        
         return {
             protocol: protocol,
             rssi: rssi,
             snr: snr,
-            data: packetData
+            data: packetData,
+            rxUs: rxUs
         };
     },
 
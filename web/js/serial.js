@@ -148,6 +148,63 @@ class SerialComm {
         await this.sendCommand(window.Protocol.CMD_SET_PROTOCOL_PARAMS, data);
     }
 
+    async setAirtimeBudget(protocolId, percent, windowS, policy) {
+        // 1 byte protocol ID + 1 byte percent (1-100) + 2 bytes window seconds (little-endian) + 1 byte policy
+        // policy: 0 = defer until budget is available, 1 = drop
+        const data = new Uint8Array([
+            protocolId & 0xFF,
+            percent & 0xFF,
+            windowS & 0xFF,
+            (windowS >> 8) & 0xFF,
+            policy & 0xFF
+        ]);
+        await this.sendCommand(window.Protocol.CMD_SET_AIRTIME_BUDGET, data);
+    }
+
+    async getProtocolStats(protocolId) {
+        const data = new Uint8Array([protocolId]);
+        await this.sendCommand(window.Protocol.CMD_GET_PROTOCOL_STATS, data);
+    }
+
+    async setDupTtl(ttlS) {
+        // 2 bytes: low byte, high byte (little-endian), 0 = disabled
+        const data = new Uint8Array([ttlS & 0xFF, (ttlS >> 8) & 0xFF]);
+        await this.sendCommand(window.Protocol.CMD_SET_DUP_TTL, data);
+    }
+
+    async getRelayStats(section) {
+        const data = new Uint8Array([section]);
+        await this.sendCommand(window.Protocol.CMD_GET_RELAY_STATS, data);
+    }
+
+    async setLbt(enabled, cwMin, cwMax, maxAttempts) {
+        // 1 byte enable + 1 byte CW min + 1 byte CW max (slots) + 1 byte max attempts
+        const data = new Uint8Array([enabled ? 1 : 0, cwMin & 0xFF, cwMax & 0xFF, maxAttempts & 0xFF]);
+        await this.sendCommand(window.Protocol.CMD_SET_LBT, data);
+    }
+
+    async setDwell(minMs, maxMs) {
+        // 2 bytes min dwell + 2 bytes max dwell (ms, little-endian)
+        const data = new Uint8Array([minMs & 0xFF, (minMs >> 8) & 0xFF, maxMs & 0xFF, (maxMs >> 8) & 0xFF]);
+        await this.sendCommand(window.Protocol.CMD_SET_DWELL, data);
+    }
+
+    async getLatency(direction, stage) {
+        // 1 byte direction (source protocol ID) + 1 byte stage
+        const data = new Uint8Array([direction & 0xFF, stage & 0xFF]);
+        await this.sendCommand(window.Protocol.CMD_GET_LATENCY, data);
+    }
+
+    async setRateLimit(ratePerMin, burst) {
+        // 2 bytes frames per minute (little-endian, 0 = off) + 1 byte burst frames
+        const data = new Uint8Array([ratePerMin & 0xFF, (ratePerMin >> 8) & 0xFF, burst & 0xFF]);
+        await this.sendCommand(window.Protocol.CMD_SET_RATE_LIMIT, data);
+    }
+
+    async runSpiBenchmark() {
+        await this.sendCommand(window.Protocol.CMD_SPI_BENCHMARK);
+    }
+
     async readLoop() {
         const decoder = new TextDecoder();
         
@@ -171,16 +228,16 @@ class SerialComm {
                         const respId = this.readBuffer[0];
                         const len = this.readBuffer[1];
                         
-                        // First check if respId is a valid response ID (0x81-0x85)
+                        // First check if respId is a valid response ID
                         // If not, we're likely out of sync (maybe text data mixed in)
-                        if (respId < 0x81 || respId > 0x85) {
+                        if (!window.Protocol.isResponseId(respId)) {
                             // Not a valid response ID - try to resync
                             let found = false;
                             // Search more aggressively for valid protocol header
                             for (let i = 1; i < Math.min(this.readBuffer.length - 1, 100); i++) {
                                 const nextRespId = this.readBuffer[i];
-                                // Known response IDs: 0x81-0x85
-                                if (nextRespId >= 0x81 && nextRespId <= 0x85) {
+                                // Known response IDs
+                                if (window.Protocol.isResponseId(nextRespId)) {
                                     // Found potential header - also check that next byte is reasonable
                                     if (i + 1 < this.readBuffer.length) {
                                         const nextLen = this.readBuffer[i + 1];
@@ -219,8 +276,8 @@ class SerialComm {
                             // Search more aggressively
                             for (let i = 2; i < Math.min(this.readBuffer.length - 1, 100); i++) {
                                 const nextRespId = this.readBuffer[i];
-                                // Known response IDs: 0x81-0x85
-                                if (nextRespId >= 0x81 && nextRespId <= 0x85) {
+                                // Known response IDs
+                                if (window.Protocol.isResponseId(nextRespId)) {
                                     if (i + 1 < this.readBuffer.length) {
                                         const nextLen = this.readBuffer[i + 1];
                                         if (nextLen <= 64) {